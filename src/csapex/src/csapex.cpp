@@ -208,6 +208,8 @@ int Main::run()
         app->quit();
     });
 
+    csapex::error_handling::reload_request().connect([this]() { core->reload(settings.get<std::string>("config")); });
+
     if (headless) {
         return runHeadless();
     } else {
@@ -292,7 +294,8 @@ int main(int argc, char** argv)
             ("disable_thread_grouping", "by default create one thread per node")
             ("input", "config file to load")
             ("start-server", "start tcp server")
-            ("port", po::value<int>()->default_value(42123), "tcp server port");
+            ("port", po::value<int>()->default_value(42123), "tcp server port")
+            ("trace", po::value<std::string>(), "write a chrome trace of the execution to this file");
     // clang-format on
 
     po::positional_options_description p;
@@ -409,6 +412,7 @@ int main(int argc, char** argv)
     settings.set("initially_paused", vm.count("paused") > 0);
     settings.set("start-server", vm.count("start-server") > 0);
     settings.set("port", vm["port"].as<int>());
+    settings.set("trace_file", vm.count("trace") ? vm["trace"].as<std::string>() : std::string());
 
     // start the app
     Main m(std::move(app), settings, *handler);
@@ -58,6 +58,8 @@ int CsApexServer::run()
         ++request;
     });
 
+    csapex::error_handling::reload_request().connect([this]() { core->reload(settings.get<std::string>("config")); });
+
     GraphFacadePtr root = core->getRoot();
     csapex::error_handling::init();
 
@@ -10,6 +10,7 @@
 #include <csapex/model/connector_type.h>
 #include <csapex_command_export.h>
 #include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/model/buffer_policy.h>
 
 namespace csapex
 {
@@ -34,6 +35,7 @@ public:
     CommandPtr moveConnections(Connector* from, Connector* to);
 
     CommandPtr setConnectionActive(int connection, bool active);
+    CommandPtr setConnectionBuffer(int connection, int queue_depth, BufferPolicy policy);
 
     CommandPtr deleteConnectionFulcrumCommand(int connection, int fulcrum);
     CommandPtr deleteAllConnectionFulcrumsCommand(int connection);
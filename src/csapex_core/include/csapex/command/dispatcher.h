@@ -8,6 +8,7 @@
 
 /// SYSTEM
 #include <deque>
+#include <mutex>
 #include <csapex/utility/slim_signal.h>
 
 namespace csapex
@@ -44,6 +45,10 @@ public:
     void resetDirtyPoint();
     void clearSavepoints();
 
+public:
+    /// emitted from the queueing thread whenever a command is deferred with executeLater
+    slim_signal::Signal<void()> commands_pending;
+
 private:
     bool doExecute(Command::Ptr command);
     void setDirty(bool dirty);
@@ -55,6 +60,7 @@ protected:
 private:
     CsApexCore& core_;
 
+    mutable std::mutex later_mutex_;
     std::vector<Command::Ptr> later;
 
     std::deque<Command::Ptr> done;
@@ -4,6 +4,7 @@
 /// COMPONENT
 #include "command_impl.hpp"
 #include <csapex/data/point.h>
+#include <csapex/model/buffer_policy.h>
 
 namespace csapex
 {
@@ -15,6 +16,7 @@ class CSAPEX_COMMAND_EXPORT ModifyConnection : public CommandImplementation<Modi
 
 public:
     ModifyConnection(const AUUID& graph_uuid, int connection_id, bool active);
+    ModifyConnection(const AUUID& graph_uuid, int connection_id, int queue_depth, BufferPolicy policy);
 
     virtual std::string getDescription() const override;
 
@@ -29,8 +31,15 @@ protected:
 private:
     int connection_id;
 
+    bool modify_active;
     bool was_active;
     bool active;
+
+    bool modify_buffer;
+    int was_queue_depth;
+    int queue_depth;
+    BufferPolicy was_policy;
+    BufferPolicy policy;
 };
 
 }  // namespace command
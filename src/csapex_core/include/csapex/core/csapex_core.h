@@ -5,6 +5,7 @@
 #include <csapex/command/dispatcher.h>
 #include <csapex/core/settings.h>
 #include <csapex_core/csapex_core_export.h>
+#include <csapex/model/model_fwd.h>
 #include <csapex/model/observer.h>
 #include <csapex/plugin/plugin_fwd.h>
 #include <csapex/model/notifier.h>
@@ -15,6 +16,8 @@
 #include <csapex/io/io_fwd.h>
 
 /// SYSTEM
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -27,6 +30,7 @@ class ClassLoader;
 namespace csapex
 {
 class Profiler;
+class ChromeTraceWriter;
 
 class CSAPEX_CORE_EXPORT CsApexCore : public Observer, public Notifier, public Profilable
 {
@@ -45,6 +49,11 @@ public:
     void startMainLoop();
     bool isMainLoopRunning() const;
     void joinMainLoop();
+    /**
+     * @brief getMainLoopWakeUps counts how often the main loop has woken up.
+     *        The loop sleeps until a command is deferred or a shutdown is requested, so this stays constant while idle.
+     */
+    std::size_t getMainLoopWakeUps() const;
 
     bool isServerActive() const;
     void setServerFactory(std::function<ServerPtr()> server);
@@ -52,6 +61,13 @@ public:
     bool stopServer();
 
     void load(const std::string& file);
+    /**
+     * @brief reload applies the changes of a configuration file without stopping the processing.
+     *        The sources are held until the pipeline is drained, then only the nodes and connections that differ from the
+     *        current graph are re-created. Falls back to load, if the graph is empty.
+     *        If the main loop is running, the reload is executed there and this call returns immediately.
+     */
+    void reload(const std::string& file);
     void saveAs(const std::string& file, bool quiet = false);
 
     SnippetPtr serializeNodes(const AUUID& graph_id, const std::vector<UUID>& nodes) const;
@@ -79,10 +95,18 @@ public:
     void setPause(bool pause);
 
     bool isSteppingMode() const;
+    /**
+     * @brief setSteppingMode waits until the pipeline is drained, before stepping is enabled.
+     *        If the main loop is running, this is done there and this call returns immediately.
+     */
     void setSteppingMode(bool stepping);
     void step();
 
-    void drainPipeline();
+    /**
+     * @brief drainPipeline prevents the sources from producing new messages and waits until all messages in flight are processed
+     * @return true, iff the pipeline is empty
+     */
+    bool drainPipeline(std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
     void settingsChanged();
     void setStatusMessage(const std::string& msg);
@@ -119,6 +143,10 @@ private:
     CsApexCore(Settings& settings_, ExceptionHandler& handler, PluginLocatorPtr plugin_locator);
     CorePluginPtr makeCorePlugin(const std::string& name);
 
+    bool waitUntilDrained(std::chrono::milliseconds timeout);
+    /// executes the task in the main loop, or directly if the main loop is not running
+    void executeInMainLoop(const std::function<void()>& task);
+
 private:
     bool is_root_;
 
@@ -143,6 +171,7 @@ private:
     std::shared_ptr<CommandDispatcher> dispatcher_;
 
     std::shared_ptr<Profiler> profiler_;
+    std::unique_ptr<ChromeTraceWriter> trace_writer_;
 
     std::shared_ptr<PluginManager<CorePlugin>> core_plugin_manager;
     std::map<std::string, std::shared_ptr<CorePlugin>> core_plugins_;
@@ -152,6 +181,9 @@ private:
     std::mutex running_mutex_;
     std::condition_variable running_changed_;
     bool running_;
+    bool commands_pending_;
+    std::vector<std::function<void()>> main_loop_tasks_;
+    std::atomic<std::size_t> main_loop_wake_ups_;
 
     bool init_;
     bool load_needs_reset_;
@@ -19,6 +19,20 @@ namespace csapex
 {
 class CSAPEX_CORE_EXPORT GraphIO : public Profilable
 {
+public:
+    struct ReloadStatistics
+    {
+        ReloadStatistics();
+
+        std::size_t nodes_kept;
+        /// changed nodes are counted as removed and as created
+        std::size_t nodes_created;
+        std::size_t nodes_removed;
+
+        std::size_t connections_created;
+        std::size_t connections_removed;
+    };
+
 public:
     GraphIO(GraphFacadeImplementation& graph, NodeFactoryImplementation* node_factory, bool throw_on_error = false);
 
@@ -36,6 +50,14 @@ public:
     void loadGraph(const Snippet& doc);
     void loadGraphFrom(const YAML::Node& doc);
 
+    /**
+     * @brief reloadGraphFrom applies the difference between the current graph and a document to the current graph.
+     *        Only nodes and connections whose YAML differs are re-created, all others keep running with their state.
+     *        Nodes that only differ in their view (position, color, ...) are updated in place.
+     * @param doc the new document
+     */
+    ReloadStatistics reloadGraphFrom(const YAML::Node& doc);
+
     Snippet saveSelectedGraph(const std::vector<UUID>& nodes);
 
     std::unordered_map<UUID, UUID, UUID::Hasher> loadIntoGraph(const Snippet& blueprint, const csapex::Point& position, SemanticVersion version={});
@@ -65,7 +87,7 @@ protected:
     void serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr node_handle);
     void deserializeNode(const YAML::Node& doc, NodeFacadeImplementationPtr node_handle, SemanticVersion version);
 
-    void loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, SemanticVersion version);
+    ConnectionPtr loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, SemanticVersion version);
 
     UUID readNodeUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
     UUID readConnectorUUID(std::weak_ptr<UUIDProvider> parent, const YAML::Node& doc);
@@ -44,7 +44,7 @@ public:
     slim_signal::Signal<void(const std::string&)> loaded;
     slim_signal::Signal<void()> new_node_type;
     slim_signal::Signal<void(NodeFacadePtr)> node_constructed;
-    slim_signal::Signal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
+    slim_signal::ObservableSignal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
 
 protected:
     void ensureLoaded() override;
@@ -56,6 +56,7 @@ protected:
     csapex::PluginLocator* plugin_locator_;
 
     std::shared_ptr<PluginManager<Node>> node_manager_;
+    slim_signal::ScopedConnection manifest_relay_;
 
     bool tag_map_has_to_be_rebuilt_;
 };
@@ -0,0 +1,17 @@
+#ifndef BUFFER_POLICY_H
+#define BUFFER_POLICY_H
+
+namespace csapex
+{
+/**
+ * @brief BufferPolicy decides what a Connection does with a new token when its queue is full
+ */
+enum class BufferPolicy
+{
+    BLOCK,        // the producer waits until the consumer has made room
+    DROP_OLDEST,  // the oldest token that the consumer has not started on is discarded
+    DROP_NEWEST   // the incoming token is discarded
+};
+}
+
+#endif  // BUFFER_POLICY_H
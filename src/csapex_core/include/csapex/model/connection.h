@@ -10,6 +10,7 @@
 #include <csapex/model/token.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/connection_description.h>
+#include <csapex/model/buffer_policy.h>
 
 /// SYSTEM
 #include <memory>
@@ -17,6 +18,7 @@
 #include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 
 namespace csapex
 {
@@ -93,6 +95,24 @@ public:
 
     bool isPipelining() const;
 
+    /**
+     * @brief setQueueDepth limits the number of tokens this connection holds, including the one currently consumed
+     * @param depth at least 1, the default of 1 lets the producer run only after the consumer is done
+     */
+    void setQueueDepth(int depth);
+    int getQueueDepth() const;
+
+    void setBufferPolicy(BufferPolicy policy);
+    BufferPolicy getBufferPolicy() const;
+
+    /**
+     * @brief canReceiveToken checks whether the producer may publish the next token
+     */
+    bool canReceiveToken() const;
+
+    std::size_t countQueuedTokens() const;
+    std::size_t countDroppedTokens() const;
+
     State getState() const;
     void setState(State s);
 
@@ -103,6 +123,11 @@ public:
     void notifyMessageSet();
     void notifyMessageProcessed();
 
+private:
+    void enqueueToken(const TokenPtr& token);
+    bool canReceiveTokenUnlocked() const;
+    void bufferChanged();
+
 public:
     slim_signal::Signal<void()> deleted;
 
@@ -141,12 +166,18 @@ protected:
 
     std::vector<FulcrumPtr> fulcrums_;
 
-    State state_;
+    // the state is only changed while holding sync, but it can be queried without the lock
+    std::atomic<State> state_;
     TokenPtr message_;
 
     static int next_connection_id_;
 
-    int seq_ = 0;
+    std::atomic<int> seq_{ 0 };
+
+    std::atomic<int> queue_depth_;
+    std::atomic<BufferPolicy> buffer_policy_;
+    std::deque<TokenPtr> queue_;
+    std::size_t dropped_;
 
     mutable std::recursive_mutex sync;
 };
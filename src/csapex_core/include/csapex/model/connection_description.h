@@ -7,6 +7,7 @@
 #include <csapex/model/model_fwd.h>
 #include <csapex_core/csapex_core_export.h>
 #include <csapex/model/fulcrum.h>
+#include <csapex/model/buffer_policy.h>
 
 namespace csapex
 {
@@ -27,6 +28,9 @@ public:
 
     bool active;
 
+    int queue_depth;
+    BufferPolicy buffer_policy;
+
     std::vector<Fulcrum> fulcrums;
 
     ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, int seq, bool active, const std::vector<Fulcrum>& fulcrums);
@@ -39,6 +43,7 @@ public:
 
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+    SemanticVersion getVersion() const override;
 
     bool operator==(const ConnectionDescription& other) const;
 };
@@ -4,6 +4,9 @@
 /// COMPONENT
 #include <csapex/model/graph.h>
 
+/// SYSTEM
+#include <unordered_map>
+
 namespace csapex
 {
 class GraphImplementation : public Graph
@@ -81,6 +84,9 @@ public:
 private:
     void checkNodeState(NodeHandle* nh);
 
+    void indexConnection(const ConnectionPtr& connection);
+    void unindexConnection(const ConnectionPtr& connection);
+
     void buildConnectedComponents();
     void calculateDepths();
 
@@ -91,6 +97,11 @@ protected:
     std::vector<graph::VertexPtr> vertices_;
     std::vector<ConnectionPtr> edges_;
 
+    // lookup indices, kept in sync with vertices_ and edges_
+    std::unordered_map<UUID, graph::VertexPtr, UUID::Hasher> vertex_index_;
+    std::unordered_map<int, ConnectionPtr> connection_id_index_;
+    std::unordered_multimap<UUID, ConnectionPtr, UUID::Hasher> connection_source_index_;
+
     std::map<Connection*, std::vector<slim_signal::ScopedConnection>> connection_observations_;
 
     std::set<graph::VertexPtr> sources_;
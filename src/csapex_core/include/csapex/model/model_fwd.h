@@ -45,6 +45,7 @@ FWD(NodeState)
 FWD(NodeStatistics)
 FWD(NodeWorker)
 FWD(Parameterizable)
+FWD(ReplicaContext)
 FWD(SubgraphNode)
 FWD(Tag)
 FWD(Token)
@@ -259,6 +259,21 @@ public:
      */
     virtual bool canRunInSeparateProcess() const;
 
+    /**
+     * @brief getReplicaCount specifies how many invocations of this node may run in parallel.
+     *
+     * With N > 1, consecutive input tokens are dispatched to up to N concurrent calls of
+     * Node::process. The outputs are buffered per invocation and sent in the order the
+     * inputs arrived, so downstream nodes see the same sequence as with N = 1.
+     * By default, the method returns 1.
+     *
+     * @warning <em>Only return a value > 1 for synchronous nodes that keep no state between
+     * two calls of process and only use msg::getMessage / msg::publish for their I/O.</em>
+     *
+     * @return the maximum number of parallel invocations
+     */
+    virtual int getReplicaCount() const;
+
     /**
      * @brief stateChanged is an event function that is called, when the NodeState has changed.
      */
@@ -36,7 +36,7 @@ public:
     void setVertex(graph::VertexWeakPtr vertex);
     graph::VertexPtr getVertex() const;
 
-    InputTransition* getInputTransition() const;
+    InputTransition* getInputTransition() const override;
     OutputTransition* getOutputTransition() const;
 
     void setNodeState(NodeStatePtr memento);
@@ -6,6 +6,7 @@
 #include <csapex/msg/msg_fwd.h>
 #include <csapex/signal/signal_fwd.h>
 #include <csapex/model/multi_connection_type.h>
+#include <csapex/msg/input_sync_policy.h>
 #include <csapex/msg/message.h>
 #include <csapex/msg/token_traits.h>
 #include <csapex/model/token.h>
@@ -241,6 +242,21 @@ public:
 
     void setVariadic(bool variadic);
 
+    /**
+     * @brief enableMessagePooling recycles the envelopes of messages published on <b>output</b>.
+     *        Pool hits and misses are reported to the profiler of the node.
+     */
+    void enableMessagePooling(Output* output);
+
+    /**
+     * @brief setInputSynchronization decides which messages of the inputs are processed together, see InputSyncPolicy.
+     *        With APPROXIMATE_TIME, messages whose stamps differ by at most <b>slop_micro_seconds</b> are matched.
+     *        With LATEST_VALUE, the node runs for every message of the primary input, see setPrimaryInput.
+     */
+    void setInputSynchronization(InputSyncPolicy policy, connection_types::Message::Stamp slop_micro_seconds = 0);
+    InputSyncPolicy getInputSynchronization() const;
+    void setPrimaryInput(Input* input);
+
     /**
      * Raw construction, handle with care!
      */
@@ -252,6 +268,8 @@ public:
     virtual Event* addEvent(TokenDataConstPtr type, const std::string& label) = 0;
 
 protected:
+    virtual InputTransition* getInputTransition() const = 0;
+
     virtual std::vector<ConnectablePtr> getExternalConnectors() const = 0;
     virtual std::vector<InputPtr> getExternalInputs() const = 0;
     virtual std::vector<OutputPtr> getExternalOutputs() const = 0;
@@ -42,7 +42,7 @@ public:
     virtual void reset() override;
 
     void schedule(TaskPtr task);
-    void scheduleDelayed(TaskPtr task, std::chrono::system_clock::time_point time);
+    void scheduleDelayed(TaskPtr task, std::chrono::steady_clock::time_point time);
 
     void setSuppressExceptions(bool suppress_exceptions);
 
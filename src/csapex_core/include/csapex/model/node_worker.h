@@ -21,6 +21,7 @@
 
 /// SYSTEM
 #include <map>
+#include <memory>
 #include <functional>
 #include <mutex>
 #include <vector>
@@ -60,6 +61,10 @@ public:
     bool isProcessingEnabled() const;
     void setProcessingEnabled(bool e);
 
+    /// a held worker finishes its current process call, but does not start a new one until it is released
+    void setHeld(bool held);
+    bool isHeld() const;
+
     void setProfiling(bool profiling);
     bool isProfiling() const;
 
@@ -72,6 +77,8 @@ public:
     bool canReceive() const;
     bool canSend() const;
 
+    virtual int getReplicaCount() const;
+
     void notifyMessagesProcessedDownstream();
 
 public:
@@ -145,6 +152,10 @@ private:
     void startProfilerInterval(TracingType type);
     void stopActiveProfilerInterval();
 
+    bool startProcessingReplica();
+    void finishReplica(const ReplicaContextPtr& context, long generation);
+    void emitFinishedReplicas();
+
 protected:
     mutable std::recursive_mutex sync;
 
@@ -158,6 +169,7 @@ protected:
 private:
     mutable std::recursive_mutex state_mutex_;
     bool is_processing_;
+    std::atomic<bool> is_held_;
 
     Event* trigger_process_done_;
     Event* trigger_activated_;
@@ -173,6 +185,21 @@ private:
     // TimerPtr profiling_timer_;
     std::shared_ptr<ProfilerImplementation> profiler_;
 
+    // always-on process spans, independent of the profiler
+    uint32_t trace_name_;
+    // only used without replicas, where one invocation is in flight at a time and might finish on another thread
+    std::atomic<uint64_t> trace_process_start_;
+
+    class ReplicaPool;
+    std::unique_ptr<ReplicaPool> replica_pool_;
+
+    mutable std::recursive_mutex replica_mutex_;
+    int replicas_in_flight_;
+    long next_replica_dispatch_;
+    long next_replica_emission_;
+    long replica_generation_;
+    std::map<long, ReplicaContextPtr> finished_replicas_;
+
     long guard_;
 };
 
@@ -0,0 +1,163 @@
+#ifndef PARAMETER_HANDLE_H
+#define PARAMETER_HANDLE_H
+
+/// SYSTEM
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace csapex
+{
+namespace detail
+{
+/**
+ * @brief The ParameterSnapshot class stores a copy of a parameter value that can be read without locking.
+ *        Trivially copyable values are guarded by a sequence lock, readers retry while a write is in progress.
+ */
+template <typename T, class Enable = void>
+class ParameterSnapshot
+{
+public:
+    typedef T result_type;
+
+    explicit ParameterSnapshot(const T& value) : sequence_(0)
+    {
+        write(value);
+    }
+
+    T read() const
+    {
+        T value;
+        for (;;) {
+            uint64_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+
+            uint64_t words[WORDS];
+            for (std::size_t i = 0; i < WORDS; ++i) {
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&value, words, sizeof(T));
+                return value;
+            }
+        }
+    }
+
+    void write(const T& value)
+    {
+        uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    enum : std::size_t
+    {
+        WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t)
+    };
+
+    std::atomic<uint64_t> sequence_;
+    std::atomic<uint64_t> data_[WORDS];
+    std::mutex writer_mutex_;
+};
+
+/**
+ * @brief Values that cannot be copied bytewise, e.g. strings, are published as immutable copies instead.
+ *        Readers get a reference to the current copy, which is kept alive until the value is replaced a second time.
+ */
+template <typename T>
+class ParameterSnapshot<T, typename std::enable_if<!std::is_trivially_copyable<T>::value>::type>
+{
+public:
+    typedef const T& result_type;
+
+    explicit ParameterSnapshot(const T& value) : current_(new T(value))
+    {
+        value_.store(current_.get(), std::memory_order_release);
+    }
+
+    const T& read() const
+    {
+        return *value_.load(std::memory_order_acquire);
+    }
+
+    void write(const T& value)
+    {
+        std::unique_ptr<const T> next(new T(value));
+
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        value_.store(next.get(), std::memory_order_release);
+        previous_ = std::move(current_);
+        current_ = std::move(next);
+    }
+
+private:
+    std::atomic<const T*> value_;
+    std::unique_ptr<const T> current_;
+    std::unique_ptr<const T> previous_;
+    std::mutex writer_mutex_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief The ParameterHandle class gives cheap access to the current value of a parameter.
+ *        A handle is obtained once, e.g. in setupParameters, and can then be read in every call of process
+ *        without a name lookup or locking the parameter.
+ *        The value is refreshed together with the parameter callbacks, before the next call of process.
+ *        Values that are not trivially copyable, like strings, are returned by reference.
+ *        The reference stays valid for the current call of process, but must not be kept beyond that.
+ * @see Parameterizable::getParameterHandle
+ */
+template <typename T>
+class ParameterHandle
+{
+public:
+    ParameterHandle() = default;
+
+    explicit ParameterHandle(const T& value) : snapshot_(std::make_shared<detail::ParameterSnapshot<T>>(value))
+    {
+    }
+
+    bool isValid() const
+    {
+        return snapshot_ != nullptr;
+    }
+
+    typename detail::ParameterSnapshot<T>::result_type get() const
+    {
+        return snapshot_->read();
+    }
+
+    typename detail::ParameterSnapshot<T>::result_type operator*() const
+    {
+        return snapshot_->read();
+    }
+
+    void update(const T& value)
+    {
+        snapshot_->write(value);
+    }
+
+private:
+    std::shared_ptr<detail::ParameterSnapshot<T>> snapshot_;
+};
+
+}  // namespace csapex
+
+#endif  // PARAMETER_HANDLE_H
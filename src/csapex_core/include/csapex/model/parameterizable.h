@@ -3,6 +3,7 @@
 
 /// PROJECT
 #include <csapex/model/model_fwd.h>
+#include <csapex/model/parameter_handle.h>
 #include <csapex/param/param_fwd.h>
 #include <csapex/param/parameter.h>
 #include <csapex/param/parameter_modifier.h>
@@ -294,6 +295,23 @@ public:
         return param::ParameterModifier<T>::get(getParameter(name));
     }
 
+    /**
+     * @brief getParameterHandle returns a handle to read the value of a parameter without looking it up.
+     *        The handle is updated when the changed parameters are processed, see getChangedParameters.
+     * @param name unique name of the parameter
+     * @return A handle to the value casted to <b>T</b>.
+     * @throws if the parameter doesn't exist
+     */
+    template <typename T>
+    ParameterHandle<T> getParameterHandle(const std::string& name)
+    {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+        param::ParameterPtr param = getParameter(name);
+        ParameterHandle<T> handle(param::ParameterModifier<T>::get(param));
+        addParameterHandleUpdate(param.get(), [handle](const param::ParameterPtr& p) mutable { handle.update(param::ParameterModifier<T>::get(p)); });
+        return handle;
+    }
+
     /**
      * @brief setParameter directly updates the value of a parameter
      * @param name unique name of the parameter for which to get the value
@@ -491,7 +509,8 @@ public:
 
 private:
     void doSetParameterLater(const std::string& name, const param::ParameterConstPtr& value);
-    
+    void addParameterHandleUpdate(param::Parameter* param, std::function<void(const param::ParameterPtr&)> update);
+
 private:
     void parameterChanged(param::ParameterPtr param);
     void parameterEnabled(param::Parameter* param, bool enabled);
@@ -506,6 +525,7 @@ private:
     ChangedParameterList changed_params_;
 
     std::map<param::Parameter*, std::vector<std::function<void(param::Parameter*)>>> param_callbacks_;
+    std::map<param::Parameter*, std::vector<std::function<void(const param::ParameterPtr&)>>> param_handle_updates_;
 
 protected:
     GenericStatePtr parameter_state_;  ///< the underlying memento
@@ -0,0 +1,74 @@
+#ifndef REPLICA_CONTEXT_H
+#define REPLICA_CONTEXT_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/msg/msg_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <map>
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief The ReplicaContext class holds the tokens of one replicated invocation of a node.
+ *
+ * While a context is active on the current thread, the node's inputs return the tokens
+ * that were snapshotted for this invocation and everything the node publishes is
+ * buffered here instead of on the outputs. The NodeWorker later hands the buffered
+ * messages to the outputs in sequence order.
+ */
+class CSAPEX_CORE_EXPORT ReplicaContext
+{
+public:
+    class CSAPEX_CORE_EXPORT Scope
+    {
+    public:
+        explicit Scope(ReplicaContext* context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ReplicaContext* previous_;
+    };
+
+public:
+    static ReplicaContext* current();
+
+    explicit ReplicaContext(long sequence_number);
+
+    long getSequenceNumber() const;
+
+    void setInputToken(const Input* input, const TokenPtr& token);
+    bool hasInput(const Input* input) const;
+    TokenPtr getInputToken(const Input* input) const;
+
+    void addOutput(Output* output);
+    bool hasOutput(const Output* output) const;
+    void setOutputToken(Output* output, const TokenPtr& token);
+    TokenPtr getOutputToken(const Output* output) const;
+    const std::map<Output*, TokenPtr>& getOutputTokens() const;
+
+    void setForwarding(bool forward);
+    bool isForwarding() const;
+
+    void setError(const std::string& error);
+    const std::string& getError() const;
+
+private:
+    long sequence_number_;
+
+    std::map<const Input*, TokenPtr> inputs_;
+    std::map<Output*, TokenPtr> outputs_;
+
+    bool forward_;
+    std::string error_;
+};
+
+}  // namespace csapex
+
+#endif  // REPLICA_CONTEXT_H
@@ -109,6 +109,14 @@ public:
     std::vector<UUID> getInternalEvents() const;
 
     void setIterationEnabled(const UUID& external_input_uuid, bool enabled);
+    /**
+     * @brief setIterationPipelineDepth allows up to depth elements of an iterated container to be inside the subgraph at once.
+     *        With a depth of 1, the next element is only sent when the previous one has left the subgraph.
+     *        With a larger depth, the next element is sent as soon as the first nodes of the subgraph have consumed the previous one,
+     *        so that consecutive elements are processed by different nodes at the same time. The results are collected in index order.
+     */
+    void setIterationPipelineDepth(int depth);
+    int getIterationPipelineDepth() const;
 
     void notifyMessagesProcessed();
 
@@ -134,6 +142,8 @@ private:
 
     void startNextIteration();
 
+    bool isIterationPipelined() const;
+
 public:
     slim_signal::Signal<void(ConnectorPtr)> forwarding_connector_added;
     slim_signal::Signal<void(ConnectorPtr)> forwarding_connector_removed;
@@ -171,6 +181,9 @@ protected:
     bool has_sent_current_iteration_;
     int iteration_index_;
     int iteration_count_;
+    int iterations_received_;
+    int iteration_pipeline_depth_;
+    mutable std::recursive_mutex iteration_mutex_;
 
     bool is_initialized_;
 
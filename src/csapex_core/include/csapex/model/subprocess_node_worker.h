@@ -46,6 +46,8 @@ public:
 
     void initialize() override;
 
+    int getReplicaCount() const override;
+
 protected:
     void processNode() override;
     void processSlot(const SlotWeakPtr& slot) override;
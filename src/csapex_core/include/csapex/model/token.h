@@ -31,6 +31,7 @@ public:
     int getSequenceNumber() const;
     void setSequenceNumber(int seq_no_) const;
 
+    /// copies the token meta data, the message itself is shared and not copied
     virtual bool cloneData(const Token& other);
 
     static Ptr makeEmpty();
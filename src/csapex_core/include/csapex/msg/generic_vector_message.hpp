@@ -102,8 +102,8 @@ private:
 
         bool cloneData(const Implementation<T>& other)
         {
-            value.reset(new std::vector<Payload>);
-            *value = *other.value;
+            // the entries are shared until one of the copies is modified
+            value = other.value;
             return true;
         }
 
@@ -166,6 +166,7 @@ private:
 
         virtual void addNestedValue(const TokenData::ConstPtr& msg) override
         {
+            detach();
             addCastedEntry(*value, msg);
         }
         virtual TokenData::ConstPtr nestedValue(std::size_t i) const override
@@ -307,6 +308,15 @@ private:
             return csapex::makeEmpty<typename std::remove_const<MsgType>::type>();
         }
 
+    protected:
+        /// copies the entries before they are modified, if they are shared with another message
+        void detach()
+        {
+            if (value.use_count() > 1) {
+                value = std::make_shared<std::vector<Payload>>(*value);
+            }
+        }
+
     public:
         std::shared_ptr<std::vector<Payload>> value;
     };
@@ -349,6 +359,7 @@ private:
         }
         void decode(const YAML::Node& node) override
         {
+            Parent::detach();
             for (const YAML::Node& centry : node["values"]) {
                 std::shared_ptr<T> msg;
                 if (!centry["type"].IsDefined()) {
@@ -434,7 +445,7 @@ private:
 
     private:
         TokenData::ConstPtr type_;
-        std::vector<TokenDataPtr> value;
+        std::vector<TokenDataConstPtr> value;
     };
 
 public:
@@ -642,7 +653,7 @@ public:
     static void makeSharedValue(InstancedImplementation* i, std::shared_ptr<std::vector<std::shared_ptr<T>>>& res, typename std::enable_if<std::is_base_of<TokenData, T>::value>::type* = 0)
     {
         for (const TokenDataConstPtr& td : i->value) {
-            res->push_back(std::dynamic_pointer_cast<T>(td));
+            res->push_back(std::const_pointer_cast<T>(std::dynamic_pointer_cast<T const>(td)));
         }
     }
     template <typename T>
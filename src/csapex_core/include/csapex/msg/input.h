@@ -5,6 +5,7 @@
 #include <csapex/msg/msg_fwd.h>
 #include <csapex/model/connectable.h>
 #include <csapex/msg/message.h>
+#include <csapex/profiling/counter.h>
 
 namespace csapex
 {
@@ -52,6 +53,10 @@ public:
 
     virtual void notifyMessageAvailable(Connection* connection);
 
+    /// counts the messages that a node has copied to get a mutable version, see msg::getClonedMessage
+    void setCopyCounter(const Counter::Ptr& copies);
+    Counter::Ptr getCopyCounter() const;
+
     virtual void reset() override;
 
 public:
@@ -68,6 +73,8 @@ protected:
     TokenPtr message_;
 
     bool optional_;
+
+    Counter::Ptr copies_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,17 @@
+#ifndef INPUT_SYNC_POLICY_H
+#define INPUT_SYNC_POLICY_H
+
+namespace csapex
+{
+/**
+ * @brief InputSyncPolicy decides which messages of the inputs of a node are processed together
+ */
+enum class InputSyncPolicy
+{
+    SEQUENCE,          // every input has to provide its next message, the producers run in lockstep
+    APPROXIMATE_TIME,  // messages are buffered and matched by their stamps within a slop window
+    LATEST_VALUE       // the primary input triggers processing, the other inputs provide their latest message
+};
+}
+
+#endif  // INPUT_SYNC_POLICY_H
@@ -3,10 +3,14 @@
 
 /// COMPONENT
 #include <csapex/msg/transition.h>
+#include <csapex/msg/input_sync_policy.h>
+#include <csapex/msg/message.h>
 #include <csapex/utility/uuid.h>
 #include <csapex/model/node_runner.h>
 
 /// SYSTEM
+#include <atomic>
+#include <deque>
 #include <unordered_map>
 
 namespace csapex
@@ -36,6 +40,35 @@ public:
 
     int findHighestDeviantSequenceNumber() const;
 
+    /**
+     * @brief setSynchronizationPolicy decides when the messages of the inputs are forwarded, see InputSyncPolicy.
+     *        With APPROXIMATE_TIME and LATEST_VALUE, the tokens of the buffered inputs are taken from their connections
+     *        as soon as they arrive, so that their producers are never held back by the other inputs.
+     */
+    void setSynchronizationPolicy(InputSyncPolicy policy);
+    InputSyncPolicy getSynchronizationPolicy() const;
+
+    /**
+     * @brief setSynchronizationSlop sets the maximum difference of stamps that are matched with APPROXIMATE_TIME
+     */
+    void setSynchronizationSlop(connection_types::Message::Stamp slop_micro_seconds);
+    connection_types::Message::Stamp getSynchronizationSlop() const;
+
+    /**
+     * @brief setSynchronizationBufferSize limits the number of tokens buffered per input with APPROXIMATE_TIME,
+     *        the oldest token is dropped when the buffer is full
+     */
+    void setSynchronizationBufferSize(std::size_t size);
+    std::size_t getSynchronizationBufferSize() const;
+
+    /**
+     * @brief setPrimaryInput selects the input that triggers processing with LATEST_VALUE, defaults to the first input
+     */
+    void setPrimaryInput(const InputPtr& input);
+    InputPtr getPrimaryInput() const;
+
+    std::size_t countDroppedTokens() const;
+
     virtual bool isEnabled() const override;
 
     virtual void connectionRemoved(Connection* connection) override;
@@ -48,6 +81,12 @@ protected:
 private:
     bool areConnectionsReady() const;
 
+    bool isSynchronizing() const;
+    bool isBuffered(Input* input) const;
+    void takeToken(Input* input, Connection* connection);
+    bool findApproximateMatch();
+    bool isPrimaryReady() const;
+
 private:
     std::map<InputPtr, std::vector<slim_signal::Connection>> input_signal_connections_;
 
@@ -55,6 +94,17 @@ private:
 
     bool forwarded_;
     bool processed_;
+
+    std::atomic<InputSyncPolicy> policy_;
+    connection_types::Message::Stamp slop_;
+    std::size_t buffer_size_;
+    Input* primary_;
+
+    // tokens that have been taken from the connections of buffered inputs
+    std::map<Input*, std::deque<TokenPtr>> buffers_;
+    // tokens that are forwarded next with APPROXIMATE_TIME
+    std::map<Input*, TokenPtr> match_;
+    std::size_t dropped_;
 };
 
 }  // namespace csapex
@@ -122,6 +122,9 @@ TokenPtr createToken(T&& v, typename std::enable_if<connection_types::should_use
 /// INPUT
 CSAPEX_CORE_EXPORT TokenDataConstPtr getMessage(Input* input);
 
+/// messages are shared by all receivers, every copy made for a mutable version is counted per input
+CSAPEX_CORE_EXPORT void recordCopy(Input* input);
+
 template <typename R>
 std::shared_ptr<R const> getMessage(Input* input, typename std::enable_if<std::is_base_of<TokenData, R>::value>::type* /*dummy*/ = 0)
 {
@@ -162,6 +165,7 @@ std::shared_ptr<R> getClonedMessage(Input* input)
     if (msg == nullptr) {
         return nullptr;
     }
+    recordCopy(input);
     return message_cast<R>(msg->cloneRaw());
 }
 
@@ -241,7 +245,7 @@ void publish(Output* output, typename boost::shared_ptr<T> message, std::string
 template <typename T, typename = typename std::enable_if<connection_types::should_use_value_message<T>::value>::type>
 void publish(Output* output, T message, std::string frame_id = "/")
 {
-    typename connection_types::GenericValueMessage<T>::Ptr msg(new connection_types::GenericValueMessage<T>(message, frame_id));
+    auto msg = getMessageAllocator(output).allocateEnvelope<connection_types::GenericValueMessage<T>>(message, frame_id);
     publish(output, message_cast<TokenData>(msg));
 }
 
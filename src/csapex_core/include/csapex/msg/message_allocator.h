@@ -3,6 +3,7 @@
 
 /// PROJECT
 #include <csapex_core/csapex_core_export.h>
+#include <csapex/msg/message_pool.h>
 
 /// SYSTEM
 #include <memory>
@@ -93,6 +94,22 @@ public:
                 allocator_->deallocate(raw);
                 return nullptr;
             }
+        } else if (pool_stats_) {
+            return std::allocate_shared<T>(PoolAllocator<T>(pool_stats_), std::forward<Args>(args)...);
+        } else {
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief allocateEnvelope allocates message wrappers and tokens, which never use a custom allocator.
+     *        They are recycled by the MessagePool if pooling is enabled.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> allocateEnvelope(Args&&... args)
+    {
+        if (pool_stats_) {
+            return std::allocate_shared<T>(PoolAllocator<T>(pool_stats_), std::forward<Args>(args)...);
         } else {
             return std::make_shared<T>(std::forward<Args>(args)...);
         }
@@ -105,8 +122,22 @@ public:
         allocator_ = new MessageAllocatorImplementation<T, Alloc>(alloc);
     }
 
+    /**
+     * @brief enablePooling recycles the memory of messages allocated here once they are released.
+     * @param hits counts allocations served from the pool, created if not given
+     * @param misses counts allocations that had to use the heap, created if not given
+     */
+    void enablePooling(Counter::Ptr hits = nullptr, Counter::Ptr misses = nullptr);
+    void disablePooling();
+    bool isPooling() const;
+
+    Counter::Ptr getPoolHits() const;
+    Counter::Ptr getPoolMisses() const;
+
 private:
     MessageAllocatorImplementationInterface* allocator_;
+
+    std::shared_ptr<const MessagePool::Statistics> pool_stats_;
 };
 
 }  // namespace csapex
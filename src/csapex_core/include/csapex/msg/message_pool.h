@@ -0,0 +1,83 @@
+#ifndef MESSAGE_POOL_H
+#define MESSAGE_POOL_H
+
+/// PROJECT
+#include <csapex_core/csapex_core_export.h>
+#include <csapex/profiling/counter.h>
+
+/// SYSTEM
+#include <memory>
+
+namespace csapex
+{
+/**
+ * @brief The MessagePool class recycles the memory blocks of message envelopes.
+ *        Every thread keeps free lists keyed by block size, so allocating and releasing is lock free in the steady state.
+ *        Blocks released on another thread than the one that allocated them are exchanged in batches over a shared list.
+ *        Blocks are never returned to the heap.
+ */
+class CSAPEX_CORE_EXPORT MessagePool
+{
+public:
+    struct Statistics
+    {
+        Counter::Ptr hits;
+        Counter::Ptr misses;
+    };
+
+public:
+    static void* allocate(std::size_t bytes, const Statistics* stats = nullptr);
+    static void deallocate(void* block, std::size_t bytes);
+};
+
+/**
+ * @brief The PoolAllocator class is a standard allocator backed by the MessagePool.
+ *        Used with std::allocate_shared, the object and its control block share one recycled block
+ *        that is returned to the pool when the last shared_ptr is released.
+ */
+template <typename T>
+class PoolAllocator
+{
+    template <typename U>
+    friend class PoolAllocator;
+
+public:
+    typedef T value_type;
+
+    PoolAllocator(const std::shared_ptr<const MessagePool::Statistics>& stats = nullptr) : stats_(stats)
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : stats_(other.stats_)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(MessagePool::allocate(n * sizeof(T), stats_.get()));
+    }
+
+    void deallocate(T* ptr, std::size_t n)
+    {
+        MessagePool::deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const
+    {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const
+    {
+        return false;
+    }
+
+private:
+    std::shared_ptr<const MessagePool::Statistics> stats_;
+};
+
+}  // namespace csapex
+
+#endif  // MESSAGE_POOL_H
@@ -45,6 +45,7 @@ public:
 
 private:
     void fillConnections();
+    bool canAllConnectionsReceiveTokens() const;
 
 private:
     std::unordered_map<Output*, std::vector<slim_signal::ScopedConnection>> output_signal_connections_;
@@ -7,6 +7,8 @@
 /// SYSTEM
 #include <string>
 #include <map>
+#include <mutex>
+#include <ostream>
 #include <typeinfo>
 #include <vector>
 #include <functional>
@@ -61,6 +63,10 @@ public:
     void setPluginPaths(const std::string& type, const std::vector<std::string>& paths);
     std::vector<std::string> getPluginPaths(const std::string& type) const;
 
+    /// records how long loading a plugin type or a library took, printed by printLoadReport
+    void reportLoadTime(const std::string& name, double milliseconds, const std::string& details = "");
+    void printLoadReport(std::ostream& out) const;
+
 private:
     PluginLocator(const PluginLocator& copy) = delete;
     PluginLocator& operator=(const PluginLocator& copy) = delete;
@@ -80,6 +86,15 @@ private:
     param::StringListParameterPtr ignored_persistent_;
 
     std::map<std::string, std::vector<std::string>> plugin_paths_;
+
+    struct LoadTime
+    {
+        std::string name;
+        double milliseconds;
+        std::string details;
+    };
+    mutable std::mutex load_times_mutex_;
+    std::vector<LoadTime> load_times_;
 };
 }  // namespace csapex
 
@@ -5,11 +5,14 @@
 #include <csapex/utility/constructor.hpp>
 #include <csapex/plugin/plugin_locator.h>
 #include <csapex/plugin/plugin_constructor.hpp>
+#include <csapex/plugin/plugin_manifest.h>
 
 /// SYSTEM
 #include <csapex/utility/slim_signal.hpp>
 #include <csapex/plugin/class_loader.hpp>
 #include <set>
+#include <chrono>
+#include <sstream>
 #if WIN32
 #define TIXML_USE_STL
 #include <tinyxml/tinyxml.h>
@@ -59,60 +62,59 @@ protected:
     void load(csapex::PluginLocator* locator)
     {
         if (locator) {
+            auto start = std::chrono::steady_clock::now();
+
             std::vector<std::string> xml_files = locator->enumerateXmlFiles<M>();
             std::vector<std::string> library_paths = locator->enumerateLibraryPaths();
 
             library_paths_.insert(library_paths_.end(), library_paths.begin(), library_paths.end());
 
-            for (std::vector<std::string>::const_iterator manifest = xml_files.begin(); manifest != xml_files.end(); ++manifest) {
-                processManifest(locator, *manifest);
+            PluginManifestCache::Statistics statistics;
+            std::vector<PluginManifest> manifests = PluginManifestCache::instance().load(xml_files, &statistics);
+
+            // the xml documents are only read again if someone listens for them
+            bool documents_requested = manifest_loaded.isConnected();
+            for (const PluginManifest& manifest : manifests) {
+                processManifest(locator, manifest, documents_requested);
             }
+
+            double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::stringstream details;
+            details << manifests.size() << " manifests, " << statistics.cached << " cached, " << statistics.milliseconds << " ms parsing";
+            locator->reportLoadTime(full_name_, milliseconds, details.str());
         }
 
         plugins_loaded_ = true;
     }
 
-    bool processManifest(csapex::PluginLocator* locator, const std::string& xml_file)
+    bool processManifest(csapex::PluginLocator* locator, const PluginManifest& manifest, bool documents_requested)
     {
-        if (!bf3::exists(xml_file)) {
+        if (!manifest.valid) {
             return false;
         }
 
-        TiXmlDocument document;
-        document.LoadFile(xml_file);
-        TiXmlElement* config = document.RootElement();
-        if (config == nullptr) {
-            std::cerr << "[Plugin] Cannot load the file " << xml_file << std::endl;
-            return false;
-        }
+        for (const PluginManifest::Library& library : manifest.libraries) {
+            if (!locator->isLibraryIgnored(library.path)) {
+                loadLibrary(library);
+            }
 
-        TiXmlElement* library = config;
-        if (library->ValueStr() != "library") {
-            library = library->NextSiblingElement("library");
+            library_to_locator_[library.path] = locator;
         }
-        while (library != nullptr) {
-            std::string library_name = library->Attribute("path");
-            if (library_name.size() == 0) {
-                std::cerr << "[Plugin] Item in row" << library->Row() << " does not contain a path attribute" << std::endl;
-                continue;
-            }
 
-            if (!locator->isLibraryIgnored(library_name)) {
-                loadLibrary(library_name, library);
+        if (documents_requested) {
+            TiXmlDocument document;
+            document.LoadFile(manifest.file);
+            if (TiXmlElement* config = document.RootElement()) {
+                manifest_loaded(manifest.file, config);
             }
-
-            library_to_locator_[library_name] = locator;
-
-            library = library->NextSiblingElement("library");
         }
 
-        manifest_loaded(xml_file, config);
-
         return true;
     }
 
-    void loadLibrary(const std::string& library_name, TiXmlElement* library)
+    void loadLibrary(const PluginManifest::Library& library)
     {
+        const std::string& library_name = library.path;
 #if !WIN32
         std::stringstream ld_paths(getenv("LD_LIBRARY_PATH"));
         std::string ld_path;
@@ -130,37 +132,23 @@ protected:
         }
 #endif
 
-        TiXmlElement* class_element = library->FirstChildElement("class");
-        while (class_element) {
-            loadClass(library_name, class_element);
-
-            class_element = class_element->NextSiblingElement("class");
+        for (const PluginManifest::Class& class_entry : library.classes) {
+            loadClass(library_name, class_entry);
         }
     }
 
-    void loadClass(const std::string& library_name, TiXmlElement* class_element)
+    void loadClass(const std::string& library_name, const PluginManifest::Class& class_entry)
     {
-        std::string base_class_type = class_element->Attribute("base_class_type");
-        std::string derived_class = class_element->Attribute("type");
-
-        std::string lookup_name;
-        if (class_element->Attribute("name") != nullptr) {
-            lookup_name = class_element->Attribute("name");
-        } else {
-            lookup_name = derived_class;
-        }
-
-        if (base_class_type == full_name_) {
-            std::string description = readString(class_element, "description");
-            std::string icon = readString(class_element, "icon");
-            std::string tags = readString(class_element, "tags");
+        const std::string& lookup_name = class_entry.lookup_name;
 
+        if (class_entry.base_class_type == full_name_) {
             PluginConstructorM constructor;
             constructor.setType(lookup_name);
-            constructor.setDescription(description);
-            constructor.setIcon(icon);
-            constructor.setTags(tags);
+            constructor.setDescription(class_entry.description);
+            constructor.setIcon(class_entry.icon);
+            constructor.setTags(class_entry.tags);
 
+            // the library is only opened when the first instance is created
             constructor.setConstructor([this, lookup_name]() { return createInstance(lookup_name); });
             constructor.setLibraryName(library_name);
 
@@ -208,8 +196,10 @@ protected:
         auto pos = loaders_.find(library_path);
         if (pos == loaders_.end()) {
             try {
+                auto start = std::chrono::steady_clock::now();
                 auto loader = std::make_shared<class_loader::ClassLoader>(library_path);
                 library_to_locator_[library_name]->setLibraryLoaded(library_name, library_path);
+                library_to_locator_[library_name]->reportLoadTime(library_path, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), "library");
 
                 loaders_[library_path] = loader;
 
@@ -227,17 +217,6 @@ protected:
         }
     }
 
-    std::string readString(TiXmlElement* class_element, const std::string& name)
-    {
-        TiXmlElement* description = class_element->FirstChildElement(name);
-        std::string description_str;
-        if (description) {
-            description_str = description->GetText() ? description->GetText() : "";
-        }
-
-        return description_str;
-    }
-
     std::time_t getLastModification(const std::string& class_name)
     {
         std::string library = plugin_to_library_.at(class_name);
@@ -312,12 +291,16 @@ public:
         }
         ++i_count;
         instance->loaded.connect(loaded);
-        instance->manifest_loaded.connect(manifest_loaded);
+
+        // only relay the manifests if someone listens, otherwise the documents are not read at all
+        manifest_loaded.first_connected.connect([this]() { manifest_relay_ = instance->manifest_loaded.connect(manifest_loaded); });
+        manifest_loaded.last_disconnected.connect([this]() { manifest_relay_.disconnect(); });
     }
 
     virtual ~PluginManager()
     {
         std::unique_lock<std::mutex> lock(PluginManagerLocker::getMutex());
+        manifest_relay_.disconnect();
         apex_assert_hard(i_count > 0);
         --i_count;
         if (i_count == 0) {
@@ -387,9 +370,11 @@ public:
 
 public:
     slim_signal::Signal<void(const std::string&)> loaded;
-    slim_signal::Signal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
+    slim_signal::ObservableSignal<void(const std::string& file, const TiXmlElement* document)> manifest_loaded;
 
 protected:
+    slim_signal::ScopedConnection manifest_relay_;
+
     static int i_count;
     static Parent* instance;
 };
@@ -0,0 +1,89 @@
+#ifndef PLUGIN_MANIFEST_H
+#define PLUGIN_MANIFEST_H
+
+/// COMPONENT
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The PluginManifest struct holds the content of a plugin manifest file.
+ *        It only contains plain data, so that manifests can be parsed in parallel and cached.
+ */
+struct CSAPEX_CORE_EXPORT PluginManifest
+{
+    struct Class
+    {
+        std::string base_class_type;
+        std::string type;
+        std::string lookup_name;
+
+        std::string description;
+        std::string icon;
+        std::string tags;
+    };
+
+    struct Library
+    {
+        std::string path;
+        std::vector<Class> classes;
+    };
+
+    PluginManifest();
+
+    std::string file;
+    std::time_t last_modification;
+    bool valid;
+
+    std::vector<Library> libraries;
+
+    static PluginManifest parse(const std::string& file);
+};
+
+/**
+ * @brief The PluginManifestCache class parses manifest files in parallel.
+ *        The parsed manifests are stored on disk, a file is only parsed again when it has been modified.
+ */
+class CSAPEX_CORE_EXPORT PluginManifestCache
+{
+public:
+    struct Statistics
+    {
+        Statistics();
+
+        std::size_t parsed;
+        std::size_t cached;
+        double milliseconds;
+    };
+
+public:
+    static PluginManifestCache& instance();
+
+    PluginManifestCache(const std::string& cache_file);
+
+    /// returns the manifests in the same order as the files
+    std::vector<PluginManifest> load(const std::vector<std::string>& files, Statistics* statistics = nullptr);
+
+private:
+    void readCache();
+    void writeCache();
+
+private:
+    std::mutex mutex_;
+
+    std::string cache_file_;
+    bool cache_read_;
+
+    std::map<std::string, PluginManifest> manifests_;
+};
+
+}  // namespace csapex
+
+#endif  // PLUGIN_MANIFEST_H
@@ -0,0 +1,56 @@
+#ifndef CHROME_TRACE_WRITER_H
+#define CHROME_TRACE_WRITER_H
+
+/// COMPONENT
+#include <csapex/profiling/trace_collector.h>
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace csapex
+{
+/**
+ * @brief The ChromeTraceWriter class streams all collected trace records to a file in the chrome trace event format.
+ *        The file can be opened in chrome://tracing or ui.perfetto.dev.
+ *        Spans become complete events, waits become async events and flow records are drawn as arrows.
+ */
+class CSAPEX_PROFILING_EXPORT ChromeTraceWriter
+{
+public:
+    ChromeTraceWriter(const std::string& file, std::chrono::milliseconds collect_interval = std::chrono::milliseconds(100));
+    ~ChromeTraceWriter();
+
+    bool isOpen() const;
+
+    /// collects and writes all pending records
+    void flush();
+
+private:
+    void collectLoop();
+    void write(const std::vector<TraceSpan>& spans);
+    void writeEvent(const TraceSpan& span, const char* phase, const std::string& name, uint64_t ts_ns);
+
+private:
+    std::ofstream out_;
+    std::mutex file_mutex_;
+    bool first_event_;
+    std::set<std::size_t> named_threads_;
+
+    slim_signal::ScopedConnection connection_;
+
+    std::chrono::milliseconds collect_interval_;
+    std::thread collector_;
+    std::mutex running_mutex_;
+    std::condition_variable running_changed_;
+    bool running_;
+};
+
+}  // namespace csapex
+
+#endif  // CHROME_TRACE_WRITER_H
@@ -0,0 +1,41 @@
+#ifndef COUNTER_H
+#define COUNTER_H
+
+/// COMPONENT
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief The Counter class counts events, e.g. pool hits and misses.
+ *        Incrementing is lock-free and can be done from any thread.
+ */
+class CSAPEX_PROFILING_EXPORT Counter
+{
+public:
+    typedef std::shared_ptr<Counter> Ptr;
+
+public:
+    Counter(const std::string& name);
+
+    std::string getName() const;
+
+    void increment(std::size_t n = 1);
+    void reset();
+
+    std::size_t get() const;
+
+private:
+    std::string name_;
+
+    std::atomic<std::size_t> value_;
+};
+
+}  // namespace csapex
+
+#endif  // COUNTER_H
@@ -0,0 +1,57 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+/// COMPONENT
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace csapex
+{
+/**
+ * @brief The Histogram class counts durations in logarithmic buckets.
+ *        Bucket 0 holds values below one microsecond, bucket i holds values in [2^(i-1), 2^i) microseconds.
+ *        Recording is lock-free and can be done from any thread.
+ */
+class CSAPEX_PROFILING_EXPORT Histogram
+{
+public:
+    typedef std::shared_ptr<Histogram> Ptr;
+
+    enum
+    {
+        BUCKETS = 32
+    };
+
+public:
+    Histogram(const std::string& name);
+
+    std::string getName() const;
+
+    void add(std::chrono::nanoseconds value);
+    void reset();
+
+    std::size_t count() const;
+    std::size_t getBucketCount(std::size_t bucket) const;
+    std::chrono::nanoseconds getMaximum() const;
+    std::chrono::nanoseconds getMean() const;
+
+    static std::size_t getBucket(std::chrono::nanoseconds value);
+    static std::chrono::microseconds getBucketUpperBound(std::size_t bucket);
+
+private:
+    std::string name_;
+
+    std::atomic<std::size_t> buckets_[BUCKETS];
+    std::atomic<std::size_t> count_;
+    std::atomic<long long> sum_ns_;
+    std::atomic<long long> max_ns_;
+};
+
+}  // namespace csapex
+
+#endif  // HISTOGRAM_H
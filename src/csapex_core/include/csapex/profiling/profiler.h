@@ -4,11 +4,15 @@
 /// COMPONENT
 #include <csapex/profiling/timer.h>
 #include <csapex/profiling/profile.h>
+#include <csapex/profiling/histogram.h>
+#include <csapex/profiling/counter.h>
+#include <csapex/profiling/trace_collector.h>
 #include <csapex_profiling_export.h>
 #include <csapex/model/observer.h>
 
 /// SYSTEM
 #include <map>
+#include <mutex>
 
 namespace csapex
 {
@@ -26,6 +30,15 @@ public:
     Timer::Ptr getTimer(const std::string& key);
     const Profile& getProfile(const std::string& key);
 
+    Histogram::Ptr getHistogram(const std::string& key);
+    std::vector<Histogram::Ptr> getHistograms() const;
+
+    Counter::Ptr getCounter(const std::string& key);
+    std::vector<Counter::Ptr> getCounters() const;
+
+    /// aggregates the always-on trace records with the given name, see TraceCollector
+    TraceStatistics getTraceStatistics(const std::string& key) const;
+
 public:
     slim_signal::Signal<void(bool)> enabled_changed;
 
@@ -35,6 +48,12 @@ protected:
 protected:
     std::map<std::string, Profile> profiles_;
 
+    mutable std::mutex histograms_mutex_;
+    std::map<std::string, Histogram::Ptr> histograms_;
+
+    mutable std::mutex counters_mutex_;
+    std::map<std::string, Counter::Ptr> counters_;
+
     bool enabled_;
     std::size_t history_length_;
 };
@@ -0,0 +1,135 @@
+#ifndef TRACE_BUFFER_H
+#define TRACE_BUFFER_H
+
+/// COMPONENT
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace csapex
+{
+enum class TraceType : uint8_t
+{
+    /// work done by the recording thread
+    SPAN,
+    /// time something spent waiting, e.g. in a queue
+    WAIT,
+    /// a value leaving the recording thread, matched by id with a FLOW_END
+    FLOW_BEGIN,
+    FLOW_END
+};
+
+struct TraceRecord
+{
+    TraceType type;
+    uint32_t name;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+    uint64_t id;
+};
+
+/**
+ * @brief The TraceBuffer class is a fixed size ring of trace records owned by a single thread.
+ *        Recording never locks or allocates, when the ring is full the oldest records are overwritten.
+ *        Names are interned once and records refer to them by id.
+ *        The buffers are drained by the TraceCollector.
+ */
+class CSAPEX_PROFILING_EXPORT TraceBuffer
+{
+public:
+    typedef std::shared_ptr<TraceBuffer> Ptr;
+
+    enum : std::size_t
+    {
+        CAPACITY = 8192,
+        /// buffers of finished threads that are kept until they are read, older ones are discarded
+        MAX_RETIRED_BUFFERS = 64
+    };
+
+public:
+    static uint32_t intern(const std::string& name);
+    static std::string getName(uint32_t id);
+
+    /// steady clock time in nanoseconds
+    static uint64_t now();
+
+    /// records a finished span in the buffer of the calling thread
+    static void record(uint32_t name, uint64_t begin_ns, uint64_t end_ns);
+    static void record(TraceType type, uint32_t name, uint64_t begin_ns, uint64_t end_ns, uint64_t id);
+
+    /**
+     * @brief getBuffers returns the buffers of all threads.
+     *        Buffers of finished threads are returned a last time and then released.
+     */
+    static std::vector<Ptr> getBuffers();
+    static std::size_t countBuffers();
+    /// the number of unread records in buffers of finished threads that were released without being read
+    static std::size_t takeDiscardedRecordCount();
+
+public:
+    TraceBuffer(std::size_t thread_index);
+
+    std::size_t getThreadIndex() const;
+    bool isRetired() const;
+    std::size_t countUnread() const;
+
+    void push(TraceType type, uint32_t name, uint64_t begin_ns, uint64_t end_ns, uint64_t id);
+
+    /**
+     * @brief read appends all records written since the last read, only one reader may be active at a time
+     * @return the number of records that were overwritten before they could be read
+     */
+    std::size_t read(std::vector<TraceRecord>& out);
+
+private:
+    friend struct ThreadTraceBuffer;
+
+    struct Slot
+    {
+        /// the type is stored in the upper half of the name word
+        std::atomic<uint64_t> name;
+        std::atomic<uint64_t> begin_ns;
+        std::atomic<uint64_t> end_ns;
+        std::atomic<uint64_t> id;
+    };
+
+    Slot slots_[CAPACITY];
+    std::atomic<uint64_t> head_;
+    std::atomic<uint64_t> tail_;
+
+    std::size_t thread_index_;
+    std::atomic<bool> retired_;
+};
+
+/**
+ * @brief The TraceScope class records the span of its lifetime in the buffer of the current thread.
+ */
+class TraceScope
+{
+public:
+    TraceScope(uint32_t name) : name_(name), begin_ns_(TraceBuffer::now())
+    {
+    }
+
+    ~TraceScope()
+    {
+        TraceBuffer::record(name_, begin_ns_, TraceBuffer::now());
+    }
+
+private:
+    TraceScope(const TraceScope& copy) = delete;
+    TraceScope& operator=(const TraceScope& copy) = delete;
+
+private:
+    uint32_t name_;
+    uint64_t begin_ns_;
+};
+
+}  // namespace csapex
+
+#endif  // TRACE_BUFFER_H
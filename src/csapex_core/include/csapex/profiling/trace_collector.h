@@ -0,0 +1,72 @@
+#ifndef TRACE_COLLECTOR_H
+#define TRACE_COLLECTOR_H
+
+/// COMPONENT
+#include <csapex/profiling/trace_buffer.h>
+#include <csapex/utility/slim_signal.hpp>
+#include <csapex_profiling_export.h>
+
+/// SYSTEM
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace csapex
+{
+struct TraceSpan
+{
+    TraceType type;
+    uint32_t name;
+    std::size_t thread;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+    uint64_t id;
+};
+
+struct TraceStatistics
+{
+    std::size_t count = 0;
+    std::chrono::nanoseconds total{ 0 };
+    std::chrono::nanoseconds min{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+
+    std::chrono::nanoseconds mean() const;
+};
+
+/**
+ * @brief The TraceCollector class drains the per thread trace buffers.
+ *        Statistics are only aggregated when they are requested, recording itself never waits for the collector.
+ */
+class CSAPEX_PROFILING_EXPORT TraceCollector
+{
+public:
+    static TraceCollector& instance();
+
+    /// receives every batch of spans read from the buffers
+    slim_signal::Signal<void(const std::vector<TraceSpan>&)> spans_collected;
+
+public:
+    void collect();
+
+    TraceStatistics getStatistics(const std::string& name);
+    std::map<std::string, TraceStatistics> getAllStatistics();
+
+    std::size_t getLostRecordCount();
+
+    void reset();
+
+private:
+    TraceCollector();
+
+private:
+    std::recursive_mutex mutex_;
+
+    std::unordered_map<uint32_t, TraceStatistics> statistics_;
+    std::size_t lost_;
+};
+
+}  // namespace csapex
+
+#endif  // TRACE_COLLECTOR_H
@@ -7,11 +7,22 @@
 
 /// SYSTEM
 #include <functional>
+#include <atomic>
+#include <cstdint>
+#include <string>
 
 namespace csapex
 {
 class CSAPEX_CORE_EXPORT Task
 {
+    friend class TaskQueue;
+
+public:
+    enum : std::size_t
+    {
+        NOT_QUEUED = static_cast<std::size_t>(-1)
+    };
+
 public:
     Task(const std::string& name, std::function<void()> callback, long priority = 0, TaskGenerator* parent = nullptr);
     virtual ~Task();
@@ -24,16 +35,30 @@ public:
     void setScheduled(bool scheduled);
     bool isScheduled() const;
 
+    // queue membership, owned by the scheduler that holds the task
+    bool markQueued();
+    void unmarkQueued();
+    bool isQueued() const;
+
     TaskGenerator* getParent() const;
     std::string getName() const;
 
+    /// the interned name used for trace records
+    uint32_t getTraceName() const;
+
 private:
     TaskGenerator* parent_;
     std::string name_;
+    uint32_t trace_name_;
     std::function<void()> callback_;
 
     long priority_;
-    bool scheduled_;
+    std::atomic<bool> scheduled_;
+    std::atomic<bool> queued_;
+
+    // intrusive bookkeeping of TaskQueue
+    std::size_t queue_position_;
+    unsigned long queue_sequence_;
 };
 
 }  // namespace csapex
@@ -8,12 +8,14 @@
 
 /// SYSTEM
 #include <csapex/utility/slim_signal.hpp>
+#include <atomic>
 
 namespace csapex
 {
 class CSAPEX_CORE_EXPORT TaskGenerator : public std::enable_shared_from_this<TaskGenerator>
 {
 public:
+    TaskGenerator();
     virtual ~TaskGenerator();
 
     virtual void assignToScheduler(Scheduler* scheduler) = 0;
@@ -37,10 +39,18 @@ public:
 
     virtual void setSuppressExceptions(bool suppress_exceptions) = 0;
 
+    // tasks of one generator must never run concurrently, multi-worker groups claim the generator first
+    bool tryBeginExecution();
+    void endExecution();
+    bool isExecuting() const;
+
 public:
     slim_signal::Signal<void()> stepping_enabled;
     slim_signal::Signal<void()> begin_step;
     slim_signal::Signal<void()> end_step;
+
+private:
+    std::atomic<bool> executing_;
 };
 
 }  // namespace csapex
@@ -0,0 +1,53 @@
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+/// PROJECT
+#include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex_core/csapex_core_export.h>
+
+/// SYSTEM
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The TaskQueue class is an intrusive binary heap of tasks.
+ *        Every task knows its position in the heap, so duplicate checks and removal do not need to search.
+ *        Tasks with higher priority come first, tasks of equal priority are ordered first-in-first-out.
+ *        The queue is not synchronized, the owning scheduler has to guard it.
+ */
+class CSAPEX_CORE_EXPORT TaskQueue
+{
+public:
+    TaskQueue();
+    ~TaskQueue();
+
+    /// @return false, iff the task is already queued
+    bool push(const TaskPtr& task);
+    TaskPtr pop();
+
+    bool remove(const TaskPtr& task);
+    std::vector<TaskPtr> remove(TaskGenerator* generator);
+
+    /// @return all queued tasks in execution order, the queue is empty afterwards
+    std::vector<TaskPtr> takeAll();
+    void clear();
+
+    bool empty() const;
+    std::size_t size() const;
+
+private:
+    bool before(std::size_t a, std::size_t b) const;
+    void place(std::size_t pos, const TaskPtr& task);
+    void siftUp(std::size_t pos);
+    void siftDown(std::size_t pos);
+    void erase(std::size_t pos);
+
+private:
+    std::vector<TaskPtr> heap_;
+    unsigned long next_sequence_;
+};
+
+}  // namespace csapex
+
+#endif  // TASK_QUEUE_H
@@ -4,6 +4,7 @@
 /// PROJECT
 #include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/task.h>
+#include <csapex/scheduling/task_queue.h>
 #include <csapex/core/core_fwd.h>
 #include <csapex/utility/utility_fwd.h>
 #include <csapex/profiling/profiling_fwd.h>
@@ -16,7 +17,6 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
-#include <set>
 
 namespace YAML
 {
@@ -51,8 +51,20 @@ public:
 
     CpuAffinityPtr getCpuAffinity() const;
 
+    /**
+     * @brief thread returns the thread executing the tasks of this group.
+     *        With more than one worker, this is the thread of the first worker.
+     */
     const std::thread& thread() const;
 
+    /**
+     * @brief setWorkerCount changes the number of threads executing the tasks of this group.
+     *        With more than one worker, every worker owns a task queue and idle workers steal from the others.
+     *        Tasks of the same generator are never executed concurrently.
+     */
+    void setWorkerCount(std::size_t workers);
+    std::size_t getWorkerCount() const;
+
     std::size_t size() const;
     virtual bool isEmpty() const override;
 
@@ -70,13 +82,19 @@ public:
 
     bool isRunning() const;
 
+    /**
+     * @brief getWakeUps counts how often a thread of this group has woken up while waiting for tasks.
+     *        Threads are only woken by scheduling or stopping, so this stays constant while the group is idle.
+     */
+    std::size_t getWakeUps() const;
+
     virtual void add(TaskGeneratorPtr generator) override;
     virtual void add(TaskGeneratorPtr generator, const std::vector<TaskPtr>& initial_tasks) override;
 
     virtual std::vector<TaskPtr> remove(TaskGenerator* generator) override;
 
     virtual void schedule(TaskPtr schedulable) override;
-    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::system_clock::time_point time) override;
+    virtual void scheduleDelayed(TaskPtr schedulable, std::chrono::steady_clock::time_point time) override;
 
     std::vector<TaskGeneratorPtr>::iterator begin();
     std::vector<TaskGeneratorPtr>::const_iterator begin() const;
@@ -91,15 +109,34 @@ public:
     slim_signal::Signal<void(TaskGeneratorPtr)> generator_removed;
 
 private:
+    struct Worker;
+    class ExecutionClaim;
+
     void setup();
     void schedulingLoop();
     void updateAffinity();
+    void updateAffinity(std::thread& thread);
+
+    bool isWorkStealing() const;
+    void createWorkers(std::size_t count);
+    void startThreads();
+    void joinThreads();
+    std::vector<std::unique_lock<std::recursive_mutex>> lockExecution();
+
+    void workerLoop(Worker* worker);
+    TaskPtr takeRunnableTask(Worker* worker);
+    TaskPtr takeRunnableTask(Worker* worker, bool steal);
+    void waitForWork(std::size_t epoch);
+    void wakeWorker();
 
     bool waitForTasks();
     void handlePause();
     bool executeNextTask();
 
     void executeTask(const TaskPtr& task);
+    void executeTask(const TaskPtr& task, Worker* worker);
+    void executeTask(const TaskPtr& task, std::recursive_mutex& execution_mtx, std::size_t worker_index);
+    void endExecution(TaskGenerator* generator);
 
     void checkIfStepIsDone();
 
@@ -126,15 +163,7 @@ private:
     std::condition_variable_any pause_changed_;
 
     std::recursive_mutex tasks_mtx_;
-    struct greater
-    {
-        bool operator()(const TaskPtr& a, const TaskPtr& b)
-        {
-            return a->getPriority() > b->getPriority();
-        }
-    };
-
-    std::multiset<TaskPtr, greater> tasks_;
+    TaskQueue tasks_;
 
     std::recursive_mutex state_mtx_;
     std::atomic<bool> running_;
@@ -142,6 +171,22 @@ private:
     std::atomic<bool> stepping_;
 
     mutable std::recursive_mutex execution_mtx_;
+
+    std::atomic<std::size_t> worker_count_;
+    // only changes under tasks_mtx_ while the worker threads are joined
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> next_worker_;
+
+    std::mutex idle_mtx_;
+    std::condition_variable idle_changed_;
+    std::atomic<std::size_t> work_epoch_;
+    std::atomic<int> idle_workers_;
+
+    std::mutex execution_finished_mtx_;
+    std::condition_variable execution_finished_;
+    std::atomic<int> removals_waiting_;
+
+    std::atomic<std::size_t> wake_ups_;
 };
 
 }  // namespace csapex
@@ -3,60 +3,115 @@
 
 /// COMPONENT
 #include <csapex/scheduling/scheduling_fwd.h>
+#include <csapex/profiling/profilable.h>
+#include <csapex/profiling/histogram.h>
+#include <csapex_core/csapex_core_export.h>
 
 /// SYSTEM
+#include <atomic>
 #include <thread>
+#include <mutex>
 #include <condition_variable>
 #include <chrono>
-#include <set>
-#include <atomic>
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
 
 namespace csapex
 {
-class TimedQueue
+/**
+ * @brief The TimedQueue class schedules tasks at a given point in time.
+ *        Deadlines are kept in a hierarchical timing wheel driven by a single thread,
+ *        so insertion and cancellation are constant time operations.
+ *        Each level has 256 slots, one slot of the lowest level spans TICK.
+ *        Within a slot, deadlines are met exactly, the slot only determines the bookkeeping.
+ *        The lateness of every dispatched task is recorded in the profiler histogram "timed queue".
+ */
+class CSAPEX_CORE_EXPORT TimedQueue : public Profilable
 {
+public:
+    typedef std::chrono::steady_clock clock;
+    typedef std::uint64_t Handle;
+
+    enum : Handle
+    {
+        INVALID_HANDLE = 0
+    };
+
+    static constexpr std::chrono::microseconds::rep TICK_US = 100;
+
 public:
     TimedQueue();
     ~TimedQueue();
 
-    void schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::system_clock::time_point time);
+    Handle schedule(SchedulerPtr scheduler, TaskPtr schedulable, clock::time_point time);
+    bool cancel(Handle handle);
+
+    std::size_t size() const;
+
+    /**
+     * @brief getWakeUps counts how often the scheduling thread has woken up.
+     *        Without pending deadlines the thread sleeps until a task is scheduled.
+     */
+    std::size_t getWakeUps() const;
 
     void start();
     void stop();
 
-private:
-    void loop();
-    void sleep();
+    void useProfiler(std::shared_ptr<Profiler> profiler) override;
 
 private:
-    std::thread scheduling_thread_;
-    std::thread sleeping_thread_;
-
-    std::atomic<bool> scheduling_running_;
-    std::atomic<bool> sleeping_running_;
+    enum
+    {
+        LEVELS = 4,
+        SLOT_BITS = 8,
+        SLOTS = 1 << SLOT_BITS,
+        SLOT_MASK = SLOTS - 1
+    };
 
     struct Unit
     {
+        Handle handle;
         SchedulerPtr scheduler;
         TaskPtr schedulable;
-        std::chrono::system_clock::time_point time;
+        clock::time_point time;
+        std::uint64_t scheduled_ns;
+        std::uint64_t tick;
+        int level;
+        std::size_t slot;
     };
+    typedef std::list<Unit> Slot;
 
-    struct UnitCompare
-    {
-        bool operator()(const Unit& a, const Unit& b) const
-        {
-            return a.time < b.time;
-        }
-    };
+    void loop();
+
+    std::uint64_t toTick(clock::time_point time) const;
+    clock::time_point toTime(std::uint64_t tick) const;
+
+    void place(Slot& source, Slot::iterator unit);
+    void cascade(int level);
+    void advance(clock::time_point now, Slot& expired);
+    clock::time_point nextWakeUp() const;
 
-    std::mutex task_mtx_;
+private:
+    std::thread scheduling_thread_;
+    bool running_;
+
+    mutable std::mutex task_mtx_;
     std::condition_variable tasks_changed_;
-    std::set<Unit, UnitCompare> tasks_;
 
-    std::mutex sleep_mtx_;
-    std::condition_variable next_wake_up_changed_;
-    std::chrono::system_clock::time_point next_wake_up_;
+    clock::time_point origin_;
+    std::uint64_t current_tick_;
+    clock::time_point next_wake_up_;
+
+    Slot wheel_[LEVELS][SLOTS];
+    std::size_t level_size_[LEVELS];
+    std::unordered_map<Handle, Slot::iterator> units_;
+    Handle next_handle_;
+
+    Histogram::Ptr jitter_;
+
+    std::atomic<std::size_t> wake_ups_;
 };
 
 }  // namespace csapex
@@ -22,25 +22,43 @@ SerializationBuffer& operator<<(SerializationBuffer& data, const std::stringstre
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::stringstream& s);
 
 // VECTOR
-template <typename S, typename std::enable_if<!std::is_base_of<Serializable, S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<!std::is_base_of<Serializable, S>::value && !SerializationBuffer::is_bulk_copyable<S>::value &&
+                                                  !SerializationBuffer::has_array_encoding<S>::value,
+                                              int>::type = 0>
 SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
 {
-    apex_assert_lt_hard(s.size(), std::numeric_limits<uint8_t>::max());
-    data << (static_cast<uint8_t>(s.size()));
+    data.writeLength(s.size());
     for (const S& elem : s) {
         data << elem;
     }
     return data;
 }
 
-template <typename S, typename std::enable_if<std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<SerializationBuffer::is_bulk_copyable<S>::value, int>::type = 0>
+SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
+{
+    data.writeLength(s.size());
+    // the elements already have the wire layout, copy them in one go
+    data.writeRaw(reinterpret_cast<const uint8_t*>(s.data()), s.size() * sizeof(S));
+    return data;
+}
+
+template <typename S, typename std::enable_if<SerializationBuffer::has_array_encoding<S>::value, int>::type = 0>
+SerializationBuffer& operator<<(SerializationBuffer& data, const std::vector<S>& s)
+{
+    data.writeLength(s.size());
+    data.writeArray(s.data(), s.size());
+    return data;
+}
+
+template <typename S, typename std::enable_if<std::is_integral<S>::value && !SerializationBuffer::is_bulk_copyable<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    uint64_t len = data.readLength();
+    data.checkReadable(len, sizeof(S));
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         S integral;
         data >> integral;
         s.push_back(integral);
@@ -48,14 +66,35 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vect
     return data;
 }
 
-template <typename S, typename std::enable_if<!std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value && std::is_default_constructible<S>::value, int>::type = 0>
+template <typename S, typename std::enable_if<SerializationBuffer::is_bulk_copyable<S>::value, int>::type = 0>
+const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
+{
+    uint64_t len = data.readLength();
+    data.checkReadable(len, sizeof(S));
+    s.resize(len);
+    data.readRaw(reinterpret_cast<uint8_t*>(s.data()), len * sizeof(S));
+    return data;
+}
+
+template <typename S, typename std::enable_if<SerializationBuffer::has_array_encoding<S>::value, int>::type = 0>
+const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
+{
+    uint64_t len = data.readLength();
+    data.checkReadable(len, sizeof(S));
+    s.resize(len);
+    data.readArray(s.data(), len);
+    return data;
+}
+
+template <typename S, typename std::enable_if<!std::is_integral<S>::value && !SerializationBuffer::has_array_encoding<S>::value && !std::is_base_of<Serializable, S>::value &&
+                                                  std::is_default_constructible<S>::value,
+                                              int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         s.emplace_back();
         data >> s.back();
     }
@@ -65,11 +104,10 @@ const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vect
 template <typename S, typename std::enable_if<!std::is_integral<S>::value && !std::is_base_of<Serializable, S>::value && !std::is_default_constructible<S>::value, int>::type = 0>
 const SerializationBuffer& operator>>(const SerializationBuffer& data, std::vector<S>& s)
 {
-    uint8_t len;
-    data >> len;
+    std::size_t len = data.readLength();
     s.reserve(len);
     s.clear();
-    for (uint8_t i = 0; i < len; ++i) {
+    for (std::size_t i = 0; i < len; ++i) {
         std::shared_ptr<S> object = makeEmpty<S>();
         data >> object;
         s.push_back(*object);
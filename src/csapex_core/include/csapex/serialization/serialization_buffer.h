@@ -3,6 +3,7 @@
 
 /// PROJECT
 #include <csapex/utility/assert.h>
+#include <csapex/utility/semantic_version.h>
 #include <csapex/serialization/serialization_fwd.h>
 
 /// SYSTEM
@@ -15,6 +16,9 @@
 #include <typeindex>
 #include <boost/any.hpp>
 #include <map>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
 namespace YAML
 {
@@ -23,18 +27,138 @@ class Node;
 
 namespace csapex
 {
+/**
+ * @brief The SerializationStorage class provides memory for a SerializationBuffer outside of the heap,
+ *        e.g. in a shared memory segment that the serialized data is passed through
+ */
+class SerializationStorage
+{
+public:
+    virtual ~SerializationStorage() = default;
+
+    virtual uint8_t* allocate(std::size_t bytes) = 0;
+    virtual void deallocate(uint8_t* data) = 0;
+};
+
+/**
+ * @brief The SerializationAllocator class takes memory from a SerializationStorage, or from the heap without one.
+ *        Copies of a buffer are always allocated on the heap.
+ */
+template <typename T>
+class SerializationAllocator
+{
+public:
+    typedef T value_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef SerializationAllocator<U> other;
+    };
+
+    SerializationAllocator(SerializationStorage* storage = nullptr) : storage_(storage)
+    {
+    }
+    template <typename U>
+    SerializationAllocator(const SerializationAllocator<U>& other) : storage_(other.getStorage())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (storage_) {
+            return reinterpret_cast<T*>(storage_->allocate(n * sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* data, std::size_t)
+    {
+        if (storage_) {
+            storage_->deallocate(reinterpret_cast<uint8_t*>(data));
+        } else {
+            ::operator delete(data);
+        }
+    }
+
+    SerializationAllocator select_on_container_copy_construction() const
+    {
+        return SerializationAllocator();
+    }
+
+    SerializationStorage* getStorage() const
+    {
+        return storage_;
+    }
+
+private:
+    SerializationStorage* storage_;
+};
+
+template <typename T, typename U>
+bool operator==(const SerializationAllocator<T>& a, const SerializationAllocator<U>& b)
+{
+    return a.getStorage() == b.getStorage();
+}
+template <typename T, typename U>
+bool operator!=(const SerializationAllocator<T>& a, const SerializationAllocator<U>& b)
+{
+    return !(a == b);
+}
+
 /**
  * @brief SerializationBuffer
  */
-class SerializationBuffer : public std::vector<uint8_t>
+class SerializationBuffer : public std::vector<uint8_t, SerializationAllocator<uint8_t>>
 {
 public:
     static const uint8_t HEADER_LENGTH = 4;
 
+    /**
+     * @brief FORMAT_VERSION is the version of the container encoding written by default.
+     *
+     * 1.0.0 stores container lengths in a single byte (strings: two bytes) and is limited to 254 elements.
+     * 1.1.0 keeps that encoding for short containers, longer ones are marked with an all-ones prefix followed by a varint.
+     * Data written in 1.0.0 can always be read.
+     */
+    static constexpr SemanticVersion FORMAT_VERSION{ 1, 1, 0 };
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr bool NATIVE_LITTLE_ENDIAN = false;
+#else
+    static constexpr bool NATIVE_LITTLE_ENDIAN = true;
+#endif
+
+    /**
+     * @brief is_bulk_copyable is true for types whose in-memory representation matches the wire format,
+     *        these are written and read with a single memcpy
+     */
+    template <typename T>
+    struct is_bulk_copyable
+    {
+        static constexpr bool value = NATIVE_LITTLE_ENDIAN && std::is_integral<T>::value && !std::is_same<T, bool>::value;
+    };
+
+    /**
+     * @brief has_array_encoding is true for types that are not bulk copyable, but whose arrays can be encoded in a single pass
+     */
+    template <typename T>
+    struct has_array_encoding
+    {
+        static constexpr bool value = std::is_same<T, float>::value || std::is_same<T, double>::value;
+    };
+
 public:
     SerializationBuffer();
     SerializationBuffer(const std::vector<uint8_t>& copy, bool insert_header = false);
     SerializationBuffer(const uint8_t* raw_data, const std::size_t length, bool insert_header = false);
+    /**
+     * @brief SerializationBuffer writes into memory of <b>storage</b>, which has to outlive the buffer
+     */
+    explicit SerializationBuffer(SerializationStorage& storage);
 
     void finalize();
 
@@ -44,6 +168,27 @@ public:
 
     uint32_t getPos() const;
 
+    /**
+     * @brief setFormatVersion restricts the written encoding, e.g. for a peer that only understands 1.0.0
+     */
+    void setFormatVersion(const SemanticVersion& version);
+    SemanticVersion getFormatVersion() const;
+
+    // CONTAINER LENGTHS
+    void writeLength(uint64_t length);
+    uint64_t readLength() const;
+
+    void writeStringLength(uint64_t length);
+    uint64_t readStringLength() const;
+
+    void writeVarint(uint64_t value);
+    uint64_t readVarint() const;
+
+    /**
+     * @brief reserveAdditional makes room for at least <b>bytes</b> more bytes without reallocating
+     */
+    void reserveAdditional(std::size_t bytes);
+
     std::string toString() const;
 
     // SERIALIZABLES
@@ -56,6 +201,11 @@ public:
     void readRaw(char* data, const std::size_t length) const;
     void readRaw(uint8_t* data, const std::size_t length) const;
 
+    /**
+     * @brief checkReadable throws if less than <b>count</b> elements of <b>element_size</b> bytes are left to read
+     */
+    void checkReadable(uint64_t count, std::size_t element_size) const;
+
     template <typename T, typename std::enable_if<std::is_base_of<Streamable, T>::value, int>::type = 0>
     SerializationBuffer& operator<<(const std::shared_ptr<T>& i)
     {
@@ -73,23 +223,36 @@ public:
     template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
     SerializationBuffer& operator<<(T i)
     {
-        std::size_t nbytes = sizeof(T);
-        for (std::size_t byte = 0; byte < nbytes; ++byte) {
-            uint8_t part = (i >> (byte * 8)) & 0xFF;
-            push_back(part);
+        if (is_bulk_copyable<T>::value) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&i);
+            insert(end(), bytes, bytes + sizeof(T));
+
+        } else {
+            std::size_t nbytes = sizeof(T);
+            for (std::size_t byte = 0; byte < nbytes; ++byte) {
+                uint8_t part = (i >> (byte * 8)) & 0xFF;
+                push_back(part);
+            }
         }
         return *this;
     }
     template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
     const SerializationBuffer& operator>>(T& i) const
     {
-        std::size_t nbytes = sizeof(T);
-        T res = 0;
-        for (std::size_t byte = 0; byte < nbytes; ++byte) {
-            uint8_t part = static_cast<T>(at(pos++));
-            res |= (part << (byte * 8));
+        checkReadable(sizeof(T));
+        if (is_bulk_copyable<T>::value) {
+            std::memcpy(&i, data() + pos, sizeof(T));
+            pos += sizeof(T);
+
+        } else {
+            std::size_t nbytes = sizeof(T);
+            T res = 0;
+            for (std::size_t byte = 0; byte < nbytes; ++byte) {
+                T part = static_cast<T>(operator[](pos++));
+                res |= static_cast<T>(part << (byte * 8));
+            }
+            i = res;
         }
-        i = res;
         return *this;
     }
 
@@ -101,6 +264,15 @@ public:
     SerializationBuffer& operator<<(double d);
     const SerializationBuffer& operator>>(double& d) const;
 
+    // FLOATING POINT ARRAYS
+    /**
+     * @brief writeArray encodes <b>count</b> values like the single value operators, but with only one allocation
+     */
+    void writeArray(const float* data, std::size_t count);
+    void writeArray(const double* data, std::size_t count);
+    void readArray(float* data, std::size_t count) const;
+    void readArray(double* data, std::size_t count) const;
+
     // ENUMS
     template <typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
     SerializationBuffer& operator<<(T i)
@@ -138,9 +310,18 @@ public:
 private:
     static void init();
 
+    void checkReadable(std::size_t bytes) const
+    {
+        if (pos > size() || bytes > size() - pos) {
+            throw std::out_of_range("SerializationBuffer: read past the end of the buffer");
+        }
+    }
+
 private:
     mutable std::size_t pos;
 
+    SemanticVersion format_version_;
+
     static bool initialized_;
     static std::map<std::type_index, std::function<void(SerializationBuffer& buffer, const boost::any& a)>> any_serializer;
     static std::map<uint8_t, std::function<void(const SerializationBuffer& buffer, boost::any& a)>> any_deserializer;
@@ -135,6 +135,11 @@ Command::Ptr CommandFactory::setConnectionActive(int connection, bool active)
     return Command::Ptr(new ModifyConnection(graph_uuid, connection, active));
 }
 
+Command::Ptr CommandFactory::setConnectionBuffer(int connection, int queue_depth, BufferPolicy policy)
+{
+    return Command::Ptr(new ModifyConnection(graph_uuid, connection, queue_depth, policy));
+}
+
 Command::Ptr CommandFactory::clearCommand()
 {
     return std::make_shared<ClearGraph>(graph_uuid);
@@ -19,7 +19,10 @@ CommandDispatcher::CommandDispatcher(CsApexCore& core) : core_(core), dirty_(fal
 
 void CommandDispatcher::reset()
 {
-    later.clear();
+    {
+        std::unique_lock<std::mutex> lock(later_mutex_);
+        later.clear();
+    }
     done.clear();
     undone.clear();
     dirty_ = false;
@@ -42,15 +45,26 @@ void CommandDispatcher::executeLater(const CommandPtr& command)
         return;
     }
     command->init(core_.getRoot().get(), core_);
-    later.push_back(command);
+    {
+        std::unique_lock<std::mutex> lock(later_mutex_);
+        later.push_back(command);
+    }
+
+    commands_pending();
 }
 
 void CommandDispatcher::executeLater()
 {
-    for (Command::Ptr cmd : later) {
+    // commands may defer further commands, those are executed on the next call
+    std::vector<Command::Ptr> pending;
+    {
+        std::unique_lock<std::mutex> lock(later_mutex_);
+        pending.swap(later);
+    }
+
+    for (Command::Ptr cmd : pending) {
         doExecute(cmd);
     }
-    later.clear();
 }
 
 bool CommandDispatcher::doExecute(Command::Ptr command)
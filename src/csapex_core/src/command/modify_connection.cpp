@@ -17,28 +17,89 @@ using namespace csapex::command;
 
 CSAPEX_REGISTER_COMMAND_SERIALIZER(ModifyConnection)
 
-ModifyConnection::ModifyConnection(const AUUID& parent_uuid, int connection_id, bool active) : CommandImplementation(parent_uuid), connection_id(connection_id), active(active)
+namespace
+{
+std::string toString(BufferPolicy policy)
+{
+    switch (policy) {
+        case BufferPolicy::BLOCK:
+            return "BLOCK";
+        case BufferPolicy::DROP_OLDEST:
+            return "DROP_OLDEST";
+        case BufferPolicy::DROP_NEWEST:
+            return "DROP_NEWEST";
+    }
+    return "UNKNOWN";
+}
+}  // namespace
+
+ModifyConnection::ModifyConnection(const AUUID& parent_uuid, int connection_id, bool active)
+  : CommandImplementation(parent_uuid)
+  , connection_id(connection_id)
+  , modify_active(true)
+  , was_active(active)
+  , active(active)
+  , modify_buffer(false)
+  , was_queue_depth(1)
+  , queue_depth(1)
+  , was_policy(BufferPolicy::BLOCK)
+  , policy(BufferPolicy::BLOCK)
+{
+}
+
+ModifyConnection::ModifyConnection(const AUUID& parent_uuid, int connection_id, int queue_depth, BufferPolicy policy)
+  : CommandImplementation(parent_uuid)
+  , connection_id(connection_id)
+  , modify_active(false)
+  , was_active(false)
+  , active(false)
+  , modify_buffer(true)
+  , was_queue_depth(queue_depth)
+  , queue_depth(queue_depth)
+  , was_policy(policy)
+  , policy(policy)
 {
 }
 
 std::string ModifyConnection::getDescription() const
 {
     std::stringstream ss;
-    ss << "modified connection " << connection_id << " -> set active: " << active << " (was " << was_active << ")";
+    ss << "modified connection " << connection_id;
+    if (modify_active) {
+        ss << " -> set active: " << active << " (was " << was_active << ")";
+    }
+    if (modify_buffer) {
+        ss << " -> set queue depth: " << queue_depth << " (was " << was_queue_depth << "), policy: " << toString(policy) << " (was " << toString(was_policy) << ")";
+    }
     return ss.str();
 }
 
 bool ModifyConnection::doExecute()
 {
     auto c = getGraph()->getConnectionWithId(connection_id);
-    was_active = c->isActive();
-    c->setActive(active);
+    if (modify_active) {
+        was_active = c->isActive();
+        c->setActive(active);
+    }
+    if (modify_buffer) {
+        was_queue_depth = c->getQueueDepth();
+        was_policy = c->getBufferPolicy();
+        c->setQueueDepth(queue_depth);
+        c->setBufferPolicy(policy);
+    }
     return true;
 }
 
 bool ModifyConnection::doUndo()
 {
-    getGraph()->getConnectionWithId(connection_id)->setActive(was_active);
+    auto c = getGraph()->getConnectionWithId(connection_id);
+    if (modify_active) {
+        c->setActive(was_active);
+    }
+    if (modify_buffer) {
+        c->setQueueDepth(was_queue_depth);
+        c->setBufferPolicy(was_policy);
+    }
     return true;
 }
 
@@ -52,8 +113,14 @@ void ModifyConnection::serialize(SerializationBuffer& data, SemanticVersion& ver
     Command::serialize(data, version);
 
     data << connection_id;
+    data << modify_active;
     data << active;
     data << was_active;
+    data << modify_buffer;
+    data << queue_depth;
+    data << was_queue_depth;
+    data << policy;
+    data << was_policy;
 }
 
 void ModifyConnection::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
@@ -61,6 +128,12 @@ void ModifyConnection::deserialize(const SerializationBuffer& data, const Semant
     Command::deserialize(data, version);
 
     data >> connection_id;
+    data >> modify_active;
     data >> active;
     data >> was_active;
+    data >> modify_buffer;
+    data >> queue_depth;
+    data >> was_queue_depth;
+    data >> policy;
+    data >> was_policy;
 }
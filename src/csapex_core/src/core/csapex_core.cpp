@@ -13,13 +13,16 @@
 #include <csapex/manager/message_renderer_manager.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/connection.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/model/node_runner.h>
+#include <csapex/model/node_worker.h>
 #include <csapex/model/node_state.h>
 #include <csapex/model/subgraph_node.h>
 #include <csapex/msg/any_message.h>
 #include <csapex/plugin/plugin_locator.h>
 #include <csapex/plugin/plugin_manager.hpp>
+#include <csapex/profiling/chrome_trace_writer.h>
 #include <csapex/profiling/profiler_impl.h>
 #include <csapex/scheduling/thread_pool.h>
 #include <csapex/serialization/snippet.h>
@@ -31,7 +34,11 @@
 #include <csapex/io/server.h>
 
 /// SYSTEM
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iostream>
+#include <set>
 #ifdef WIN32
 #include <direct.h>
 #endif
@@ -48,17 +55,35 @@ CsApexCore::CsApexCore(Settings& settings, ExceptionHandler& handler, csapex::Pl
   , dispatcher_(std::make_shared<CommandDispatcher>(*this))
   , profiler_(std::make_shared<ProfilerImplementation>())
   , core_plugin_manager(nullptr)
+  , running_(false)
+  , commands_pending_(false)
+  , main_loop_wake_ups_(0)
   , init_(false)
   , load_needs_reset_(false)
   , return_code_(0)
 {
     is_root_ = true;
 
+    std::string trace_file = settings_.get<std::string>("trace_file", "");
+    if (!trace_file.empty()) {
+        trace_writer_.reset(new ChromeTraceWriter(trace_file));
+        if (!trace_writer_->isOpen()) {
+            std::cerr << "cannot write the trace to " << trace_file << std::endl;
+            trace_writer_.reset();
+        }
+    }
+
     thread_pool_ =
         std::make_shared<ThreadPool>(exception_handler_, !settings_.get<bool>("threadless", false), settings_.get<bool>("thread_grouping", true), settings_.get<bool>("initially_paused", false));
 
     observe(thread_pool_->paused, paused);
 
+    observe(dispatcher_->commands_pending, [this]() {
+        std::unique_lock<std::mutex> lock(running_mutex_);
+        commands_pending_ = true;
+        running_changed_.notify_all();
+    });
+
     observe(thread_pool_->stepping_enabled, stepping_enabled);
     observe(thread_pool_->begin_step, begin_step);
     observe(thread_pool_->end_step, end_step);
@@ -151,6 +176,9 @@ CsApexCore::~CsApexCore()
 
     joinMainLoop();
 
+    // writes the remaining records and closes the trace
+    trace_writer_.reset();
+
     shutdown_complete();
 }
 
@@ -171,12 +199,106 @@ bool CsApexCore::isSteppingMode() const
     return thread_pool_->isSteppingMode();
 }
 
-void CsApexCore::setSteppingMode(bool stepping)
+namespace
+{
+void collectGraph(const GraphFacadeImplementationPtr& facade, std::vector<NodeFacadeImplementationPtr>& nodes, std::vector<ConnectionPtr>& connections)
 {
-    if (stepping) {
-        drainPipeline();
+    GraphImplementationPtr graph = facade->getLocalGraph();
+    for (const NodeFacadeImplementationPtr& node : graph->getAllLocalNodeFacades()) {
+        nodes.push_back(node);
+        if (node->isGraph()) {
+            if (GraphFacadeImplementationPtr sub_graph = facade->getLocalSubGraph(node->getUUID())) {
+                collectGraph(sub_graph, nodes, connections);
+            }
+        }
     }
-    thread_pool_->setSteppingMode(stepping);
+
+    std::vector<ConnectionPtr> local_connections = graph->getConnections();
+    connections.insert(connections.end(), local_connections.begin(), local_connections.end());
+}
+
+/**
+ * @brief The SourceHold class prevents all sources of a graph from producing new messages while it exists
+ */
+class SourceHold
+{
+public:
+    explicit SourceHold(const GraphFacadeImplementationPtr& root) : root_(root)
+    {
+        std::vector<NodeFacadeImplementationPtr> nodes;
+        std::vector<ConnectionPtr> connections;
+        collectGraph(root_, nodes, connections);
+
+        for (const NodeFacadeImplementationPtr& node : nodes) {
+            if (node->isSource()) {
+                if (NodeWorkerPtr worker = node->getNodeWorker().lock()) {
+                    worker->setHeld(true);
+                    held_.push_back(worker);
+                }
+            }
+        }
+    }
+
+    ~SourceHold()
+    {
+        std::vector<NodeFacadeImplementationPtr> nodes;
+        std::vector<ConnectionPtr> connections;
+        collectGraph(root_, nodes, connections);
+
+        std::set<NodeWorker*> workers;
+        for (const NodeFacadeImplementationPtr& node : nodes) {
+            if (NodeWorkerPtr worker = node->getNodeWorker().lock()) {
+                workers.insert(worker.get());
+            }
+        }
+
+        // workers of nodes that have been removed or re-created in the meantime must not be triggered anymore
+        for (const NodeWorkerWeakPtr& held : held_) {
+            NodeWorkerPtr worker = held.lock();
+            if (worker && workers.find(worker.get()) != workers.end()) {
+                worker->setHeld(false);
+            }
+        }
+    }
+
+    SourceHold(const SourceHold&) = delete;
+    SourceHold& operator=(const SourceHold&) = delete;
+
+private:
+    GraphFacadeImplementationPtr root_;
+    std::vector<NodeWorkerWeakPtr> held_;
+};
+
+/// counts the events after which the pipeline might have become empty
+struct DrainEvents
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t count = 0;
+
+    void notify()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++count;
+        changed.notify_all();
+    }
+};
+}  // namespace
+
+void CsApexCore::setSteppingMode(bool stepping)
+{
+    // draining the pipeline can take a while, so it is not done in the thread of the caller (e.g. the GUI)
+    executeInMainLoop([this, stepping]() {
+        if (stepping) {
+            // the sources are only released once stepping is enabled, so that no new messages are produced in between
+            SourceHold hold(root_);
+            waitUntilDrained(std::chrono::seconds(5));
+            thread_pool_->setSteppingMode(stepping);
+
+        } else {
+            thread_pool_->setSteppingMode(stepping);
+        }
+    });
 }
 
 void CsApexCore::step()
@@ -184,13 +306,89 @@ void CsApexCore::step()
     thread_pool_->step();
 }
 
-void CsApexCore::drainPipeline()
+bool CsApexCore::drainPipeline(std::chrono::milliseconds timeout)
+{
+    SourceHold hold(root_);
+    return waitUntilDrained(timeout);
+}
+
+bool CsApexCore::waitUntilDrained(std::chrono::milliseconds timeout)
+{
+    // the sources are held, so the graph is only collected once
+    std::vector<NodeFacadeImplementationPtr> nodes;
+    std::vector<ConnectionPtr> connections;
+    collectGraph(root_, nodes, connections);
+
+    auto is_drained = [&nodes, &connections]() {
+        for (const NodeFacadeImplementationPtr& node : nodes) {
+            if (node->isProcessing()) {
+                return false;
+            }
+        }
+        for (const ConnectionPtr& connection : connections) {
+            if (connection->getState() != Connection::State::DONE || connection->countQueuedTokens() > 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!thread_pool_->isRunning() || thread_pool_->isPaused()) {
+        // nothing is processed, so nothing can drain
+        return is_drained();
+    }
+
+    // the pipeline is only checked again, once a node has processed or published its messages.
+    // the events are shared with the slots, because a running emission can still call them after disconnecting.
+    std::shared_ptr<DrainEvents> events = std::make_shared<DrainEvents>();
+    std::vector<slim_signal::ScopedConnection> observed;
+    for (const NodeFacadeImplementationPtr& node : nodes) {
+        if (NodeWorkerPtr worker = node->getNodeWorker().lock()) {
+            observed.emplace_back(worker->messages_processed.connect([events]() { events->notify(); }));
+            observed.emplace_back(worker->outgoing_messages_processed.connect([events]() { events->notify(); }));
+        }
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    // a node might be between finishing its process call and publishing its messages, so the pipeline has to be empty twice in a row.
+    // in case that the second check misses the event, the pipeline is checked again after a short while.
+    const auto recheck_interval = std::chrono::milliseconds(50);
+    int empty_checks = 0;
+    while (true) {
+        std::unique_lock<std::mutex> lock(events->mutex);
+        std::size_t seen = events->count;
+        lock.unlock();
+
+        if (is_drained()) {
+            ++empty_checks;
+            if (empty_checks >= 2) {
+                return true;
+            }
+        } else {
+            empty_checks = 0;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now > deadline) {
+            return false;
+        }
+
+        lock.lock();
+        events->changed.wait_until(lock, std::min(deadline, now + recheck_interval), [&events, seen]() { return events->count != seen; });
+    }
+}
+
+void CsApexCore::executeInMainLoop(const std::function<void()>& task)
 {
-    // TODO: implement
-    // forbid all sources to process
-    // for each graph component:
-    //  while at least one edge is unread:
-    //  backtrack all done connections and allow the sources to tick once
+    std::unique_lock<std::mutex> lock(running_mutex_);
+    if (!running_ || std::this_thread::get_id() == main_thread_.get_id()) {
+        lock.unlock();
+        task();
+        return;
+    }
+
+    main_loop_tasks_.push_back(task);
+    running_changed_.notify_all();
 }
 
 void CsApexCore::setStatusMessage(const std::string& msg)
@@ -210,6 +408,8 @@ void CsApexCore::init()
     if (!init_) {
         init_ = true;
 
+        auto start = std::chrono::steady_clock::now();
+
         if (is_root_) {
             status_changed("loading core plugins");
             core_plugin_manager->load(plugin_locator_.get());
@@ -270,6 +470,11 @@ void CsApexCore::init()
                 snippet_factory_->loadSnippets();
                 observe(snippet_factory_->snippet_set_changed, new_snippet_type);
             }
+
+            if (plugin_locator_ && settings_.getTemporary("debug", false)) {
+                plugin_locator_->printLoadReport(std::cout);
+                std::cout << "[Core] initialization took " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() << " ms" << std::endl;
+            }
         }
     }
 }
@@ -334,14 +539,40 @@ void CsApexCore::startMainLoop()
 
         std::unique_lock<std::mutex> lock(running_mutex_);
         running_ = true;
+        lock.unlock();
 
         root_->getSubgraphNode()->activation();
         thread_pool_->start();
 
+        lock.lock();
         while (running_) {
-            getCommandDispatcher()->executeLater();
+            if (!main_loop_tasks_.empty()) {
+                std::vector<std::function<void()>> tasks;
+                tasks.swap(main_loop_tasks_);
+
+                lock.unlock();
+                for (const std::function<void()>& task : tasks) {
+                    try {
+                        task();
+                    } catch (const std::exception& e) {
+                        sendNotification(e.what());
+                    }
+                }
+                lock.lock();
+                continue;
+            }
+            if (commands_pending_) {
+                commands_pending_ = false;
+
+                // deferred commands can defer further commands, so the lock must not be held
+                lock.unlock();
+                getCommandDispatcher()->executeLater();
+                lock.lock();
+                continue;
+            }
 
-            running_changed_.wait_for(lock, std::chrono::milliseconds(10));
+            running_changed_.wait(lock);
+            ++main_loop_wake_ups_;
         }
 
         shutdown_requested();
@@ -360,6 +591,11 @@ void CsApexCore::joinMainLoop()
     }
 }
 
+std::size_t CsApexCore::getMainLoopWakeUps() const
+{
+    return main_loop_wake_ups_;
+}
+
 bool CsApexCore::isServerActive() const
 {
     return server_ != nullptr && server_->isRunning();
@@ -589,6 +825,44 @@ void CsApexCore::load(const std::string& file)
     }
 }
 
+void CsApexCore::reload(const std::string& file)
+{
+    // draining the pipeline can take a while, so it is not done in the thread of the caller (e.g. the GUI)
+    executeInMainLoop([this, file]() {
+        if (root_->getLocalGraph()->countNodes() == 0 || !bf3::exists(file)) {
+            load(file);
+            return;
+        }
+
+        YAML::Node node_map = YAML::LoadFile(file.c_str());
+
+        // let everything in flight pass through the old graph first
+        SourceHold hold(root_);
+        if (!waitUntilDrained(std::chrono::seconds(5))) {
+            sendNotification("reload: the pipeline could not be drained, messages in flight might be lost", ErrorState::ErrorLevel::WARNING);
+        }
+
+        settings_.loadTemporary(node_map);
+        settings_.set("config", file);
+
+        GraphIO graphio(*root_, node_factory_.get());
+        slim_signal::ScopedConnection connection = graphio.loadViewRequest.connect(load_detail_request);
+        graphio.useProfiler(profiler_);
+
+        graphio.loadSettings(node_map);
+        GraphIO::ReloadStatistics statistics = graphio.reloadGraphFrom(node_map);
+
+        thread_pool_->loadSettings(node_map);
+
+        if (settings_.getTemporary("debug", false)) {
+            std::cout << "[Core] reloaded " << file << ": " << statistics.nodes_kept << " nodes kept, " << statistics.nodes_created << " created, " << statistics.nodes_removed << " removed, "
+                      << statistics.connections_created << " connections created, " << statistics.connections_removed << " removed" << std::endl;
+        }
+
+        loaded();
+    });
+}
+
 int CsApexCore::getReturnCode() const
 {
     return return_code_;
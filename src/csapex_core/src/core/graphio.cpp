@@ -12,6 +12,7 @@
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/subgraph_node.h>
 #include <csapex/model/connection_description.h>
+#include <csapex/model/connection.h>
 #include <csapex/model/generic_state.h>
 #include <csapex/msg/input.h>
 #include <csapex/msg/output.h>
@@ -32,6 +33,9 @@
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <yaml-cpp/yaml.h>
 #include <sys/types.h>
 
@@ -44,6 +48,134 @@ using namespace csapex;
         sendNotification(ss.str());                                                                                                                                                                    \
     }
 
+namespace
+{
+SemanticVersion readVersion(const YAML::Node& doc)
+{
+    if (doc["version"].IsDefined()) {
+        return doc["version"].as<SemanticVersion>();
+    } else {
+        // with 0.9.7 versioning was introduced, so assume that the version was 0.9.6
+        return SemanticVersion(0, 9, 6);
+    }
+}
+
+std::string dump(const YAML::Node& node)
+{
+    YAML::Emitter emitter;
+    emitter << node;
+    return emitter.c_str();
+}
+
+/// the keys of a node that only change how it is displayed, the node does not have to be re-created for them
+const char* const VIEW_KEYS[] = { "label", "pos", "color", "z", "minimized", "flipped" };
+
+std::string dumpWithoutView(const YAML::Node& node)
+{
+    YAML::Node copy = YAML::Clone(node);
+    for (const char* key : VIEW_KEYS) {
+        copy.remove(key);
+    }
+    return dump(copy);
+}
+
+YAML::Node extractView(const YAML::Node& node)
+{
+    YAML::Node view(YAML::NodeType::Map);
+    for (const char* key : VIEW_KEYS) {
+        if (node[key].IsDefined()) {
+            view[key] = node[key];
+        }
+    }
+    return view;
+}
+
+/// the names of the buffer policies in the order of their values
+const char* const BUFFER_POLICY_NAMES[] = { "block", "drop_oldest", "drop_newest" };
+
+YAML::Node writeBuffer(int depth, BufferPolicy policy)
+{
+    YAML::Node buffer(YAML::NodeType::Map);
+    buffer["depth"] = depth;
+    buffer["policy"] = BUFFER_POLICY_NAMES[static_cast<int>(policy)];
+    return buffer;
+}
+
+/// reads the buffer settings of a connection, invalid settings are reported as a std::runtime_error
+void readBuffer(const YAML::Node& buffer, int& depth, BufferPolicy& policy)
+{
+    depth = buffer["depth"].as<int>();
+    if (depth < 1) {
+        throw std::runtime_error(std::string("the queue depth has to be at least 1, but is ") + std::to_string(depth));
+    }
+
+    std::string name = buffer["policy"].as<std::string>();
+    for (std::size_t i = 0; i < sizeof(BUFFER_POLICY_NAMES) / sizeof(BUFFER_POLICY_NAMES[0]); ++i) {
+        if (name == BUFFER_POLICY_NAMES[i]) {
+            policy = static_cast<BufferPolicy>(i);
+            return;
+        }
+    }
+    throw std::runtime_error(std::string("unknown buffer policy '") + name + "'");
+}
+
+struct ConnectionEntry
+{
+    std::string from;
+    std::string to;
+    std::string type;
+    int depth;
+    BufferPolicy policy;
+    std::string buffer_error;
+};
+
+/// flattens the connections of a document, the key identifies a connection including all of its settings
+std::map<std::string, ConnectionEntry> indexConnections(const YAML::Node& doc)
+{
+    std::map<std::string, ConnectionEntry> result;
+
+    const YAML::Node& connections = doc["connections"];
+    if (!connections.IsDefined() || connections.Type() != YAML::NodeType::Sequence) {
+        return result;
+    }
+
+    for (const YAML::Node& connection : connections) {
+        const YAML::Node& targets = connection["targets"];
+        const YAML::Node& types = connection["types"];
+        const YAML::Node& buffers = connection["buffers"];
+
+        for (std::size_t j = 0; j < targets.size(); ++j) {
+            ConnectionEntry entry;
+            entry.from = connection["uuid"].as<std::string>();
+            entry.to = targets[j].as<std::string>();
+            entry.type = types.IsDefined() ? types[j].as<std::string>() : "default";
+            entry.depth = 1;
+            entry.policy = BufferPolicy::BLOCK;
+            if (buffers.IsDefined()) {
+                try {
+                    readBuffer(buffers[j], entry.depth, entry.policy);
+                } catch (const std::exception& e) {
+                    // the connection keeps the default buffer, the error is reported when it is created
+                    entry.depth = 1;
+                    entry.policy = BufferPolicy::BLOCK;
+                    entry.buffer_error = e.what();
+                }
+            }
+
+            std::stringstream key;
+            key << entry.from << " -> " << entry.to << " " << entry.type << " " << entry.depth << " " << static_cast<int>(entry.policy);
+            result[key.str()] = entry;
+        }
+    }
+
+    return result;
+}
+}  // namespace
+
+GraphIO::ReloadStatistics::ReloadStatistics() : nodes_kept(0), nodes_created(0), nodes_removed(0), connections_created(0), connections_removed(0)
+{
+}
+
 GraphIO::GraphIO(GraphFacadeImplementation& graph, NodeFactoryImplementation* node_factory, bool throw_on_error)
   : graph_(graph), node_factory_(node_factory), position_offset_x_(0.0), position_offset_y_(0.0), ignore_forwarding_connections_(false), throw_on_error_(throw_on_error)
 {
@@ -106,13 +238,7 @@ void GraphIO::loadGraphFrom(const YAML::Node& doc)
     TimerPtr timer = getProfiler()->getTimer("load graph");
     timer->restart();
 
-    SemanticVersion version;
-    if(doc["version"].IsDefined()) {
-        version = doc["version"].as<SemanticVersion>();
-    } else {
-        // with 0.9.7 versioning was introduced, so assume that the version was 0.9.6
-        version = SemanticVersion(0, 9, 6);
-    }
+    SemanticVersion version = readVersion(doc);
 
     graph_.getLocalGraph()->beginTransaction();
     {
@@ -134,6 +260,167 @@ void GraphIO::loadGraphFrom(const YAML::Node& doc)
     timer->finish();
 }
 
+GraphIO::ReloadStatistics GraphIO::reloadGraphFrom(const YAML::Node& doc)
+{
+    TimerPtr timer = getProfiler()->getTimer("reload graph");
+    timer->restart();
+
+    SemanticVersion version = readVersion(doc);
+
+    // the graph might have been edited since it was loaded, so the new document is compared to the live graph
+    YAML::Node previous;
+    {
+        auto interlude = timer->step("save current graph");
+        saveNodes(previous);
+        saveConnections(previous);
+    }
+
+    GraphImplementationPtr graph = graph_.getLocalGraph();
+    std::weak_ptr<UUIDProvider> provider = graph->shared_from_this();
+
+    auto index_nodes = [this, &provider](const YAML::Node& d) {
+        std::map<std::string, YAML::Node> nodes;
+        if (d["nodes"].IsDefined()) {
+            for (const YAML::Node& n : d["nodes"]) {
+                nodes[readNodeUUID(provider, n["uuid"]).getFullName()] = n;
+            }
+        }
+        return nodes;
+    };
+    std::map<std::string, YAML::Node> old_nodes = index_nodes(previous);
+    std::map<std::string, YAML::Node> new_nodes = index_nodes(doc);
+
+    // changed nodes are removed and created again, nodes whose view has changed are updated in place
+    std::set<std::string> removed_nodes;
+    std::set<std::string> created_nodes;
+    std::set<std::string> moved_nodes;
+    for (const auto& pair : old_nodes) {
+        auto pos = new_nodes.find(pair.first);
+        if (pos == new_nodes.end()) {
+            removed_nodes.insert(pair.first);
+        } else if (dump(pair.second) != dump(pos->second)) {
+            if (dumpWithoutView(pair.second) != dumpWithoutView(pos->second)) {
+                removed_nodes.insert(pair.first);
+                created_nodes.insert(pair.first);
+            } else {
+                moved_nodes.insert(pair.first);
+            }
+        }
+    }
+    for (const auto& pair : new_nodes) {
+        if (old_nodes.find(pair.first) == old_nodes.end()) {
+            created_nodes.insert(pair.first);
+        }
+    }
+
+    std::map<std::string, ConnectionEntry> old_connections = indexConnections(previous);
+    std::map<std::string, ConnectionEntry> new_connections = indexConnections(doc);
+
+    ReloadStatistics statistics;
+
+    graph->beginTransaction();
+
+    {
+        auto interlude = timer->step("remove connections");
+        for (const auto& pair : old_connections) {
+            if (new_connections.find(pair.first) == new_connections.end()) {
+                UUID from_uuid = readConnectorUUID(provider, YAML::Node(pair.second.from));
+                UUID to_uuid = readConnectorUUID(provider, YAML::Node(pair.second.to));
+                if (ConnectionPtr connection = graph->getConnection(from_uuid, to_uuid)) {
+                    graph->deleteConnection(connection);
+                    ++statistics.connections_removed;
+                }
+            }
+        }
+    }
+
+    {
+        auto interlude = timer->step("update views");
+        for (const std::string& id : moved_nodes) {
+            UUID uuid = readNodeUUID(provider, YAML::Node(id));
+            if (NodeHandle* nh = graph->findNodeHandleNoThrow(uuid)) {
+                nh->getNodeState()->readYaml(extractView(new_nodes.at(id)));
+            }
+        }
+    }
+
+    {
+        auto interlude = timer->step("remove nodes");
+        for (const std::string& id : removed_nodes) {
+            UUID uuid = readNodeUUID(provider, YAML::Node(id));
+
+            for (const ConnectionPtr& connection : graph->getConnections()) {
+                if (connection->isDetached()) {
+                    continue;
+                }
+                if (connection->from()->getUUID().parentUUID() == uuid || connection->to()->getUUID().parentUUID() == uuid) {
+                    graph->deleteConnection(connection);
+                    ++statistics.connections_removed;
+                }
+            }
+
+            graph->deleteNode(uuid);
+            ++statistics.nodes_removed;
+        }
+    }
+
+    {
+        auto interlude = timer->step("create nodes");
+        for (const std::string& id : created_nodes) {
+            loadNode(new_nodes.at(id), version);
+            ++statistics.nodes_created;
+        }
+    }
+
+    {
+        auto interlude = timer->step("create connections");
+        for (const auto& pair : new_connections) {
+            const ConnectionEntry& entry = pair.second;
+
+            UUID from_uuid = readConnectorUUID(provider, YAML::Node(entry.from));
+            UUID to_uuid = readConnectorUUID(provider, YAML::Node(entry.to));
+
+            // unchanged connections between kept nodes are still there
+            bool is_new = old_connections.find(pair.first) == old_connections.end();
+            bool touches_created_node = created_nodes.count(from_uuid.parentUUID().getFullName()) > 0 || created_nodes.count(to_uuid.parentUUID().getFullName()) > 0;
+            if (!is_new && !touches_created_node) {
+                continue;
+            }
+            if (graph->getConnection(from_uuid, to_uuid)) {
+                continue;
+            }
+
+            ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
+            if (!from) {
+                sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
+                continue;
+            }
+
+            try {
+                ConnectionPtr connection = loadConnection(from, to_uuid, entry.type, version);
+                if (connection) {
+                    connection->setQueueDepth(entry.depth);
+                    connection->setBufferPolicy(entry.policy);
+                    ++statistics.connections_created;
+                }
+                if (!entry.buffer_error.empty()) {
+                    sendNotificationStreamGraphio("cannot load the buffer of the connection from '" << from_uuid << "' to '" << to_uuid << "': " << entry.buffer_error);
+                }
+            } catch (const std::exception& e) {
+                sendNotificationStreamGraphio("cannot load connection: " << e.what());
+            }
+        }
+    }
+
+    graph->finalizeTransaction();
+
+    statistics.nodes_kept = new_nodes.size() - created_nodes.size();
+
+    timer->finish();
+
+    return statistics;
+}
+
 Snippet GraphIO::saveSelectedGraph(const std::vector<UUID>& uuids)
 {
     YAML::Node yaml = YAML::Node(YAML::NodeType::Map);
@@ -321,7 +608,7 @@ void GraphIO::saveConnections(YAML::Node& yaml)
 
 void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDescription>& connections)
 {
-    std::unordered_map<UUID, std::vector<std::pair<UUID, std::string>>, UUID::Hasher> connection_map;
+    std::unordered_map<UUID, std::vector<const ConnectionDescription*>, UUID::Hasher> connection_map;
 
     for (const ConnectionDescription& connection : connections) {
         if (ignore_forwarding_connections_) {
@@ -330,9 +617,7 @@ void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDesc
             }
         }
 
-        std::string type = connection.active ? "active" : "default";
-
-        connection_map[connection.from].push_back(std::make_pair(connection.to, type));
+        connection_map[connection.from].push_back(&connection);
 
         if (!connection.fulcrums.empty()) {
             YAML::Node fulcrum;
@@ -345,9 +630,16 @@ void GraphIO::saveConnections(YAML::Node& yaml, const std::vector<ConnectionDesc
     for (const auto& pair : connection_map) {
         YAML::Node entry(YAML::NodeType::Map);
         entry["uuid"] = pair.first.getFullName();
-        for (const auto& info : pair.second) {
-            entry["targets"].push_back(info.first.getFullName());
-            entry["types"].push_back(info.second);
+        bool buffered = false;
+        for (const ConnectionDescription* info : pair.second) {
+            entry["targets"].push_back(info->to.getFullName());
+            entry["types"].push_back(info->active ? "active" : "default");
+            buffered |= info->queue_depth != 1 || info->buffer_policy != BufferPolicy::BLOCK;
+        }
+        if (buffered) {
+            for (const ConnectionDescription* info : pair.second) {
+                entry["buffers"].push_back(writeBuffer(info->queue_depth, info->buffer_policy));
+            }
         }
         yaml["connections"].push_back(entry);
     }
@@ -398,6 +690,14 @@ void GraphIO::loadConnection(const YAML::Node& connection, SemanticVersion versi
     const YAML::Node& types = connection["types"];
     apex_assert_hard(!types.IsDefined() || (types.Type() == YAML::NodeType::Sequence && targets.size() == types.size()));
 
+    const YAML::Node& buffers = connection["buffers"];
+    bool has_buffers = buffers.IsDefined();
+    if (has_buffers && (buffers.Type() != YAML::NodeType::Sequence || targets.size() != buffers.size())) {
+        // the connections are still loaded, with the default buffer
+        has_buffers = false;
+        sendNotificationStreamGraphio("cannot load the buffers of the connections from '" << from_uuid << "', there has to be one per target.");
+    }
+
     for (unsigned j = 0; j < targets.size(); ++j) {
         UUID to_uuid = readConnectorUUID(graph_.getLocalGraph()->shared_from_this(), targets[j]);
 
@@ -410,7 +710,19 @@ void GraphIO::loadConnection(const YAML::Node& connection, SemanticVersion versi
 
         ConnectorPtr from = graph_.findConnectorNoThrow(from_uuid);
         if (from) {
-            loadConnection(from, to_uuid, connection_type, version);
+            ConnectionPtr c = loadConnection(from, to_uuid, connection_type, version);
+            if (c && has_buffers) {
+                int depth;
+                BufferPolicy policy;
+                try {
+                    readBuffer(buffers[j], depth, policy);
+                } catch (const std::exception& e) {
+                    sendNotificationStreamGraphio("cannot load the buffer of the connection from '" << from_uuid << "' to '" << to_uuid << "': " << e.what());
+                    continue;
+                }
+                c->setQueueDepth(depth);
+                c->setBufferPolicy(policy);
+            }
         } else {
             sendNotificationStreamGraphio("cannot load connection from '" << from_uuid << "' to '" << to_uuid << "', '" << from_uuid << "' doesn't exist.");
         }
@@ -503,7 +815,7 @@ void GraphIO::loadFulcrum(const YAML::Node& fulcrum, SemanticVersion version)
     }
 }
 
-void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, SemanticVersion version)
+ConnectionPtr GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::string& connection_type, SemanticVersion version)
 {
     try {
         NodeHandle* target = graph_.getLocalGraph()->findNodeHandleForConnector(to_uuid);
@@ -511,7 +823,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
         InputPtr in = std::dynamic_pointer_cast<Input>(target->getConnector(to_uuid));
         if (!in) {
             sendNotificationStreamGraphio("cannot load message connection from " << from->getUUID() << " to " << to_uuid << ", input doesn't exist.");
-            return;
+            return nullptr;
         }
 
         OutputPtr out = std::dynamic_pointer_cast<Output>(from);
@@ -523,6 +835,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
                 c->setActive(true);
             }
             graph_.getLocalGraph()->addConnection(c);
+            return c;
         }
 
     } catch (const std::exception& e) {
@@ -530,6 +843,7 @@ void GraphIO::loadConnection(ConnectorPtr from, const UUID& to_uuid, const std::
     } catch (const Failure& e) {
         sendNotificationStreamGraphio("failure loading connection: " << e.what());
     }
+    return nullptr;
 }
 
 void GraphIO::serializeNode(YAML::Node& doc, NodeFacadeImplementationConstPtr node_facade)
@@ -47,7 +47,9 @@ NodeFactoryImplementation::NodeFactoryImplementation(Settings& settings, PluginL
     note->setDescription("A sticky note to keep information.");
     registerNodeType(note, true);
 
-    node_manager_->manifest_loaded.connect(manifest_loaded);
+    // relaying the manifests on demand allows the plugin manager to skip reading the documents
+    manifest_loaded.first_connected.connect([this]() { manifest_relay_ = node_manager_->manifest_loaded.connect(manifest_loaded); });
+    manifest_loaded.last_disconnected.connect([this]() { manifest_relay_.disconnect(); });
 }
 
 void NodeFactoryImplementation::setPluginLocator(PluginLocator* locator)
@@ -15,6 +15,7 @@
 #include <csapex/utility/debug.h>
 #include <csapex/model/node_handle.h>
 #include <csapex/model/node_state.h>
+#include <csapex/profiling/trace_buffer.h>
 
 /// SYSTEM
 #include <cmath>
@@ -24,11 +25,23 @@ using namespace csapex;
 
 int Connection::next_connection_id_ = 0;
 
+namespace
+{
+/// hand-offs are recorded as flow events keyed by connection and token sequence number
+void traceHandOff(TraceType type, int connection_id, const TokenPtr& token)
+{
+    static const uint32_t name = TraceBuffer::intern("token hand-off");
+    uint64_t now = TraceBuffer::now();
+    uint64_t id = (static_cast<uint64_t>(static_cast<uint32_t>(connection_id)) << 32) | static_cast<uint32_t>(token->getSequenceNumber());
+    TraceBuffer::record(type, name, now, now, id);
+}
+}  // namespace
+
 Connection::Connection(OutputPtr from, InputPtr to) : Connection(from, to, next_connection_id_++)
 {
 }
 
-Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(to), id_(id), active_(false), detached_(false), state_(State::NOT_INITIALIZED)
+Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(to), id_(id), active_(false), detached_(false), state_(State::NOT_INITIALIZED), queue_depth_(1), buffer_policy_(BufferPolicy::BLOCK), dropped_(0)
 {
     from->enabled_changed.connect(source_enable_changed);
     to->enabled_changed.connect(sink_enabled_changed);
@@ -43,7 +56,7 @@ Connection::Connection(OutputPtr from, InputPtr to, int id) : from_(from), to_(t
 Connection::~Connection()
 {
     if (from_) {
-        if (state_ != Connection::State::DONE) {
+        if (getState() != Connection::State::DONE) {
             notifyMessageProcessed();
         }
     }
@@ -115,8 +128,9 @@ bool Connection::isDetached() const
 void Connection::reset()
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
-    state_ = Connection::State::NOT_INITIALIZED;
+    state_.store(Connection::State::NOT_INITIALIZED, std::memory_order_release);
     message_.reset();
+    queue_.clear();
 }
 
 TokenPtr Connection::getToken() const
@@ -127,9 +141,17 @@ TokenPtr Connection::getToken() const
 
 TokenPtr Connection::readToken()
 {
-    std::unique_lock<std::recursive_mutex> lock(sync);
-    setState(State::READ);
-    return message_;
+    TokenPtr token;
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        setState(State::READ);
+        token = message_;
+    }
+
+    if (token) {
+        traceHandOff(TraceType::FLOW_END, id_, token);
+    }
+    return token;
 }
 
 bool Connection::holdsToken() const
@@ -145,6 +167,7 @@ bool Connection::holdsActiveToken() const
 
 void Connection::setTokenProcessed()
 {
+    bool next_token_available = false;
     {
         std::unique_lock<std::recursive_mutex> lock(sync);
         if (getState() == State::DONE) {
@@ -152,36 +175,177 @@ void Connection::setTokenProcessed()
             return;
         }
         setState(State::DONE);
+
+        if (!queue_.empty()) {
+            // the next buffered token moves up, the consumer has to be told about it
+            message_ = queue_.front();
+            queue_.pop_front();
+            setState(State::UNREAD);
+            next_token_available = true;
+        }
     }
 
     // std::cerr << *this << " is done" << std::endl;
     notifyMessageProcessed();
+
+    if (next_token_available) {
+        notifyMessageSet();
+    }
 }
 
 void Connection::setToken(const TokenPtr& token, const bool silent)
 {
+    bool is_head = false;
     {
         TokenPtr msg = token->cloneAs<Token>();
+        apex_assert_hard(msg != nullptr);
+
+        traceHandOff(TraceType::FLOW_BEGIN, id_, msg);
 
         std::unique_lock<std::recursive_mutex> lock(sync);
-        apex_assert_hard(msg != nullptr);
-        apex_assert_hard(state_ == State::NOT_INITIALIZED);
 
         if (!isActive() && msg->hasActivityModifier()) {
             // remove active flag if the connection is inactive
             msg->setActivityModifier(ActivityModifier::NONE);
         }
 
-        message_ = msg;
         ++seq_;
-        setState(State::UNREAD);
+
+        if (getState() == State::NOT_INITIALIZED) {
+            apex_assert_hard(queue_.empty());
+            message_ = msg;
+            setState(State::UNREAD);
+            is_head = true;
+
+        } else {
+            enqueueToken(msg);
+        }
     }
 
-    if(!silent) {
+    if (is_head && !silent) {
         notifyMessageSet();
     }
 }
 
+void Connection::enqueueToken(const TokenPtr& token)
+{
+    // the head of the connection is occupied, everything behind it waits in the queue
+    std::size_t capacity = queue_depth_ - 1;
+    if (queue_.size() < capacity) {
+        queue_.push_back(token);
+        return;
+    }
+
+    switch (buffer_policy_.load()) {
+        case BufferPolicy::BLOCK:
+            apex_fail("a token was sent to a full connection");
+            break;
+
+        case BufferPolicy::DROP_NEWEST:
+            ++dropped_;
+            break;
+
+        case BufferPolicy::DROP_OLDEST:
+            if (getState() == State::UNREAD) {
+                // the consumer has not started on the head yet, so the head is the oldest token
+                queue_.push_back(token);
+                message_ = queue_.front();
+                queue_.pop_front();
+                ++dropped_;
+
+            } else if (!queue_.empty()) {
+                queue_.pop_front();
+                queue_.push_back(token);
+                ++dropped_;
+
+            } else {
+                // the head is being processed, keep the newest token right behind it
+                queue_.push_back(token);
+            }
+            break;
+    }
+}
+
+void Connection::setQueueDepth(int depth)
+{
+    apex_assert_hard(depth >= 1);
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (queue_depth_ == depth) {
+            return;
+        }
+        queue_depth_ = depth;
+    }
+    bufferChanged();
+}
+
+int Connection::getQueueDepth() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return queue_depth_;
+}
+
+void Connection::setBufferPolicy(BufferPolicy policy)
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (buffer_policy_ == policy) {
+            return;
+        }
+        buffer_policy_ = policy;
+    }
+    bufferChanged();
+}
+
+BufferPolicy Connection::getBufferPolicy() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return buffer_policy_;
+}
+
+bool Connection::canReceiveToken() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return canReceiveTokenUnlocked();
+}
+
+bool Connection::canReceiveTokenUnlocked() const
+{
+    if (buffer_policy_ != BufferPolicy::BLOCK) {
+        return true;
+    }
+    std::size_t held = queue_.size() + (getState() == State::NOT_INITIALIZED ? 0 : 1);
+    return held < static_cast<std::size_t>(queue_depth_);
+}
+
+std::size_t Connection::countQueuedTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return queue_.size();
+}
+
+std::size_t Connection::countDroppedTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return dropped_;
+}
+
+void Connection::bufferChanged()
+{
+    bool unblocked = false;
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        unblocked = getState() != State::NOT_INITIALIZED && canReceiveTokenUnlocked();
+    }
+
+    // a producer waiting for this connection might be able to continue now
+    if (unblocked) {
+        notifyMessageProcessed();
+    }
+
+    connection_changed();
+}
+
 int Connection::getSeq() const
 {
     return seq_;
@@ -243,25 +407,24 @@ bool Connection::isPipelining() const
 
 Connection::State Connection::getState() const
 {
-    std::unique_lock<std::recursive_mutex> lock(sync);
-    return state_;
+    return state_.load(std::memory_order_acquire);
 }
 
 void Connection::setState(State s)
 {
-    std::unique_lock<std::recursive_mutex> lock(sync);
+    State previous = state_.exchange(s, std::memory_order_acq_rel);
 
     switch (s) {
         case State::UNREAD:
-            apex_assert_hard(state_ == State::NOT_INITIALIZED);
+            apex_assert_hard(previous == State::NOT_INITIALIZED);
             //            apex_assert_hard(message_ != nullptr);
             break;
         case State::READ:
-            apex_assert_hard(state_ == State::UNREAD || state_ == State::READ);
+            apex_assert_hard(previous == State::UNREAD || previous == State::READ);
             //            apex_assert_hard(message_ != nullptr);
             break;
         case State::DONE:
-            apex_assert_hard(state_ == State::DONE || state_ == State::READ);
+            apex_assert_hard(previous == State::DONE || previous == State::READ);
             //            apex_assert_hard(message_ != nullptr);
             break;
         default:
@@ -281,8 +444,6 @@ void Connection::setState(State s)
     //         break;
     // }
     // std::cerr << *this << "-> set state to " << str << std::endl;
-
-    state_ = s;
 }
 
 OutputPtr Connection::from() const
@@ -311,8 +472,12 @@ int Connection::id() const
 
 ConnectionDescription Connection::getDescription() const
 {
-    TokenDataConstPtr type = message_ ? message_->getTokenData() : makeEmpty<connection_types::AnyMessage>();
-    return ConnectionDescription(from_->getUUID(), to_->getUUID(), type, id_, seq_, isActive(), getFulcrumsCopy());
+    TokenPtr message = getToken();
+    TokenDataConstPtr type = message ? message->getTokenData() : makeEmpty<connection_types::AnyMessage>();
+    ConnectionDescription description(from_->getUUID(), to_->getUUID(), type, id_, seq_, isActive(), getFulcrumsCopy());
+    description.queue_depth = getQueueDepth();
+    description.buffer_policy = getBufferPolicy();
+    return description;
 }
 
 bool Connection::contains(Connector* c) const
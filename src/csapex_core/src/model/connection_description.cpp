@@ -9,17 +9,23 @@
 
 using namespace csapex;
 
+namespace
+{
+// the buffer settings are part of the description from this version on
+constexpr SemanticVersion BUFFER_VERSION{ 0, 1, 0 };
+}  // namespace
+
 ConnectionDescription::ConnectionDescription(const UUID& from, const UUID& to, const TokenDataConstPtr& type, int id, int seq, bool active, const std::vector<Fulcrum>& fulcrums)
-  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), seq(seq), active(active), fulcrums(fulcrums)
+  : from(from), to(to), from_label(""), to_label(""), type(type), id(id), seq(seq), active(active), queue_depth(1), buffer_policy(BufferPolicy::BLOCK), fulcrums(fulcrums)
 {
 }
 
 ConnectionDescription::ConnectionDescription(const ConnectionDescription& other)
-  : from(other.from), to(other.to), from_label(other.from_label), to_label(other.to_label), type(other.type), id(other.id), active(other.active), fulcrums(other.fulcrums), seq(other.seq)
+  : from(other.from), to(other.to), from_label(other.from_label), to_label(other.to_label), type(other.type), id(other.id), active(other.active), queue_depth(other.queue_depth), buffer_policy(other.buffer_policy), fulcrums(other.fulcrums), seq(other.seq)
 {
 }
 
-ConnectionDescription::ConnectionDescription()
+ConnectionDescription::ConnectionDescription() : queue_depth(1), buffer_policy(BufferPolicy::BLOCK)
 {
 }
 
@@ -32,6 +38,8 @@ ConnectionDescription& ConnectionDescription::operator=(const ConnectionDescript
     type = other.type;
     id = other.id;
     active = other.active;
+    queue_depth = other.queue_depth;
+    buffer_policy = other.buffer_policy;
     fulcrums = other.fulcrums;
     seq = other.seq;
 
@@ -54,6 +62,10 @@ void ConnectionDescription::serialize(SerializationBuffer& data, SemanticVersion
     data << active;
     data << fulcrums;
     data << seq;
+    if (version >= BUFFER_VERSION) {
+        data << queue_depth;
+        data << buffer_policy;
+    }
 }
 void ConnectionDescription::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
 {
@@ -66,4 +78,13 @@ void ConnectionDescription::deserialize(const SerializationBuffer& data, const S
     data >> active;
     data >> fulcrums;
     data >> seq;
+    if (SemanticVersion(version) >= BUFFER_VERSION) {
+        data >> queue_depth;
+        data >> buffer_policy;
+    }
+}
+
+SemanticVersion ConnectionDescription::getVersion() const
+{
+    return BUFFER_VERSION;
 }
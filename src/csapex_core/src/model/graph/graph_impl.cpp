@@ -87,6 +87,7 @@ void GraphImplementation::addNode(NodeFacadeImplementationPtr nf)
     apex_assert_hard_msg(nf, "NodeFacade added is not null");
     graph::VertexPtr vertex = std::make_shared<graph::Vertex>(nf);
     vertices_.push_back(vertex);
+    vertex_index_[nf->getUUID()] = vertex;
 
     nf->getNodeHandle()->setVertex(vertex);
 
@@ -121,17 +122,11 @@ void GraphImplementation::deleteNode(const UUID& uuid)
 
     graph::VertexPtr removed;
 
-    for (auto it = vertices_.begin(); it != vertices_.end();) {
-        NodeFacadePtr node = (*it)->getNodeFacade();
-        if (node->getUUID() == uuid) {
-            removed = *it;
-            vertices_.erase(it);
-
-            break;
-
-        } else {
-            ++it;
-        }
+    auto pos = vertex_index_.find(uuid);
+    if (pos != vertex_index_.end()) {
+        removed = pos->second;
+        vertex_index_.erase(pos);
+        vertices_.erase(std::find(vertices_.begin(), vertices_.end(), removed));
     }
 
     apex_assert_hard(removed);
@@ -171,6 +166,7 @@ bool GraphImplementation::addConnection(ConnectionPtr connection)
 {
     apex_assert_hard(connection);
     edges_.push_back(connection);
+    indexConnection(connection);
 
     connection_observations_[connection.get()].push_back(connection->connection_changed.connect([this]() {
         if (!in_transaction_) {
@@ -216,6 +212,7 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
     if (connection->isDetached()) {
         auto c = std::find(edges_.begin(), edges_.end(), connection);
         if (c != edges_.end()) {
+            unindexConnection(*c);
             edges_.erase(c);
         }
         return;
@@ -262,26 +259,23 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
 
                         if (!n_from->getOutputTransition()->hasConnection()) {
                             // verify that v_from is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_from) {
-                                    sinks_.insert(v_from);
-                                    break;
-                                }
+                            auto pos = vertex_index_.find(v_from->getUUID());
+                            if (pos != vertex_index_.end() && pos->second == v_from) {
+                                sinks_.insert(v_from);
                             }
                         }
                         if (!n_to->getInputTransition()->hasConnection()) {
                             // verify that v_to is from this graph
-                            for (const graph::VertexPtr& vertex : vertices_) {
-                                if (vertex == v_to) {
-                                    sources_.insert(v_to);
-                                    break;
-                                }
+                            auto pos = vertex_index_.find(v_to->getUUID());
+                            if (pos != vertex_index_.end() && pos->second == v_to) {
+                                sources_.insert(v_to);
                             }
                         }
                     }
                 }
             }
 
+            unindexConnection(*c);
             edges_.erase(c);
 
             if (connection_removed.isConnected()) {
@@ -304,6 +298,39 @@ void GraphImplementation::deleteConnection(ConnectionPtr connection)
     throw std::runtime_error("cannot delete connection");
 }
 
+void GraphImplementation::indexConnection(const ConnectionPtr& connection)
+{
+    connection_id_index_.emplace(connection->id(), connection);
+    if (ConnectablePtr from = connection->from()) {
+        connection_source_index_.emplace(from->getUUID(), connection);
+    }
+}
+
+void GraphImplementation::unindexConnection(const ConnectionPtr& connection)
+{
+    auto id_pos = connection_id_index_.find(connection->id());
+    if (id_pos != connection_id_index_.end() && id_pos->second == connection) {
+        connection_id_index_.erase(id_pos);
+    }
+
+    auto remove_from = [this, &connection](std::unordered_multimap<UUID, ConnectionPtr, UUID::Hasher>::iterator begin, std::unordered_multimap<UUID, ConnectionPtr, UUID::Hasher>::iterator end) {
+        for (auto it = begin; it != end; ++it) {
+            if (it->second == connection) {
+                connection_source_index_.erase(it);
+                return;
+            }
+        }
+    };
+
+    if (ConnectablePtr from = connection->from()) {
+        auto range = connection_source_index_.equal_range(from->getUUID());
+        remove_from(range.first, range.second);
+    } else {
+        // a detached connection does not know its source anymore
+        remove_from(connection_source_index_.begin(), connection_source_index_.end());
+    }
+}
+
 void GraphImplementation::beginTransaction()
 {
     in_transaction_ = true;
@@ -701,13 +728,11 @@ NodeHandle* GraphImplementation::findNodeHandleNoThrow(const UUID& uuid) const n
         }
 
     } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr facade = vertex->getNodeFacade();
-            if (facade->getUUID() == uuid) {
-                NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(facade);
-                apex_assert_hard(local_facade);
-                return local_facade->getNodeHandle().get();
-            }
+        auto pos = vertex_index_.find(uuid);
+        if (pos != vertex_index_.end()) {
+            NodeFacadeImplementationPtr local_facade = std::dynamic_pointer_cast<NodeFacadeImplementation>(pos->second->getNodeFacade());
+            apex_assert_hard(local_facade);
+            return local_facade->getNodeHandle().get();
         }
     }
 
@@ -776,11 +801,9 @@ NodeFacadePtr GraphImplementation::findNodeFacadeNoThrow(const UUID& uuid) const
         }
 
     } else {
-        for (const auto vertex : vertices_) {
-            NodeFacadePtr nf = vertex->getNodeFacade();
-            if (nf->getUUID() == uuid) {
-                return nf;
-            }
+        auto pos = vertex_index_.find(uuid);
+        if (pos != vertex_index_.end()) {
+            return pos->second->getNodeFacade();
         }
     }
 
@@ -887,8 +910,10 @@ ConnectorPtr GraphImplementation::findConnectorNoThrow(const UUID& uuid) noexcep
 
 bool GraphImplementation::isConnected(const UUID& from, const UUID& to) const
 {
-    for (const ConnectionConstPtr& connection : edges_) {
-        if (connection->from()->getUUID() == from && connection->to()->getUUID() == to) {
+    auto range = connection_source_index_.equal_range(from);
+    for (auto it = range.first; it != range.second; ++it) {
+        ConnectablePtr target = it->second->to();
+        if (target && target->getUUID() == to) {
             return true;
         }
     }
@@ -898,10 +923,9 @@ bool GraphImplementation::isConnected(const UUID& from, const UUID& to) const
 
 ConnectionPtr GraphImplementation::getConnectionWithId(int id)
 {
-    for (const ConnectionPtr& connection : edges_) {
-        if (connection->id() == id) {
-            return connection;
-        }
+    auto pos = connection_id_index_.find(id);
+    if (pos != connection_id_index_.end()) {
+        return pos->second;
     }
 
     return nullptr;
@@ -909,9 +933,11 @@ ConnectionPtr GraphImplementation::getConnectionWithId(int id)
 
 ConnectionPtr GraphImplementation::getConnection(const UUID& from, const UUID& to)
 {
-    for (const ConnectionPtr& connection : edges_) {
-        if (connection->from()->getUUID() == from && connection->to()->getUUID() == to) {
-            return connection;
+    auto range = connection_source_index_.equal_range(from);
+    for (auto it = range.first; it != range.second; ++it) {
+        ConnectablePtr target = it->second->to();
+        if (target && target->getUUID() == to) {
+            return it->second;
         }
     }
 
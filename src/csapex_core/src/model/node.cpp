@@ -89,6 +89,11 @@ bool Node::canRunInSeparateProcess() const
     return true;
 }
 
+int Node::getReplicaCount() const
+{
+    return 1;
+}
+
 bool Node::canProcess() const
 {
     if (!node_handle_) {
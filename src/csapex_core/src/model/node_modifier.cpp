@@ -7,7 +7,10 @@
 #include <csapex/factory/message_factory.h>
 #include <csapex/msg/any_message.h>
 #include <csapex/msg/input.h>
+#include <csapex/msg/input_transition.h>
 #include <csapex/msg/output.h>
+#include <csapex/profiling/profiler_impl.h>
+#include <csapex/utility/assert.h>
 
 using namespace csapex;
 
@@ -121,3 +124,34 @@ void NodeModifier::setError(const std::string& msg)
         node_worker_->setError(true, msg, ErrorState::ErrorLevel::ERROR);
     }
 }
+
+void NodeModifier::enableMessagePooling(Output* output)
+{
+    apex_assert_hard(output);
+
+    std::shared_ptr<ProfilerImplementation> profiler = node_worker_ ? node_worker_->getProfiler() : nullptr;
+    if (profiler) {
+        std::string prefix = output->getLabel().empty() ? output->getUUID().getFullName() : output->getLabel();
+        output->enablePooling(profiler->getCounter(prefix + " pool hits"), profiler->getCounter(prefix + " pool misses"));
+    } else {
+        output->enablePooling();
+    }
+}
+
+void NodeModifier::setInputSynchronization(InputSyncPolicy policy, connection_types::Message::Stamp slop_micro_seconds)
+{
+    InputTransition* transition = getInputTransition();
+    transition->setSynchronizationSlop(slop_micro_seconds);
+    transition->setSynchronizationPolicy(policy);
+}
+
+InputSyncPolicy NodeModifier::getInputSynchronization() const
+{
+    return getInputTransition()->getSynchronizationPolicy();
+}
+
+void NodeModifier::setPrimaryInput(Input* input)
+{
+    apex_assert_hard(input);
+    getInputTransition()->setPrimaryInput(std::dynamic_pointer_cast<Input>(input->shared_from_this()));
+}
@@ -209,7 +209,7 @@ void NodeRunner::execute()
             if (f > max_frequency_) {
                 auto next_process = rate.endOfCycle();
 
-                auto now = std::chrono::system_clock::now();
+                auto now = std::chrono::steady_clock::now();
 
                 if (next_process > now) {
                     scheduleDelayed(execute_, next_process);
@@ -276,7 +276,7 @@ void NodeRunner::schedule(TaskPtr task)
     }
 }
 
-void NodeRunner::scheduleDelayed(TaskPtr task, std::chrono::system_clock::time_point time)
+void NodeRunner::scheduleDelayed(TaskPtr task, std::chrono::steady_clock::time_point time)
 {
     std::unique_lock<std::recursive_mutex> lock(mutex_);
     scheduler_->scheduleDelayed(task, time);
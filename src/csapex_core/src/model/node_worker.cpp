@@ -10,6 +10,7 @@
 #include <csapex/model/node_modifier.h>
 #include <csapex/model/node_modifier.h>
 #include <csapex/model/node_state.h>
+#include <csapex/model/replica_context.h>
 #include <csapex/model/subgraph_node.h>
 #include <csapex/msg/any_message.h>
 #include <csapex/msg/end_of_sequence_message.h>
@@ -24,6 +25,7 @@
 #include <csapex/param/trigger_parameter.h>
 #include <csapex/profiling/profiler_impl.h>
 #include <csapex/profiling/timer.h>
+#include <csapex/profiling/trace_buffer.h>
 #include <csapex/signal/event.h>
 #include <csapex/signal/slot.h>
 #include <csapex/serialization/io/std_io.h>
@@ -37,18 +39,94 @@
 #include <thread>
 #include <iostream>
 #include <cstdlib>
+#include <condition_variable>
+#include <deque>
 
 using namespace csapex;
 
+class NodeWorker::ReplicaPool
+{
+public:
+    ReplicaPool(const std::string& name, int size) : running_(true)
+    {
+        for (int i = 0; i < size; ++i) {
+            threads_.emplace_back([this, name]() {
+                csapex::thread::set_name(name.c_str());
+                run();
+            });
+        }
+    }
+
+    ~ReplicaPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        available_.notify_all();
+        for (std::thread& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    int size() const
+    {
+        return threads_.size();
+    }
+
+    void post(const std::function<void()>& job)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobs_.push_back(job);
+        }
+        available_.notify_one();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            available_.wait(lock, [this]() { return !running_ || !jobs_.empty(); });
+            if (!running_) {
+                return;
+            }
+
+            std::function<void()> job = jobs_.front();
+            jobs_.pop_front();
+
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+private:
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<std::function<void()>> jobs_;
+    bool running_;
+};
+
 NodeWorker::NodeWorker(NodeHandlePtr node_handle)
   : node_handle_(node_handle)
   , is_setup_(false)
   , is_processing_(false)
+  , is_held_(false)
   , trigger_process_done_(nullptr)
   , trigger_activated_(nullptr)
   , trigger_deactivated_(nullptr)
   , slot_enable_(nullptr)
   , slot_disable_(nullptr)
+  , trace_name_(TraceBuffer::intern(node_handle->getUUID().getFullName()))
+  , trace_process_start_(0)
+  , replicas_in_flight_(0)
+  , next_replica_dispatch_(0)
+  , next_replica_emission_(0)
+  , replica_generation_(0)
   , guard_(-1)
 {
     //    node_handle->setNodeWorker(this);
@@ -147,6 +225,9 @@ NodeWorker::NodeWorker(NodeHandlePtr node_handle)
 
 NodeWorker::~NodeWorker()
 {
+    // join the replicas first, they still refer to this worker
+    replica_pool_.reset();
+
     stopObserving();
 
     std::unique_lock<std::recursive_mutex> lock(sync);
@@ -231,8 +312,24 @@ void NodeWorker::setProcessingEnabled(bool e)
     node_handle_->getNodeState()->setEnabled(e);
 }
 
+void NodeWorker::setHeld(bool held)
+{
+    bool was_held = is_held_.exchange(held);
+    if (was_held && !held) {
+        triggerTryProcess();
+    }
+}
+
+bool NodeWorker::isHeld() const
+{
+    return is_held_;
+}
+
 bool NodeWorker::canProcess() const
 {
+    if (is_held_) {
+        return false;
+    }
     if (isProcessing()) {
         return false;
     }
@@ -244,6 +341,13 @@ bool NodeWorker::canProcess() const
         return false;
     }
 
+    int replicas = getReplicaCount();
+    if (replicas > 1) {
+        // replicas buffer their outputs, a free slot is all that is needed
+        std::unique_lock<std::recursive_mutex> lock(replica_mutex_);
+        return canReceive() && replicas_in_flight_ < replicas;
+    }
+
     return canReceive() && canSend();
 }
 
@@ -281,6 +385,18 @@ bool NodeWorker::canSend() const
     return true;
 }
 
+int NodeWorker::getReplicaCount() const
+{
+    if (!hasNode()) {
+        return 1;
+    }
+    NodePtr node = getNode();
+    if (node->isAsynchronous() || std::dynamic_pointer_cast<SubgraphNode>(node)) {
+        return 1;
+    }
+    return std::max(1, node->getReplicaCount());
+}
+
 void NodeWorker::ioChanged()
 {
     triggerTryProcess();
@@ -316,6 +432,16 @@ void NodeWorker::reset()
 
     setProcessing(false);
 
+    {
+        std::unique_lock<std::recursive_mutex> lock(replica_mutex_);
+        // invocations that are still running belong to the old generation and are discarded
+        ++replica_generation_;
+        replicas_in_flight_ = 0;
+        next_replica_dispatch_ = 0;
+        next_replica_emission_ = 0;
+        finished_replicas_.clear();
+    }
+
     node_handle_->getOutputTransition()->reset();
     node_handle_->getInputTransition()->reset();
 
@@ -511,6 +637,10 @@ void NodeWorker::rememberExecutionMode()
 
 void NodeWorker::startProfilerInterval(TracingType type)
 {
+    if (type == TracingType::PROCESS) {
+        trace_process_start_ = TraceBuffer::now();
+    }
+
     if (profiler_->isEnabled()) {
         Timer::Ptr timer = profiler_->getTimer(node_handle_->getUUID().getFullName());
         timer->restart();
@@ -521,6 +651,11 @@ void NodeWorker::startProfilerInterval(TracingType type)
 
 void NodeWorker::stopActiveProfilerInterval()
 {
+    uint64_t process_start = trace_process_start_.exchange(0);
+    if (process_start != 0) {
+        TraceBuffer::record(trace_name_, process_start, TraceBuffer::now());
+    }
+
     if (profiler_->isEnabled()) {
         finishTimer(profiler_->getTimer(node_handle_->getUUID().getFullName()));
     }
@@ -570,6 +705,10 @@ bool NodeWorker::processMarker(const connection_types::MarkerMessageConstPtr& ma
 
 bool NodeWorker::startProcessingMessages()
 {
+    if (getReplicaCount() > 1) {
+        return startProcessingReplica();
+    }
+
     apex_assert_hard(node_handle_->getOutputTransition()->canStartSendingMessages());
 
     NodePtr node = node_handle_->getNode().lock();
@@ -649,6 +788,165 @@ bool NodeWorker::startProcessingMessages()
     }
 }
 
+bool NodeWorker::startProcessingReplica()
+{
+    NodePtr node = node_handle_->getNode().lock();
+    apex_assert_hard(node);
+
+    if (node->hasChangedParameters()) {
+        handleChangedParameters();
+    }
+
+    ReplicaContextPtr context;
+    long generation;
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        apex_assert_hard(node_handle_->getInputTransition()->isEnabled());
+        apex_assert_hard(canProcess());
+
+        node_handle_->getInputTransition()->forwardMessages();
+
+        apex_assert_hard(node_handle_->getInputTransition()->areMessagesComplete());
+
+        updateParameterValues();
+
+        std::unique_lock<std::recursive_mutex> replica_lock(replica_mutex_);
+        context = std::make_shared<ReplicaContext>(next_replica_dispatch_++);
+        generation = replica_generation_;
+        ++replicas_in_flight_;
+    }
+
+    for (const InputPtr& input : node_handle_->getExternalInputs()) {
+        context->setInputToken(input.get(), input->getToken());
+    }
+    for (const OutputPtr& output : node_handle_->getExternalOutputs()) {
+        context->addOutput(output.get());
+    }
+
+    rememberExecutionMode();
+
+    std::vector<ActivityModifier> activity_modifiers = getIncomingActivityModifiers();
+    auto marker = getFirstMarkerMessage();
+    bool all_inputs_present = allInputsArePresent();
+
+    // the tokens are snapshotted, so the inputs can accept the next ones right away
+    node_handle_->getInputTransition()->notifyMessageRead();
+    node_handle_->getInputTransition()->notifyMessageProcessed();
+
+    if (!isProcessingEnabled()) {
+        finishReplica(context, generation);
+        emitFinishedReplicas();
+        return true;
+    }
+
+    if (!activity_modifiers.empty()) {
+        applyActivityModifiers(activity_modifiers);
+    }
+
+    bool nothing_marker = false;
+    if (marker) {
+        ReplicaContext::Scope scope(context.get());
+        nothing_marker = processMarker(marker);
+    }
+
+    if (marker || !all_inputs_present) {
+        if (nothing_marker || !all_inputs_present) {
+            const NodeCharacteristics& characteristics = node_handle_->getVertex()->getNodeCharacteristics();
+            context->setForwarding(characteristics.is_leading_to_joining_vertex || characteristics.is_leading_to_essential_vertex);
+        }
+        finishReplica(context, generation);
+        emitFinishedReplicas();
+        return false;
+    }
+
+    if (!replica_pool_ || replica_pool_->size() != getReplicaCount()) {
+        replica_pool_.reset(new ReplicaPool(node_handle_->getUUID().getShortName(), getReplicaCount()));
+    }
+
+    replica_pool_->post([this, node, context, generation]() {
+        {
+            // replicas run concurrently, so every replica records its span on its own thread
+            TraceScope trace(trace_name_);
+            ReplicaContext::Scope scope(context.get());
+            try {
+                node->process(*node_handle_, *node);
+
+            } catch (const std::exception& e) {
+                context->setError(e.what());
+            } catch (...) {
+                context->setError("Unknown exception caught in NodeWorker replica.");
+            }
+        }
+
+        finishReplica(context, generation);
+        node_handle_->execution_requested([this]() { emitFinishedReplicas(); });
+    });
+
+    return true;
+}
+
+void NodeWorker::finishReplica(const ReplicaContextPtr& context, long generation)
+{
+    std::unique_lock<std::recursive_mutex> lock(replica_mutex_);
+    if (generation == replica_generation_) {
+        finished_replicas_[context->getSequenceNumber()] = context;
+    }
+}
+
+void NodeWorker::emitFinishedReplicas()
+{
+    while (true) {
+        ReplicaContextPtr context;
+        {
+            std::unique_lock<std::recursive_mutex> lock(replica_mutex_);
+            // outputs are only emitted in the order the inputs were dispatched
+            auto next = finished_replicas_.find(next_replica_emission_);
+            if (next == finished_replicas_.end() || isProcessing()) {
+                break;
+            }
+            if (next->second->isForwarding() && !canSend()) {
+                break;
+            }
+
+            context = next->second;
+            finished_replicas_.erase(next);
+            ++next_replica_emission_;
+        }
+
+        if (!context->getError().empty()) {
+            setError(true, context->getError());
+        }
+
+        setProcessing(true);
+
+        if (context->isForwarding()) {
+            if (trigger_process_done_->isConnected()) {
+                msg::trigger(trigger_process_done_);
+            }
+
+            for (const auto& pair : context->getOutputTokens()) {
+                if (pair.second) {
+                    pair.first->addMessage(pair.second);
+                }
+            }
+
+            publishParameters();
+            forwardMessages();
+        }
+
+        setProcessing(false);
+
+        {
+            std::unique_lock<std::recursive_mutex> lock(replica_mutex_);
+            --replicas_in_flight_;
+        }
+
+        messages_processed();
+    }
+
+    triggerTryProcess();
+}
+
 bool NodeWorker::startProcessingSlot(const SlotWeakPtr& slot)
 {
     processSlot(slot);
@@ -751,6 +1049,12 @@ void NodeWorker::notifyMessagesProcessedDownstream()
 {
     //assertSameThreadId();
 
+    if (getReplicaCount() > 1) {
+        // the inputs were already released when the replicas were dispatched
+        emitFinishedReplicas();
+        return;
+    }
+
     if (auto subgraph = std::dynamic_pointer_cast<SubgraphNode>(node_handle_->getNode().lock())) {
         subgraph->notifyMessagesProcessed();
     }
@@ -783,6 +1087,11 @@ void NodeWorker::updateState()
 
 bool NodeWorker::canExecute()
 {
+    if (getReplicaCount() > 1) {
+        // replicas don't wait for the outputs, those are only needed to emit the results
+        return node_handle_->getInputTransition()->isEnabled() && canProcess();
+    }
+
     if (isEnabled() && canProcess()) {
         return true;
     } else {
@@ -917,6 +1226,10 @@ void NodeWorker::connectConnector(ConnectablePtr c)
         SlotWeakPtr slot_w = slot;
         auto connection = slot->triggered.connect([this, slot_w]() { getNodeHandle()->execution_requested([this, slot_w]() { processSlot(slot_w); }); });
         port_connections_[c.get()].emplace_back(connection);
+
+    } else if (InputPtr input = std::dynamic_pointer_cast<Input>(c)) {
+        std::string prefix = input->getLabel().empty() ? input->getUUID().getFullName() : input->getLabel();
+        input->setCopyCounter(profiler_->getCounter(prefix + " copies"));
     }
 }
 
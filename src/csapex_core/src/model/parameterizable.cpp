@@ -66,6 +66,14 @@ void Parameterizable::removeParameterCallbacks(csapex::param::Parameter* param)
     for (slim_signal::Connection c : parameter_connections_[param]) {
         c.disconnect();
     }
+
+    param_handle_updates_.erase(param);
+}
+
+void Parameterizable::addParameterHandleUpdate(param::Parameter* param, std::function<void(const param::ParameterPtr&)> update)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    param_handle_updates_[param].push_back(update);
 }
 
 void Parameterizable::addParameterCondition(csapex::param::ParameterPtr param, std::function<bool()> enable_condition)
@@ -390,6 +398,19 @@ Parameterizable::ChangedParameterList Parameterizable::getChangedParameters()
     changed_params = changed_params_;
     changed_params_.clear();
 
+    if (!param_handle_updates_.empty()) {
+        for (const auto& entry : changed_params) {
+            if (param::ParameterPtr p = entry.first.lock()) {
+                auto pos = param_handle_updates_.find(p.get());
+                if (pos != param_handle_updates_.end()) {
+                    for (auto& update : pos->second) {
+                        update(p);
+                    }
+                }
+            }
+        }
+    }
+
     return changed_params;
 }
 
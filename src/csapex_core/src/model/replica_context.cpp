@@ -0,0 +1,101 @@
+/// HEADER
+#include <csapex/model/replica_context.h>
+
+/// PROJECT
+#include <csapex/utility/assert.h>
+
+using namespace csapex;
+
+namespace
+{
+thread_local ReplicaContext* g_current_context = nullptr;
+}
+
+ReplicaContext::Scope::Scope(ReplicaContext* context) : previous_(g_current_context)
+{
+    g_current_context = context;
+}
+
+ReplicaContext::Scope::~Scope()
+{
+    g_current_context = previous_;
+}
+
+ReplicaContext* ReplicaContext::current()
+{
+    return g_current_context;
+}
+
+ReplicaContext::ReplicaContext(long sequence_number) : sequence_number_(sequence_number), forward_(true)
+{
+}
+
+long ReplicaContext::getSequenceNumber() const
+{
+    return sequence_number_;
+}
+
+void ReplicaContext::setInputToken(const Input* input, const TokenPtr& token)
+{
+    inputs_[input] = token;
+}
+
+bool ReplicaContext::hasInput(const Input* input) const
+{
+    return inputs_.find(input) != inputs_.end();
+}
+
+TokenPtr ReplicaContext::getInputToken(const Input* input) const
+{
+    auto pos = inputs_.find(input);
+    apex_assert_hard(pos != inputs_.end());
+    return pos->second;
+}
+
+void ReplicaContext::addOutput(Output* output)
+{
+    outputs_[output];
+}
+
+bool ReplicaContext::hasOutput(const Output* output) const
+{
+    return outputs_.find(const_cast<Output*>(output)) != outputs_.end();
+}
+
+void ReplicaContext::setOutputToken(Output* output, const TokenPtr& token)
+{
+    apex_assert_hard(hasOutput(output));
+    outputs_[output] = token;
+}
+
+TokenPtr ReplicaContext::getOutputToken(const Output* output) const
+{
+    auto pos = outputs_.find(const_cast<Output*>(output));
+    apex_assert_hard(pos != outputs_.end());
+    return pos->second;
+}
+
+const std::map<Output*, TokenPtr>& ReplicaContext::getOutputTokens() const
+{
+    return outputs_;
+}
+
+void ReplicaContext::setForwarding(bool forward)
+{
+    forward_ = forward;
+}
+
+bool ReplicaContext::isForwarding() const
+{
+    return forward_;
+}
+
+void ReplicaContext::setError(const std::string& error)
+{
+    error_ = error;
+}
+
+const std::string& ReplicaContext::getError() const
+{
+    return error_;
+}
@@ -29,6 +29,10 @@ SubgraphNode::SubgraphNode(GraphImplementationPtr graph)
   , is_subgraph_finished_(false)
   , is_iterating_(false)
   , has_sent_current_iteration_(false)
+  , iteration_index_(0)
+  , iteration_count_(0)
+  , iterations_received_(0)
+  , iteration_pipeline_depth_(1)
   , is_initialized_(false)
   ,
 
@@ -176,6 +180,11 @@ void SubgraphNode::setupParameters(Parameterizable& params)
                                            setIterationEnabled(id, iterate);
                                        }
                                    });
+
+    params.addConditionalParameter(param::factory::declareRange("iteration_pipeline_depth",
+                                                                param::ParameterDescription("Number of container elements that are processed in the subgraph at the same time"), 1, 64, 1, 1)
+                                       .build(),
+                                   [this]() { return readParameter<bool>("iterate_containers"); }, [this](param::Parameter* p) { setIterationPipelineDepth(p->as<int>()); });
 }
 
 void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params, Continuation continuation)
@@ -188,13 +197,14 @@ void SubgraphNode::process(NodeModifier& node_modifier, Parameterizable& params,
 
     apex_assert_hard(is_initialized_);
 
-    // can fail...
-    apex_assert_hard(transition_relay_out_->areAllConnections(Connection::State::NOT_INITIALIZED));
     apex_assert_hard(transition_relay_out_->canStartSendingMessages());
 
+    std::unique_lock<std::recursive_mutex> iteration_lock(iteration_mutex_);
+
     is_iterating_ = false;
     has_sent_current_iteration_ = false;
     is_subgraph_finished_ = false;
+    iterations_received_ = 0;
 
     for (const InputPtr& i : node_modifier.getMessageInputs()) {
         if (msg::hasMessage(i.get())) {
@@ -690,6 +700,25 @@ void SubgraphNode::setIterationEnabled(const UUID& external_input_uuid, bool ena
     }
 }
 
+void SubgraphNode::setIterationPipelineDepth(int depth)
+{
+    apex_assert_gt_hard(depth, 0);
+    std::unique_lock<std::recursive_mutex> lock(iteration_mutex_);
+    iteration_pipeline_depth_ = depth;
+}
+
+int SubgraphNode::getIterationPipelineDepth() const
+{
+    std::unique_lock<std::recursive_mutex> lock(iteration_mutex_);
+    return iteration_pipeline_depth_;
+}
+
+bool SubgraphNode::isIterationPipelined() const
+{
+    // without outputs, there are no results that would tell us when an element is done
+    return is_iterating_ && iteration_pipeline_depth_ > 1 && !node_handle_->isSink();
+}
+
 void SubgraphNode::notifyMessagesProcessed()
 {
     // TRACE ainfo << "messages processed" << std::endl;
@@ -710,8 +739,10 @@ void SubgraphNode::currentIterationIsProcessed()
 void SubgraphNode::subgraphHasProducedAllMessages()
 {
     if (transition_relay_in_->isEnabled()) {  // TODO: check this in checkIfEnabled
+        // when pipelined, the internal nodes report from their own threads
+        std::unique_lock<std::recursive_mutex> lock(iteration_mutex_);
 
-        apex_assert_hard(!has_sent_current_iteration_);
+        apex_assert_hard(isIterationPipelined() || !has_sent_current_iteration_);
         sendCurrentIteration();
 
         tryFinishSubgraph();
@@ -721,6 +752,21 @@ void SubgraphNode::subgraphHasProducedAllMessages()
 void SubgraphNode::tryFinishSubgraph()
 {
     // TRACE ainfo << "try finish" << std::endl;
+    std::unique_lock<std::recursive_mutex> lock(iteration_mutex_);
+
+    if (isIterationPipelined()) {
+        // the internal graph keeps the order of the elements, so the results arrive in index order
+        if (iterations_received_ >= iteration_count_) {
+            finishSubgraph();
+        } else {
+            bool can_send_more = iteration_index_ < iteration_count_ && iteration_index_ - iterations_received_ < iteration_pipeline_depth_;
+            if (can_send_more && transition_relay_out_->canStartSendingMessages()) {
+                startNextIteration();
+            }
+        }
+        return;
+    }
+
     bool can_start_next_iteration = node_handle_->isSink() || has_sent_current_iteration_;
     if (can_start_next_iteration) {
         bool last_iteration = !is_iterating_ || iteration_index_ >= iteration_count_;
@@ -783,7 +829,15 @@ void SubgraphNode::sendCurrentIteration()
     transition_relay_in_->forwardMessages();
 
     has_sent_current_iteration_ = true;
-    if (is_iterating_ && iteration_index_ < iteration_count_) {
+    if (isIterationPipelined()) {
+        ++iterations_received_;
+        if (iterations_received_ < iteration_count_) {
+            // the next results are already on their way
+            transition_relay_in_->notifyMessageRead();
+            transition_relay_in_->notifyMessageProcessed();
+        }
+
+    } else if (is_iterating_ && iteration_index_ < iteration_count_) {
         // TRACE ainfo << "mark read" << std::endl;
         transition_relay_in_->notifyMessageRead();
         transition_relay_in_->notifyMessageProcessed();
@@ -798,6 +852,13 @@ void SubgraphNode::sendCurrentIteration()
 void SubgraphNode::startNextIteration()
 {
     //    ainfo << "start iteration " << iteration_index_ << std::endl;
+    if (isIterationPipelined()) {
+        // every element gets its own step, the previous ones might still be processed
+        for (NodeHandle* nh : graph_->getAllNodeHandles()) {
+            nh->getNodeRunner()->step();
+        }
+    }
+
     for (const InputPtr& i : node_modifier_->getMessageInputs()) {
         TokenDataConstPtr m = msg::getMessage(i.get());
         OutputPtr o = external_to_internal_outputs_.at(i->getUUID());
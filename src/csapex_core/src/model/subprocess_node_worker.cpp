@@ -27,6 +27,8 @@
 #include <csapex/signal/event.h>
 #include <csapex/signal/slot.h>
 #include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/serialization/message_serializer.h>
 #include <csapex/utility/debug.h>
 #include <csapex/utility/delegate_bind.h>
 #include <csapex/utility/exceptions.h>
@@ -44,6 +46,55 @@
 
 using namespace csapex;
 
+namespace
+{
+/// messages cross the process boundary in the binary format as a list of (connector uuid, message) pairs
+void writeMessage(SerializationBuffer& buffer, const UUID& uuid, const TokenData& message)
+{
+    buffer << uuid;
+    // TODO serialize token! (+ activity, ...)
+    MessageSerializer::serializeBinaryMessage(message, buffer);
+}
+
+TokenDataConstPtr readMessage(const SerializationBuffer& buffer, UUID& uuid)
+{
+    buffer >> uuid;
+    return MessageSerializer::deserializeBinaryMessage(buffer);
+}
+
+/// serializes messages directly into the shared memory of a channel, so that they are passed on without another copy
+class ChannelStorage : public SerializationStorage
+{
+public:
+    ChannelStorage(SubprocessChannel& channel) : channel_(channel), sent_(nullptr)
+    {
+    }
+
+    uint8_t* allocate(std::size_t bytes) override
+    {
+        return channel_.allocatePayload(bytes);
+    }
+
+    void deallocate(uint8_t* data) override
+    {
+        // a sent payload is owned by the channel
+        if (data != sent_) {
+            channel_.deallocatePayload(data);
+        }
+    }
+
+    void send(SubprocessChannel::MessageType type, const SerializationBuffer& buffer)
+    {
+        sent_ = buffer.data();
+        channel_.write({ type, buffer.data(), buffer.size() });
+    }
+
+private:
+    SubprocessChannel& channel_;
+    const uint8_t* sent_;
+};
+}  // namespace
+
 SubprocessNodeWorker::SubprocessNodeWorker(NodeHandlePtr node_handle) : NodeWorker(node_handle), pid_(-1), subprocess_(new Subprocess(node_handle->getUUID().getFullName()))
 {
 }
@@ -164,16 +215,17 @@ void SubprocessNodeWorker::handleProcessChild(const SubprocessChannel::Message&
 
     try {
         if (msg.data) {
-            YAML::Node yaml = YAML::Load(msg.toString());
-            for (const YAML::Node& node : yaml) {
-                UUID uuid = node["uuid"].as<UUID>();
-                auto msg = MessageSerializer::deserializeYamlMessage(node["data"]);
+            SerializationBuffer buffer(msg.data, msg.length);
+            std::size_t count = buffer.readLength();
+            for (std::size_t i = 0; i < count; ++i) {
+                UUID uuid;
+                TokenDataConstPtr message = readMessage(buffer, uuid);
 
                 InputPtr input = node_handle_->getInput(uuid);
                 apex_assert_hard_msg(input, std::string("could not get input ") + uuid.getFullName());
 
-                input->setToken(std::make_shared<Token>(msg));
-            };
+                input->setToken(std::make_shared<Token>(message));
+            }
         }
 
         if (msg.type == SubprocessChannel::MessageType::PROCESS_SYNC) {
@@ -205,14 +257,14 @@ void SubprocessNodeWorker::handleProcessSlotChild(const SubprocessChannel::Messa
 
     try {
         if (msg.data) {
-            YAML::Node yaml = YAML::Load(msg.toString());
-            UUID uuid = yaml["uuid"].as<UUID>();
-            auto msg = MessageSerializer::deserializeYamlMessage(yaml["data"]);
+            SerializationBuffer buffer(msg.data, msg.length);
+            UUID uuid;
+            TokenDataConstPtr message = readMessage(buffer, uuid);
 
             SlotPtr slot = node_handle_->getSlot(uuid);
             apex_assert_hard_msg(slot, std::string("could not get slot ") + uuid.getFullName());
 
-            slot->setToken(std::make_shared<Token>(msg));
+            slot->setToken(std::make_shared<Token>(message));
             slot->handleEvent();
         }
 
@@ -230,7 +282,8 @@ void SubprocessNodeWorker::finishHandleProcessChild()
 {
     NodePtr node = getNode();
 
-    YAML::Emitter result_emitter;
+    ChannelStorage storage(subprocess_->out);
+    SerializationBuffer result(storage);
     try {
         // send parameter updates
         for (param::Parameter* parameter : changed_parameters_) {
@@ -240,41 +293,24 @@ void SubprocessNodeWorker::finishHandleProcessChild()
         changed_parameters_.clear();
 
         // send result
-        YAML::Node yaml(YAML::NodeType::Sequence);
+        std::vector<std::pair<UUID, TokenPtr>> messages;
 
         for (const OutputPtr& output : node_handle_->getExternalOutputs()) {
-            auto msg = output->getAddedToken();
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = output->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg->getTokenData());
-
-                YAML::Emitter emitter;
-                emitter << node;
-
-                yaml.push_back(node);
+            if (TokenPtr msg = output->getAddedToken()) {
+                messages.emplace_back(output->getUUID(), msg);
             }
         }
 
         for (const EventPtr& event : node_handle_->getExternalEvents()) {
-            auto msg = event->getAddedToken();
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = event->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg->getTokenData());
-
-                YAML::Emitter emitter;
-                emitter << node;
-
-                yaml.push_back(node);
+            if (TokenPtr msg = event->getAddedToken()) {
+                messages.emplace_back(event->getUUID(), msg);
             }
         }
 
-        result_emitter << yaml;
+        result.writeLength(messages.size());
+        for (const auto& pair : messages) {
+            writeMessage(result, pair.first, *pair.second->getTokenData());
+        }
 
     } catch (const std::exception& e) {
         node->aerr << "finishHandleProcessChild: " << e.what() << std::endl;
@@ -286,7 +322,7 @@ void SubprocessNodeWorker::finishHandleProcessChild()
 
     subprocess_->flush();
 
-    subprocess_->out.write({ SubprocessChannel::MessageType::PROCESS_FINISHED, result_emitter.c_str() });
+    storage.send(SubprocessChannel::MessageType::PROCESS_FINISHED, result);
 }
 
 SubprocessNodeWorker::~SubprocessNodeWorker()
@@ -294,6 +330,12 @@ SubprocessNodeWorker::~SubprocessNodeWorker()
     stopObserving();
 }
 
+int SubprocessNodeWorker::getReplicaCount() const
+{
+    // the node lives in a single child process
+    return 1;
+}
+
 void SubprocessNodeWorker::handleParameterUpdate(const SubprocessChannel::Message& msg)
 {
     if (msg.data) {
@@ -311,11 +353,12 @@ void SubprocessNodeWorker::handleParameterUpdate(const SubprocessChannel::Messag
 void SubprocessNodeWorker::handleProcessParent(const SubprocessChannel::Message& msg)
 {
     if (msg.data) {
-        YAML::Node yaml = YAML::Load(msg.toString());
+        SerializationBuffer buffer(msg.data, msg.length);
+        std::size_t count = buffer.readLength();
 
-        for (const YAML::Node& node : yaml) {
-            UUID uuid = node["uuid"].as<UUID>();
-            auto msg = MessageSerializer::deserializeYamlMessage(node["data"]);
+        for (std::size_t i = 0; i < count; ++i) {
+            UUID uuid;
+            TokenDataConstPtr msg = readMessage(buffer, uuid);
 
             ConnectorPtr connector = node_handle_->getConnector(uuid);
             if (OutputPtr output = std::dynamic_pointer_cast<Output>(connector)) {
@@ -325,7 +368,7 @@ void SubprocessNodeWorker::handleProcessParent(const SubprocessChannel::Message&
                 TokenPtr token = std::make_shared<Token>(msg);
                 event->triggerWith(token);
             }
-        };
+        }
     }
 }
 
@@ -371,26 +414,24 @@ void SubprocessNodeWorker::processNode()
 
 void SubprocessNodeWorker::startSubprocess(const SubprocessChannel::MessageType type)
 {
-    YAML::Node yaml(YAML::NodeType::Sequence);
+    std::vector<std::pair<UUID, TokenDataConstPtr>> messages;
 
     for (const InputPtr& input : node_handle_->getExternalInputs()) {
         if (msg::hasMessage(input.get())) {
-            auto msg = msg::getMessage(input.get());
-
-            if (msg) {
-                YAML::Node node(YAML::NodeType::Map);
-                node["uuid"] = input->getUUID();
-                // TODO serialize token! (+ activity, ...)
-                node["data"] = MessageSerializer::serializeYamlMessage(*msg);
-                yaml.push_back(node);
+            if (TokenDataConstPtr msg = msg::getMessage(input.get())) {
+                messages.emplace_back(input->getUUID(), msg);
             }
         }
     }
 
-    YAML::Emitter emitter;
-    emitter << yaml;
+    ChannelStorage storage(subprocess_->in);
+    SerializationBuffer buffer(storage);
+    buffer.writeLength(messages.size());
+    for (const auto& pair : messages) {
+        writeMessage(buffer, pair.first, *pair.second);
+    }
 
-    subprocess_->in.write({ type, emitter.c_str() });
+    storage.send(type, buffer);
 }
 
 void SubprocessNodeWorker::processSlot(const SlotWeakPtr& slot_w)
@@ -420,15 +461,11 @@ void SubprocessNodeWorker::startSubprocessSlot(const SlotPtr& slot)
     auto msg = msg::getMessage(slot.get());
 
     if (msg) {
-        YAML::Node yaml(YAML::NodeType::Map);
-        yaml["uuid"] = slot->getUUID();
-        // TODO serialize token! (+ activity, ...)
-        yaml["data"] = MessageSerializer::serializeYamlMessage(*msg);
-
-        YAML::Emitter emitter;
-        emitter << yaml;
+        ChannelStorage storage(subprocess_->in);
+        SerializationBuffer buffer(storage);
+        writeMessage(buffer, slot->getUUID(), *msg);
 
-        subprocess_->in.write({ SubprocessChannel::MessageType::PROCESS_SLOT, emitter.c_str() });
+        storage.send(SubprocessChannel::MessageType::PROCESS_SLOT, buffer);
 
         finishSubprocess();
     }
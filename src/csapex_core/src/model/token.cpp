@@ -43,7 +43,8 @@ void Token::setSequenceNumber(int seq_no) const
 
 bool Token::cloneData(const Token& other)
 {
-    data_ = other.data_->cloneAs<TokenData>();
+    // the data is immutable, so all copies of a token share it. nodes that need to modify a message copy it explicitly
+    data_ = other.data_;
     activity_modifier_ = other.activity_modifier_;
     seq_no_ = other.seq_no_;
 
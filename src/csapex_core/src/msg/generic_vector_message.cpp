@@ -96,11 +96,8 @@ GenericVectorMessage::InstancedImplementation::InstancedImplementation() : Entry
 
 bool GenericVectorMessage::InstancedImplementation::cloneData(const GenericVectorMessage::InstancedImplementation& other)
 {
-    value.clear();
-    value.reserve(other.value.size());
-    for(const auto& v : other.value) {
-        value.push_back(v->cloneAs<TokenData>());
-    }
+    // the entries are never modified after they have been added, so they can be shared
+    value = other.value;
     return true;
 }
 
@@ -142,7 +139,7 @@ void GenericVectorMessage::InstancedImplementation::decode(const YAML::Node& nod
     YAML::Emitter emitter;
     emitter << node;
     std::cout << "vector instance: decode " << emitter.c_str() << std::endl;
-    value = node["values"].as<std::vector<TokenData::Ptr> >();
+    value = node["values"].as<std::vector<TokenData::ConstPtr> >();
 }
 
 TokenData::Ptr GenericVectorMessage::InstancedImplementation::nestedType() const
@@ -153,7 +150,8 @@ TokenData::Ptr GenericVectorMessage::InstancedImplementation::nestedType() const
 
 void GenericVectorMessage::InstancedImplementation::addNestedValue(const TokenData::ConstPtr& msg)
 {
-    value.push_back(msg->cloneAs<TokenData>());
+    // messages are immutable, so the vector can reference the entry instead of copying it
+    value.push_back(msg);
 }
 TokenData::ConstPtr GenericVectorMessage::InstancedImplementation::nestedValue(std::size_t i) const
 {
@@ -3,6 +3,7 @@
 
 /// COMPONENT
 #include <csapex/model/connection.h>
+#include <csapex/model/replica_context.h>
 #include <csapex/utility/assert.h>
 #include <csapex/msg/input_transition.h>
 #include <csapex/msg/marker_message.h>
@@ -14,7 +15,7 @@
 
 using namespace csapex;
 
-Input::Input(const UUID& uuid, ConnectableOwnerWeakPtr owner) : Connectable(uuid, owner), transition_(nullptr), optional_(false)
+Input::Input(const UUID& uuid, ConnectableOwnerWeakPtr owner) : Connectable(uuid, owner), transition_(nullptr), optional_(false), copies_(std::make_shared<Counter>("copies"))
 {
 }
 
@@ -58,18 +59,17 @@ bool Input::isOptional() const
 
 bool Input::hasReceived() const
 {
-    std::unique_lock<std::mutex> lock(message_mutex_);
-    return message_ != nullptr;
+    return getToken() != nullptr;
 }
 
 bool Input::hasMessage() const
 {
-    if (!hasReceived()) {
+    TokenPtr token = getToken();
+    if (!token) {
         return false;
     }
 
-    std::unique_lock<std::mutex> lock(message_mutex_);
-    return !std::dynamic_pointer_cast<connection_types::MarkerMessage const>(message_->getTokenData());
+    return !std::dynamic_pointer_cast<connection_types::MarkerMessage const>(token->getTokenData());
 }
 
 void Input::stop()
@@ -130,6 +130,13 @@ OutputPtr Input::getSource() const
 
 TokenPtr Input::getToken() const
 {
+    // replicated invocations read the tokens that were snapshotted for them
+    if (ReplicaContext* context = ReplicaContext::current()) {
+        if (context->hasInput(this)) {
+            return context->getInputToken(this);
+        }
+    }
+
     std::unique_lock<std::mutex> lock(message_mutex_);
     return message_;
 }
@@ -170,6 +177,18 @@ void Input::notifyMessageAvailable(Connection* connection)
     }
 }
 
+void Input::setCopyCounter(const Counter::Ptr& copies)
+{
+    apex_assert_hard(copies);
+    // the worker can replace the counter while the node is processing
+    std::atomic_store(&copies_, copies);
+}
+
+Counter::Ptr Input::getCopyCounter() const
+{
+    return std::atomic_load(&copies_);
+}
+
 void Input::addStatusInformation(std::stringstream& status_stream) const
 {
     if (TokenPtr token = getToken()) {
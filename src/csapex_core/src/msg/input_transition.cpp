@@ -4,22 +4,33 @@
 /// COMPONENT
 #include <csapex/model/connection.h>
 #include <csapex/msg/input.h>
+#include <csapex/msg/marker_message.h>
 #include <csapex/msg/output.h>
 #include <csapex/utility/assert.h>
 #include <csapex/msg/no_message.h>
 #include <csapex/utility/debug.h>
 
 /// SYSTEM
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
 using namespace csapex;
 
-InputTransition::InputTransition(delegate::Delegate0<> activation_fn) : Transition(activation_fn), forwarded_(false), processed_(false)
+namespace
 {
+bool isMarker(const TokenPtr& token)
+{
+    return std::dynamic_pointer_cast<connection_types::MarkerMessage const>(token->getTokenData()) != nullptr;
 }
+}  // namespace
 
-InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false)
+InputTransition::InputTransition(delegate::Delegate0<> activation_fn)
+  : Transition(activation_fn), forwarded_(false), processed_(false), policy_(InputSyncPolicy::SEQUENCE), slop_(0), buffer_size_(16), primary_(nullptr), dropped_(0)
+{
+}
+
+InputTransition::InputTransition() : Transition(), forwarded_(false), processed_(false), policy_(InputSyncPolicy::SEQUENCE), slop_(0), buffer_size_(16), primary_(nullptr), dropped_(0)
 {
 }
 
@@ -53,9 +64,19 @@ void InputTransition::addInput(InputPtr input)
 
     // remember the input
     inputs_[input->getUUID()] = input;
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (!primary_) {
+            primary_ = input.get();
+        }
+    }
 
     // connect signals
-    auto cm = input->message_available.connect([this](Connection*) { checkIfEnabled(); });
+    Input* in = input.get();
+    auto cm = input->message_available.connect([this, in](Connection* connection) {
+        takeToken(in, connection);
+        checkIfEnabled();
+    });
     input_signal_connections_[input].push_back(cm);
 
     auto ca = input->connection_added.connect([this](ConnectionPtr connection) { addConnection(connection); });
@@ -77,11 +98,23 @@ void InputTransition::removeInput(InputPtr input)
 
     // forget the input
     inputs_.erase(input->getUUID());
+
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    buffers_.erase(input.get());
+    match_.erase(input.get());
+    if (primary_ == input.get()) {
+        primary_ = nullptr;
+    }
 }
 
 void InputTransition::connectionRemoved(Connection* connection)
 {
     Transition::connectionRemoved(connection);
+
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    Input* input = connection->to().get();
+    buffers_.erase(input);
+    match_.erase(input);
 }
 
 void InputTransition::reset()
@@ -97,6 +130,12 @@ void InputTransition::reset()
     forwarded_ = false;
     processed_ = false;
 
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        buffers_.clear();
+        match_.clear();
+    }
+
     Transition::reset();
 }
 
@@ -104,6 +143,11 @@ void InputTransition::connectionAdded(Connection* connection)
 {
     Transition::connectionAdded(connection);
 
+    if (policy_ != InputSyncPolicy::SEQUENCE) {
+        // only SEQUENCE keeps the connections in lockstep
+        return;
+    }
+
     bool read = isOneConnection(Connection::State::READ);
     bool unread = isOneConnection(Connection::State::UNREAD);
 
@@ -129,6 +173,15 @@ bool InputTransition::isEnabled() const
         return false;
     }
 
+    if (isSynchronizing()) {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (policy_ == InputSyncPolicy::APPROXIMATE_TIME) {
+            return !match_.empty();
+        } else {
+            return isPrimaryReady();
+        }
+    }
+
     //    for(const auto& pair: inputs_) {
     //        InputPtr input = pair.second;
     //        if(input->isOptional()) {
@@ -214,6 +267,35 @@ void InputTransition::notifyMessageProcessed()
         return;
     }
 
+    if (isSynchronizing()) {
+        std::vector<ConnectionPtr> read;
+        bool match_available = false;
+        {
+            std::unique_lock<std::recursive_mutex> lock(sync);
+            forwarded_ = false;
+            processed_ = true;
+            for (const ConnectionPtr& c : connections_) {
+                // buffered connections are released by takeToken
+                if (!isBuffered(c->to().get()) && c->getState() == Connection::State::READ) {
+                    read.push_back(c);
+                }
+            }
+            if (policy_ == InputSyncPolicy::APPROXIMATE_TIME) {
+                match_available = !match_.empty() || findApproximateMatch();
+            }
+        }
+
+        for (const ConnectionPtr& c : read) {
+            c->setTokenProcessed();
+        }
+
+        // buffered tokens do not arrive again, so the next match has to be announced here
+        if (match_available) {
+            checkIfEnabled();
+        }
+        return;
+    }
+
     if (areAllConnections(Connection::State::READ, Connection::State::NOT_INITIALIZED)) {
         APEX_DEBUG_CERR << "input transition notified" << std::endl;
         forwarded_ = false;
@@ -246,6 +328,41 @@ void InputTransition::forwardMessages()
         return;
     }
 
+    if (isSynchronizing()) {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        for (auto pair : inputs_) {
+            InputPtr input = pair.second;
+
+            TokenPtr token;
+            if (input->hasEnabledConnection()) {
+                if (!isBuffered(input.get())) {
+                    ConnectionPtr connection = input->getConnections().front();
+                    apex_assert_hard(connection->getState() == Connection::State::UNREAD);
+                    token = connection->readToken();
+
+                } else if (policy_ == InputSyncPolicy::APPROXIMATE_TIME) {
+                    auto pos = match_.find(input.get());
+                    if (pos != match_.end()) {
+                        token = pos->second;
+                    }
+
+                } else {
+                    // sampled values stay in the buffer until they are replaced by a newer one
+                    auto pos = buffers_.find(input.get());
+                    if (pos != buffers_.end() && !pos->second.empty()) {
+                        token = pos->second.back();
+                    }
+                }
+            }
+
+            input->setToken(token ? token : connection_types::makeEmptyToken<connection_types::NoMessage>());
+        }
+        match_.clear();
+
+        forwarded_ = true;
+        return;
+    }
+
     if (hasConnection()) {
         apex_assert_hard(!forwarded_);
 
@@ -307,3 +424,237 @@ int InputTransition::getPortCount() const
 {
     return inputs_.size();
 }
+
+void InputTransition::setSynchronizationPolicy(InputSyncPolicy policy)
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (policy == policy_) {
+            return;
+        }
+        policy_ = policy;
+        buffers_.clear();
+        match_.clear();
+    }
+
+    // tokens that are already waiting would otherwise only be taken when the next one arrives
+    for (auto pair : inputs_) {
+        for (const ConnectionPtr& connection : pair.second->getConnections()) {
+            takeToken(pair.second.get(), connection.get());
+        }
+    }
+    checkIfEnabled();
+}
+
+InputSyncPolicy InputTransition::getSynchronizationPolicy() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return policy_;
+}
+
+void InputTransition::setSynchronizationSlop(connection_types::Message::Stamp slop_micro_seconds)
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    slop_ = slop_micro_seconds;
+}
+
+connection_types::Message::Stamp InputTransition::getSynchronizationSlop() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return slop_;
+}
+
+void InputTransition::setSynchronizationBufferSize(std::size_t size)
+{
+    apex_assert_hard(size >= 1);
+
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    buffer_size_ = size;
+}
+
+std::size_t InputTransition::getSynchronizationBufferSize() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return buffer_size_;
+}
+
+void InputTransition::setPrimaryInput(const InputPtr& input)
+{
+    apex_assert_hard(input);
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (primary_ == input.get()) {
+            return;
+        }
+        primary_ = input.get();
+        buffers_.erase(primary_);
+    }
+
+    // the previous primary input is sampled from now on
+    for (auto pair : inputs_) {
+        for (const ConnectionPtr& connection : pair.second->getConnections()) {
+            takeToken(pair.second.get(), connection.get());
+        }
+    }
+    checkIfEnabled();
+}
+
+InputPtr InputTransition::getPrimaryInput() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    for (const auto& pair : inputs_) {
+        if (pair.second.get() == primary_) {
+            return pair.second;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t InputTransition::countDroppedTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    return dropped_;
+}
+
+bool InputTransition::isSynchronizing() const
+{
+    // without connections, the inputs are handled the same way for all policies
+    return policy_ != InputSyncPolicy::SEQUENCE && hasConnection();
+}
+
+bool InputTransition::isBuffered(Input* input) const
+{
+    switch (policy_) {
+        case InputSyncPolicy::APPROXIMATE_TIME:
+            return true;
+        case InputSyncPolicy::LATEST_VALUE:
+            return input != primary_;
+        default:
+            return false;
+    }
+}
+
+void InputTransition::takeToken(Input* input, Connection* connection)
+{
+    if (policy_ == InputSyncPolicy::SEQUENCE) {
+        // nothing is buffered, the connections hold the tokens
+        return;
+    }
+
+    {
+        std::unique_lock<std::recursive_mutex> lock(sync);
+        if (!isBuffered(input) || !connection->isEnabled() || connection->getState() != Connection::State::UNREAD) {
+            return;
+        }
+
+        TokenPtr token = connection->readToken();
+        std::deque<TokenPtr>& buffer = buffers_[input];
+        if (policy_ == InputSyncPolicy::LATEST_VALUE) {
+            // markers carry no value to sample
+            if (!isMarker(token)) {
+                buffer.clear();
+                buffer.push_back(token);
+            }
+
+        } else {
+            buffer.push_back(token);
+            if (buffer.size() > buffer_size_) {
+                buffer.pop_front();
+                ++dropped_;
+            }
+            if (match_.empty()) {
+                findApproximateMatch();
+            }
+        }
+    }
+
+    // the producer can continue right away, the token is kept in the buffer
+    connection->setTokenProcessed();
+}
+
+bool InputTransition::findApproximateMatch()
+{
+    apex_assert_hard(match_.empty());
+
+    std::vector<Input*> inputs;
+    for (const auto& pair : inputs_) {
+        if (pair.second->hasEnabledConnection()) {
+            inputs.push_back(pair.second.get());
+        }
+    }
+    if (inputs.empty()) {
+        return false;
+    }
+
+    // markers carry no stamp, they are forwarded on their own
+    for (Input* input : inputs) {
+        std::deque<TokenPtr>& buffer = buffers_[input];
+        if (!buffer.empty() && !std::dynamic_pointer_cast<connection_types::Message const>(buffer.front()->getTokenData())) {
+            match_[input] = buffer.front();
+            buffer.pop_front();
+            return true;
+        }
+    }
+
+    while (true) {
+        Input* oldest = nullptr;
+        connection_types::Message::Stamp oldest_stamp = 0;
+        connection_types::Message::Stamp newest_stamp = 0;
+        for (Input* input : inputs) {
+            std::deque<TokenPtr>& buffer = buffers_[input];
+            if (buffer.empty()) {
+                return false;
+            }
+            auto message = std::dynamic_pointer_cast<connection_types::Message const>(buffer.front()->getTokenData());
+            if (!message) {
+                // a marker moved up
+                return findApproximateMatch();
+            }
+
+            connection_types::Message::Stamp stamp = message->stamp_micro_seconds;
+            if (!oldest || stamp < oldest_stamp) {
+                oldest = input;
+                oldest_stamp = stamp;
+            }
+            newest_stamp = std::max(newest_stamp, stamp);
+        }
+
+        if (newest_stamp - oldest_stamp <= slop_) {
+            for (Input* input : inputs) {
+                match_[input] = buffers_[input].front();
+                buffers_[input].pop_front();
+            }
+            return true;
+        }
+
+        // all later tokens of the newest input are even newer, so the oldest token cannot be matched anymore
+        buffers_[oldest].pop_front();
+        ++dropped_;
+    }
+}
+
+bool InputTransition::isPrimaryReady() const
+{
+    if (!primary_ || !primary_->hasEnabledConnection()) {
+        return false;
+    }
+
+    for (const ConnectionPtr& connection : primary_->getConnections()) {
+        if (connection->isEnabled() && connection->getState() != Connection::State::UNREAD) {
+            return false;
+        }
+    }
+
+    // every sampled input needs a first value
+    for (const auto& pair : inputs_) {
+        Input* input = pair.second.get();
+        if (input != primary_ && input->hasEnabledConnection()) {
+            auto pos = buffers_.find(input);
+            if (pos == buffers_.end() || pos->second.empty()) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
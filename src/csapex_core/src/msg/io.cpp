@@ -6,6 +6,7 @@
 #include <csapex/msg/output.h>
 #include <csapex/signal/event.h>
 #include <csapex/model/token.h>
+#include <csapex/model/replica_context.h>
 
 using namespace csapex;
 
@@ -17,12 +18,22 @@ TokenDataConstPtr csapex::msg::getMessage(Input* input)
     return token->getTokenData();
 }
 
+void csapex::msg::recordCopy(Input* input)
+{
+    input->getCopyCounter()->increment();
+}
+
 bool csapex::msg::hasMessage(Input* input)
 {
     return input->hasMessage() && input->isEnabled();
 }
 bool csapex::msg::hasMessage(Output* output)
 {
+    if (ReplicaContext* context = ReplicaContext::current()) {
+        if (context->hasOutput(output)) {
+            return context->getOutputToken(output) != nullptr && output->isEnabled();
+        }
+    }
     return output->hasMessage() && output->isEnabled();
 }
 
@@ -97,7 +108,13 @@ MessageAllocator& csapex::msg::getMessageAllocator(Output* output)
 
 void csapex::msg::publish(Output* output, TokenDataConstPtr message)
 {
-    output->addMessage(std::make_shared<Token>(message));
+    if (ReplicaContext* context = ReplicaContext::current()) {
+        if (context->hasOutput(output)) {
+            context->setOutputToken(output, output->allocateEnvelope<Token>(message));
+            return;
+        }
+    }
+    output->addMessage(output->allocateEnvelope<Token>(message));
 }
 
 void csapex::msg::trigger(Event* event)
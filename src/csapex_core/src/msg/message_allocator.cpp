@@ -11,3 +11,31 @@ MessageAllocator::~MessageAllocator()
 {
     delete allocator_;
 }
+
+void MessageAllocator::enablePooling(Counter::Ptr hits, Counter::Ptr misses)
+{
+    auto stats = std::make_shared<MessagePool::Statistics>();
+    stats->hits = hits ? hits : std::make_shared<Counter>("pool hits");
+    stats->misses = misses ? misses : std::make_shared<Counter>("pool misses");
+    pool_stats_ = stats;
+}
+
+void MessageAllocator::disablePooling()
+{
+    pool_stats_.reset();
+}
+
+bool MessageAllocator::isPooling() const
+{
+    return pool_stats_ != nullptr;
+}
+
+Counter::Ptr MessageAllocator::getPoolHits() const
+{
+    return pool_stats_ ? pool_stats_->hits : nullptr;
+}
+
+Counter::Ptr MessageAllocator::getPoolMisses() const
+{
+    return pool_stats_ ? pool_stats_->misses : nullptr;
+}
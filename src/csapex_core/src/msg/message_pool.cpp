@@ -0,0 +1,157 @@
+/// HEADER
+#include <csapex/msg/message_pool.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+using namespace csapex;
+
+namespace
+{
+// every thread caches this many blocks per size before handing a batch to the shared list
+constexpr std::size_t THREAD_CACHE_LIMIT = 256;
+constexpr std::size_t BATCH_SIZE = 64;
+
+constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+struct Block
+{
+    Block* next;
+};
+
+std::size_t blockSize(std::size_t bytes)
+{
+    bytes = std::max(bytes, sizeof(Block));
+    return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+struct FreeList
+{
+    Block* head = nullptr;
+    std::size_t count = 0;
+
+    void push(Block* block)
+    {
+        block->next = head;
+        head = block;
+        ++count;
+    }
+
+    Block* pop()
+    {
+        Block* block = head;
+        if (block) {
+            head = block->next;
+            --count;
+        }
+        return block;
+    }
+
+    void moveTo(FreeList& other, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n && head; ++i) {
+            other.push(pop());
+        }
+    }
+};
+
+class SharedPool
+{
+public:
+    static SharedPool& instance()
+    {
+        // never destroyed, exiting threads still flush their caches during static destruction
+        static SharedPool* pool = new SharedPool;
+        return *pool;
+    }
+
+    void put(std::size_t size, FreeList& from, std::size_t n)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        from.moveTo(lists_[size], n);
+    }
+
+    void take(std::size_t size, FreeList& to, std::size_t n)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = lists_.find(size);
+        if (pos != lists_.end()) {
+            pos->second.moveTo(to, n);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::size_t, FreeList> lists_;
+};
+
+class ThreadCache
+{
+public:
+    ThreadCache()
+    {
+        // make sure the shared pool is constructed before this cache
+        SharedPool::instance();
+    }
+
+    ~ThreadCache()
+    {
+        for (auto& pair : lists_) {
+            SharedPool::instance().put(pair.first, pair.second, pair.second.count);
+        }
+    }
+
+    FreeList& get(std::size_t size)
+    {
+        return lists_[size];
+    }
+
+private:
+    std::unordered_map<std::size_t, FreeList> lists_;
+};
+
+thread_local ThreadCache g_thread_cache;
+
+}  // namespace
+
+void* MessagePool::allocate(std::size_t bytes, const Statistics* stats)
+{
+    std::size_t size = blockSize(bytes);
+
+    FreeList& list = g_thread_cache.get(size);
+    if (!list.head) {
+        SharedPool::instance().take(size, list, BATCH_SIZE);
+    }
+
+    if (Block* block = list.pop()) {
+        if (stats && stats->hits) {
+            stats->hits->increment();
+        }
+        return block;
+    }
+
+    if (stats && stats->misses) {
+        stats->misses->increment();
+    }
+    return ::operator new(size);
+}
+
+void MessagePool::deallocate(void* block, std::size_t bytes)
+{
+    if (!block) {
+        return;
+    }
+
+    std::size_t size = blockSize(bytes);
+
+    FreeList& list = g_thread_cache.get(size);
+    list.push(static_cast<Block*>(block));
+
+    if (list.count > THREAD_CACHE_LIMIT) {
+        SharedPool::instance().put(size, list, BATCH_SIZE);
+    }
+}
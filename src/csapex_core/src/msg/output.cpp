@@ -64,7 +64,7 @@ void Output::notifyMessageProcessed()
         processing_lock.unlock();
 
         for (const ConnectionPtr& connection : connections_) {
-            apex_assert_hard(connection->getState() == Connection::State::DONE);
+            apex_assert_hard(connection->canReceiveToken());
         }
         message_processed(shared_from_this());
     } else {
@@ -93,7 +93,7 @@ void Output::notifyMessageProcessed(Connection* connection)
 //     }
 
     for (auto connection : connections_) {
-        if (connection->getState() != Connection::State::DONE) {
+        if (!connection->canReceiveToken()) {
             // std::cerr << getUUID() << " :::: " << *connection << "-> is not yet done " << std::endl;
             return;
         }
@@ -181,7 +181,7 @@ bool Output::isConnected() const
 bool Output::canReceiveToken() const
 {
     for (const ConnectionPtr& connection : connections_) {
-        if (connection->getState() != Connection::State::NOT_INITIALIZED) {
+        if (!connection->canReceiveToken()) {
             return false;
         }
     }
@@ -232,6 +232,15 @@ void Output::publish()
         // std::cerr << getUUID() << " :::: "
         //           << "is notified processed in publish because no message is sent" << std::endl;
         notifyMessageProcessed();
+
+    } else {
+        // buffered connections can accept the token without waiting for the consumer
+        for (auto connection : connections_) {
+            if (!connection->canReceiveToken()) {
+                return;
+            }
+        }
+        notifyMessageProcessed();
     }
 }
 
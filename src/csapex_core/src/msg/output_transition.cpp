@@ -145,14 +145,14 @@ bool OutputTransition::canStartSendingMessages() const
             }
         }
     }
-    return areAllConnections(Connection::State::DONE, Connection::State::NOT_INITIALIZED);
+    return canAllConnectionsReceiveTokens();
 }
 
 bool OutputTransition::sendMessages(bool is_active)
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
 
-    apex_assert_hard(areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(canAllConnectionsReceiveTokens());
 
     bool has_sent_activator_message = false;
 
@@ -188,7 +188,7 @@ bool OutputTransition::sendMessages(bool is_active)
 void OutputTransition::tokenProcessed()
 {
     std::unique_lock<std::recursive_mutex> lock(sync);
-    if (!areAllConnections(Connection::State::DONE)) {
+    if (!canAllConnectionsReceiveTokens()) {
         // if (!outputs_.empty()) {
         //     std::cerr << outputs_.begin()->second->getUUID() << ": cannot publish next, not all connections are done:" << std::endl;
         //     for (const ConnectionPtr& connection : connections_) {
@@ -210,7 +210,7 @@ void OutputTransition::tokenProcessed()
         return;
     }
 
-    apex_assert_hard(areAllConnections(Connection::State::DONE));
+    apex_assert_hard(canAllConnectionsReceiveTokens());
 
     APEX_DEBUG_CERR << "all outputs are done" << std::endl;
 
@@ -236,6 +236,17 @@ bool OutputTransition::areOutputsIdle() const
     return true;
 }
 
+bool OutputTransition::canAllConnectionsReceiveTokens() const
+{
+    std::unique_lock<std::recursive_mutex> lock(sync);
+    for (const ConnectionPtr& connection : connections_) {
+        if (connection->isEnabled() && !connection->canReceiveToken()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int OutputTransition::getPortCount() const
 {
     return outputs_.size();
@@ -252,7 +263,7 @@ void OutputTransition::fillConnections()
         return;
     }
 
-    apex_assert_hard(areAllConnections(Connection::State::NOT_INITIALIZED));
+    apex_assert_hard(canAllConnectionsReceiveTokens());
 
     for (const auto& pair : outputs_) {
         OutputPtr out = pair.second;
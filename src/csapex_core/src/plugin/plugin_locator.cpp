@@ -11,6 +11,7 @@
 #include <boost/algorithm/string.hpp>
 #include <fstream>
 #include <thread>
+#include <iomanip>
 #include <iostream>
 
 using namespace csapex;
@@ -125,3 +126,25 @@ std::vector<std::string> PluginLocator::getPluginPaths(const std::string& type)
         return {};
     }
 }
+
+void PluginLocator::reportLoadTime(const std::string& name, double milliseconds, const std::string& details)
+{
+    std::unique_lock<std::mutex> lock(load_times_mutex_);
+    load_times_.push_back(LoadTime{ name, milliseconds, details });
+}
+
+void PluginLocator::printLoadReport(std::ostream& out) const
+{
+    std::unique_lock<std::mutex> lock(load_times_mutex_);
+    double total = 0.0;
+    out << "[Plugin] load report:\n";
+    for (const LoadTime& entry : load_times_) {
+        out << "  " << std::setw(9) << std::fixed << std::setprecision(2) << entry.milliseconds << " ms  " << entry.name;
+        if (!entry.details.empty()) {
+            out << " (" << entry.details << ")";
+        }
+        out << '\n';
+        total += entry.milliseconds;
+    }
+    out << "  " << std::setw(9) << std::fixed << std::setprecision(2) << total << " ms  total" << std::endl;
+}
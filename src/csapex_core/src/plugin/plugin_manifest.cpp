@@ -0,0 +1,277 @@
+/// HEADER
+#include <csapex/plugin/plugin_manifest.h>
+
+/// PROJECT
+#include <csapex/core/settings.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#if WIN32
+#define TIXML_USE_STL
+#include <tinyxml/tinyxml.h>
+#else
+#include <tinyxml.h>
+#endif
+#include <yaml-cpp/yaml.h>
+#include <boost/filesystem.hpp>
+#include <boost/version.hpp>
+#if (BOOST_VERSION / 100000) >= 1 && (BOOST_VERSION / 100 % 1000) >= 54
+namespace bf3 = boost::filesystem;
+#else
+namespace bf3 = boost::filesystem3;
+#endif
+
+using namespace csapex;
+
+namespace
+{
+std::string readAttribute(const TiXmlElement* element, const char* name)
+{
+    const char* value = element->Attribute(name);
+    return value ? std::string(value) : std::string();
+}
+
+std::string readString(TiXmlElement* element, const char* name)
+{
+    TiXmlElement* child = element->FirstChildElement(name);
+    if (child && child->GetText()) {
+        return child->GetText();
+    }
+    return std::string();
+}
+
+std::time_t lastModification(const std::string& file)
+{
+    boost::system::error_code ec;
+    std::time_t stamp = bf3::last_write_time(file, ec);
+    return ec ? 0 : stamp;
+}
+}  // namespace
+
+PluginManifest::PluginManifest() : last_modification(0), valid(false)
+{
+}
+
+PluginManifest PluginManifest::parse(const std::string& file)
+{
+    PluginManifest manifest;
+    manifest.file = file;
+
+    if (!bf3::exists(file)) {
+        return manifest;
+    }
+    manifest.last_modification = lastModification(file);
+
+    TiXmlDocument document;
+    document.LoadFile(file);
+    TiXmlElement* config = document.RootElement();
+    if (config == nullptr) {
+        std::cerr << "[Plugin] Cannot load the file " << file << std::endl;
+        return manifest;
+    }
+
+    TiXmlElement* library = config;
+    if (library->ValueStr() != "library") {
+        library = library->NextSiblingElement("library");
+    }
+    for (; library != nullptr; library = library->NextSiblingElement("library")) {
+        Library entry;
+        entry.path = readAttribute(library, "path");
+        if (entry.path.empty()) {
+            std::cerr << "[Plugin] Item in row" << library->Row() << " does not contain a path attribute" << std::endl;
+            continue;
+        }
+
+        for (TiXmlElement* class_element = library->FirstChildElement("class"); class_element != nullptr; class_element = class_element->NextSiblingElement("class")) {
+            Class c;
+            c.base_class_type = readAttribute(class_element, "base_class_type");
+            c.type = readAttribute(class_element, "type");
+            c.lookup_name = class_element->Attribute("name") != nullptr ? readAttribute(class_element, "name") : c.type;
+            c.description = readString(class_element, "description");
+            c.icon = readString(class_element, "icon");
+            c.tags = readString(class_element, "tags");
+            entry.classes.push_back(c);
+        }
+
+        manifest.libraries.push_back(entry);
+    }
+
+    manifest.valid = true;
+    return manifest;
+}
+
+PluginManifestCache::Statistics::Statistics() : parsed(0), cached(0), milliseconds(0.0)
+{
+}
+
+PluginManifestCache& PluginManifestCache::instance()
+{
+    static PluginManifestCache cache(Settings::defaultConfigPath() + "cache/plugin_manifests.yaml");
+    return cache;
+}
+
+PluginManifestCache::PluginManifestCache(const std::string& cache_file) : cache_file_(cache_file), cache_read_(false)
+{
+}
+
+std::vector<PluginManifest> PluginManifestCache::load(const std::vector<std::string>& files, Statistics* statistics)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cache_read_) {
+        readCache();
+        cache_read_ = true;
+    }
+
+    std::vector<PluginManifest> result(files.size());
+    std::vector<std::size_t> outdated;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        auto pos = manifests_.find(files[i]);
+        if (pos != manifests_.end() && pos->second.valid && pos->second.last_modification == lastModification(files[i])) {
+            result[i] = pos->second;
+        } else {
+            outdated.push_back(i);
+        }
+    }
+
+    if (!outdated.empty()) {
+        // parsing is independent for every file, the workers take the next file until all are done
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            for (std::size_t job = next++; job < outdated.size(); job = next++) {
+                std::size_t index = outdated[job];
+                result[index] = PluginManifest::parse(files[index]);
+            }
+        };
+
+        std::size_t thread_count = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), outdated.size());
+        std::vector<std::thread> threads;
+        for (std::size_t t = 1; t < thread_count; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (std::size_t index : outdated) {
+            if (result[index].valid) {
+                manifests_[files[index]] = result[index];
+            } else {
+                manifests_.erase(files[index]);
+            }
+        }
+        writeCache();
+    }
+
+    if (statistics) {
+        statistics->parsed += outdated.size();
+        statistics->cached += files.size() - outdated.size();
+        statistics->milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    return result;
+}
+
+void PluginManifestCache::readCache()
+{
+    if (!bf3::exists(cache_file_)) {
+        return;
+    }
+
+    try {
+        YAML::Node doc = YAML::LoadFile(cache_file_);
+        if (doc.Type() != YAML::NodeType::Sequence) {
+            return;
+        }
+
+        for (const YAML::Node& node : doc) {
+            PluginManifest manifest;
+            manifest.file = node["file"].as<std::string>();
+            manifest.last_modification = node["modification"].as<std::time_t>();
+            manifest.valid = true;
+
+            for (const YAML::Node& library_node : node["libraries"]) {
+                PluginManifest::Library library;
+                library.path = library_node["path"].as<std::string>();
+                for (const YAML::Node& class_node : library_node["classes"]) {
+                    PluginManifest::Class c;
+                    c.base_class_type = class_node["base_class_type"].as<std::string>();
+                    c.type = class_node["type"].as<std::string>();
+                    c.lookup_name = class_node["name"].as<std::string>();
+                    c.description = class_node["description"].as<std::string>();
+                    c.icon = class_node["icon"].as<std::string>();
+                    c.tags = class_node["tags"].as<std::string>();
+                    library.classes.push_back(c);
+                }
+                manifest.libraries.push_back(library);
+            }
+
+            manifests_[manifest.file] = manifest;
+        }
+
+    } catch (const YAML::Exception& e) {
+        // a broken cache only means that all manifests are parsed again
+        std::cerr << "[Plugin] Cannot read the manifest cache " << cache_file_ << ": " << e.what() << std::endl;
+        manifests_.clear();
+    }
+}
+
+void PluginManifestCache::writeCache()
+{
+    YAML::Node doc(YAML::NodeType::Sequence);
+    for (const auto& entry : manifests_) {
+        const PluginManifest& manifest = entry.second;
+
+        YAML::Node node;
+        node["file"] = manifest.file;
+        node["modification"] = manifest.last_modification;
+
+        YAML::Node libraries(YAML::NodeType::Sequence);
+        for (const PluginManifest::Library& library : manifest.libraries) {
+            YAML::Node library_node;
+            library_node["path"] = library.path;
+
+            YAML::Node classes(YAML::NodeType::Sequence);
+            for (const PluginManifest::Class& c : library.classes) {
+                YAML::Node class_node;
+                class_node["base_class_type"] = c.base_class_type;
+                class_node["type"] = c.type;
+                class_node["name"] = c.lookup_name;
+                class_node["description"] = c.description;
+                class_node["icon"] = c.icon;
+                class_node["tags"] = c.tags;
+                classes.push_back(class_node);
+            }
+            library_node["classes"] = classes;
+            libraries.push_back(library_node);
+        }
+        node["libraries"] = libraries;
+
+        doc.push_back(node);
+    }
+
+    try {
+        bf3::path file(cache_file_);
+        bf3::create_directories(file.parent_path());
+
+        // other processes might read the cache at the same time, so it is replaced atomically
+        bf3::path tmp_file = bf3::unique_path(cache_file_ + ".%%%%%%.tmp");
+        {
+            std::ofstream ofs(tmp_file.string().c_str());
+            YAML::Emitter yaml;
+            yaml << doc;
+            ofs << yaml.c_str();
+        }
+        bf3::rename(tmp_file, file);
+
+    } catch (const std::exception& e) {
+        std::cerr << "[Plugin] Cannot write the manifest cache " << cache_file_ << ": " << e.what() << std::endl;
+    }
+}
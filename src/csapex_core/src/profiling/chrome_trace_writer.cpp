@@ -0,0 +1,141 @@
+/// HEADER
+#include <csapex/profiling/chrome_trace_writer.h>
+
+/// SYSTEM
+#include <cstdio>
+
+using namespace csapex;
+
+namespace
+{
+std::string escape(const std::string& name)
+{
+    std::string result;
+    result.reserve(name.size());
+    for (char c : name) {
+        switch (c) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", c);
+                    result += code;
+                } else {
+                    result += c;
+                }
+        }
+    }
+    return result;
+}
+
+/// the trace event format expects microseconds
+std::string toMicroseconds(uint64_t ns)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000), static_cast<unsigned long long>(ns % 1000));
+    return buffer;
+}
+
+}  // namespace
+
+ChromeTraceWriter::ChromeTraceWriter(const std::string& file, std::chrono::milliseconds collect_interval)
+  : out_(file), first_event_(true), collect_interval_(collect_interval), running_(true)
+{
+    out_ << "[\n";
+
+    connection_ = TraceCollector::instance().spans_collected.connect([this](const std::vector<TraceSpan>& spans) { write(spans); });
+
+    collector_ = std::thread([this]() { collectLoop(); });
+}
+
+ChromeTraceWriter::~ChromeTraceWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(running_mutex_);
+        running_ = false;
+        running_changed_.notify_all();
+    }
+    collector_.join();
+
+    flush();
+    connection_.disconnect();
+
+    std::unique_lock<std::mutex> lock(file_mutex_);
+    out_ << "\n]\n";
+}
+
+bool ChromeTraceWriter::isOpen() const
+{
+    return out_.is_open();
+}
+
+void ChromeTraceWriter::flush()
+{
+    TraceCollector::instance().collect();
+
+    std::unique_lock<std::mutex> lock(file_mutex_);
+    out_.flush();
+}
+
+void ChromeTraceWriter::collectLoop()
+{
+    std::unique_lock<std::mutex> lock(running_mutex_);
+    while (running_) {
+        running_changed_.wait_for(lock, collect_interval_);
+        if (running_) {
+            lock.unlock();
+            TraceCollector::instance().collect();
+            lock.lock();
+        }
+    }
+}
+
+void ChromeTraceWriter::write(const std::vector<TraceSpan>& spans)
+{
+    std::unique_lock<std::mutex> lock(file_mutex_);
+
+    for (const TraceSpan& span : spans) {
+        if (named_threads_.insert(span.thread).second) {
+            out_ << (first_event_ ? "" : ",\n") << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << span.thread << R"(,"args":{"name":"thread )" << span.thread << R"("}})";
+            first_event_ = false;
+        }
+
+        std::string name = escape(TraceBuffer::getName(span.name));
+        switch (span.type) {
+            case TraceType::SPAN:
+                writeEvent(span, "X", name, span.begin_ns);
+                out_ << R"(,"dur":)" << toMicroseconds(span.end_ns - span.begin_ns) << "}";
+                break;
+            case TraceType::WAIT:
+                writeEvent(span, "b", name, span.begin_ns);
+                out_ << R"(,"id":")" << span.id << R"("})";
+                writeEvent(span, "e", name, span.end_ns);
+                out_ << R"(,"id":")" << span.id << R"("})";
+                break;
+            case TraceType::FLOW_BEGIN:
+                writeEvent(span, "s", name, span.begin_ns);
+                out_ << R"(,"id":")" << span.id << R"("})";
+                break;
+            case TraceType::FLOW_END:
+                writeEvent(span, "f", name, span.begin_ns);
+                out_ << R"(,"id":")" << span.id << R"(","bp":"e"})";
+                break;
+        }
+    }
+}
+
+void ChromeTraceWriter::writeEvent(const TraceSpan& span, const char* phase, const std::string& name, uint64_t ts_ns)
+{
+    if (!first_event_) {
+        out_ << ",\n";
+    }
+    first_event_ = false;
+
+    const char* category = span.type == TraceType::SPAN ? "span" : span.type == TraceType::WAIT ? "wait" : "flow";
+    out_ << R"({"name":")" << name << R"(","cat":")" << category << R"(","ph":")" << phase << R"(","pid":1,"tid":)" << span.thread << R"(,"ts":)" << toMicroseconds(ts_ns);
+}
@@ -0,0 +1,28 @@
+/// HEADER
+#include <csapex/profiling/counter.h>
+
+using namespace csapex;
+
+Counter::Counter(const std::string& name) : name_(name), value_(0)
+{
+}
+
+std::string Counter::getName() const
+{
+    return name_;
+}
+
+void Counter::increment(std::size_t n)
+{
+    value_.fetch_add(n, std::memory_order_relaxed);
+}
+
+void Counter::reset()
+{
+    value_ = 0;
+}
+
+std::size_t Counter::get() const
+{
+    return value_.load(std::memory_order_relaxed);
+}
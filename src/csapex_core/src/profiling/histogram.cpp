@@ -0,0 +1,80 @@
+/// HEADER
+#include <csapex/profiling/histogram.h>
+
+/// SYSTEM
+#include <algorithm>
+
+using namespace csapex;
+
+Histogram::Histogram(const std::string& name) : name_(name)
+{
+    reset();
+}
+
+std::string Histogram::getName() const
+{
+    return name_;
+}
+
+void Histogram::add(std::chrono::nanoseconds value)
+{
+    long long ns = std::max<long long>(0, value.count());
+
+    ++buckets_[getBucket(value)];
+    ++count_;
+    sum_ns_ += ns;
+
+    long long max = max_ns_;
+    while (ns > max && !max_ns_.compare_exchange_weak(max, ns)) {
+    }
+}
+
+void Histogram::reset()
+{
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        buckets_[i] = 0;
+    }
+    count_ = 0;
+    sum_ns_ = 0;
+    max_ns_ = 0;
+}
+
+std::size_t Histogram::count() const
+{
+    return count_;
+}
+
+std::size_t Histogram::getBucketCount(std::size_t bucket) const
+{
+    return bucket < BUCKETS ? buckets_[bucket].load() : 0;
+}
+
+std::chrono::nanoseconds Histogram::getMaximum() const
+{
+    return std::chrono::nanoseconds(max_ns_);
+}
+
+std::chrono::nanoseconds Histogram::getMean() const
+{
+    std::size_t n = count_;
+    return std::chrono::nanoseconds(n > 0 ? sum_ns_ / static_cast<long long>(n) : 0);
+}
+
+std::size_t Histogram::getBucket(std::chrono::nanoseconds value)
+{
+    long long us = std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+    std::size_t bucket = 0;
+    while (us > 0 && bucket < BUCKETS - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+std::chrono::microseconds Histogram::getBucketUpperBound(std::size_t bucket)
+{
+    if (bucket >= BUCKETS - 1) {
+        return std::chrono::microseconds::max();
+    }
+    return std::chrono::microseconds(1ll << bucket);
+}
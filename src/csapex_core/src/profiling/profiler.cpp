@@ -32,6 +32,51 @@ const Profile& Profiler::getProfile(const std::string& key)
     return pos->second;
 }
 
+Histogram::Ptr Profiler::getHistogram(const std::string& key)
+{
+    std::unique_lock<std::mutex> lock(histograms_mutex_);
+    Histogram::Ptr& histogram = histograms_[key];
+    if (!histogram) {
+        histogram = std::make_shared<Histogram>(key);
+    }
+    return histogram;
+}
+
+std::vector<Histogram::Ptr> Profiler::getHistograms() const
+{
+    std::vector<Histogram::Ptr> result;
+    std::unique_lock<std::mutex> lock(histograms_mutex_);
+    for (const auto& pair : histograms_) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+Counter::Ptr Profiler::getCounter(const std::string& key)
+{
+    std::unique_lock<std::mutex> lock(counters_mutex_);
+    Counter::Ptr& counter = counters_[key];
+    if (!counter) {
+        counter = std::make_shared<Counter>(key);
+    }
+    return counter;
+}
+
+std::vector<Counter::Ptr> Profiler::getCounters() const
+{
+    std::vector<Counter::Ptr> result;
+    std::unique_lock<std::mutex> lock(counters_mutex_);
+    for (const auto& pair : counters_) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+TraceStatistics Profiler::getTraceStatistics(const std::string& key) const
+{
+    return TraceCollector::instance().getStatistics(key);
+}
+
 void Profiler::setEnabled(bool enabled)
 {
     if (enabled == enabled_) {
@@ -59,4 +104,16 @@ void Profiler::reset()
         Profile& profile = pair.second;
         profile.reset();
     }
+
+    {
+        std::unique_lock<std::mutex> lock(histograms_mutex_);
+        for (auto& pair : histograms_) {
+            pair.second->reset();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(counters_mutex_);
+    for (auto& pair : counters_) {
+        pair.second->reset();
+    }
 }
@@ -0,0 +1,255 @@
+/// HEADER
+#include <csapex/profiling/trace_buffer.h>
+
+/// SYSTEM
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+using namespace csapex;
+
+namespace
+{
+class NameTable
+{
+public:
+    static NameTable& instance()
+    {
+        // never destroyed, threads may still record during static destruction
+        static NameTable* table = new NameTable;
+        return *table;
+    }
+
+    uint32_t intern(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = ids_.find(name);
+        if (pos != ids_.end()) {
+            return pos->second;
+        }
+        uint32_t id = names_.size();
+        names_.push_back(name);
+        ids_.emplace(name, id);
+        return id;
+    }
+
+    std::string getName(uint32_t id)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : std::string();
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::string> names_;
+};
+
+class BufferRegistry
+{
+public:
+    static BufferRegistry& instance()
+    {
+        static BufferRegistry* registry = new BufferRegistry;
+        return *registry;
+    }
+
+    TraceBuffer::Ptr create()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        TraceBuffer::Ptr buffer = std::make_shared<TraceBuffer>(next_index_++);
+        buffers_.push_back(buffer);
+        return buffer;
+    }
+
+    void retire(const TraceBuffer::Ptr& buffer)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (buffer->countUnread() == 0) {
+            // nothing left to collect
+            remove(buffer);
+            return;
+        }
+
+        // the buffer is handed out a last time, unless no one collects until too many threads have finished
+        retired_.push_back(buffer);
+        if (retired_.size() > TraceBuffer::MAX_RETIRED_BUFFERS) {
+            TraceBuffer::Ptr oldest = retired_.front();
+            retired_.erase(retired_.begin());
+            discarded_ += oldest->countUnread();
+            remove(oldest);
+        }
+    }
+
+    std::vector<TraceBuffer::Ptr> getBuffers()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::vector<TraceBuffer::Ptr> result = buffers_;
+        // buffers of finished threads are handed out a last time
+        for (const TraceBuffer::Ptr& buffer : retired_) {
+            remove(buffer);
+        }
+        retired_.clear();
+        return result;
+    }
+
+    std::size_t takeDiscardedRecordCount()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        std::size_t discarded = discarded_;
+        discarded_ = 0;
+        return discarded;
+    }
+
+    std::size_t count()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return buffers_.size();
+    }
+
+private:
+    void remove(const TraceBuffer::Ptr& buffer)
+    {
+        buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), buffer), buffers_.end());
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<TraceBuffer::Ptr> buffers_;
+    std::vector<TraceBuffer::Ptr> retired_;
+    std::size_t next_index_ = 0;
+    std::size_t discarded_ = 0;
+};
+
+}  // namespace
+
+namespace csapex
+{
+struct ThreadTraceBuffer
+{
+    ~ThreadTraceBuffer()
+    {
+        if (buffer) {
+            buffer->retired_ = true;
+            BufferRegistry::instance().retire(buffer);
+        }
+    }
+
+    TraceBuffer* get()
+    {
+        if (!buffer) {
+            buffer = BufferRegistry::instance().create();
+        }
+        return buffer.get();
+    }
+
+    TraceBuffer::Ptr buffer;
+};
+}  // namespace csapex
+
+namespace
+{
+thread_local ThreadTraceBuffer g_thread_buffer;
+}
+
+uint32_t TraceBuffer::intern(const std::string& name)
+{
+    return NameTable::instance().intern(name);
+}
+
+std::string TraceBuffer::getName(uint32_t id)
+{
+    return NameTable::instance().getName(id);
+}
+
+uint64_t TraceBuffer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TraceBuffer::record(uint32_t name, uint64_t begin_ns, uint64_t end_ns)
+{
+    g_thread_buffer.get()->push(TraceType::SPAN, name, begin_ns, end_ns, 0);
+}
+
+void TraceBuffer::record(TraceType type, uint32_t name, uint64_t begin_ns, uint64_t end_ns, uint64_t id)
+{
+    g_thread_buffer.get()->push(type, name, begin_ns, end_ns, id);
+}
+
+std::vector<TraceBuffer::Ptr> TraceBuffer::getBuffers()
+{
+    return BufferRegistry::instance().getBuffers();
+}
+
+std::size_t TraceBuffer::countBuffers()
+{
+    return BufferRegistry::instance().count();
+}
+
+std::size_t TraceBuffer::takeDiscardedRecordCount()
+{
+    return BufferRegistry::instance().takeDiscardedRecordCount();
+}
+
+TraceBuffer::TraceBuffer(std::size_t thread_index) : head_(0), tail_(0), thread_index_(thread_index), retired_(false)
+{
+}
+
+std::size_t TraceBuffer::getThreadIndex() const
+{
+    return thread_index_;
+}
+
+bool TraceBuffer::isRetired() const
+{
+    return retired_;
+}
+
+std::size_t TraceBuffer::countUnread() const
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    return std::min<uint64_t>(head - tail, CAPACITY);
+}
+
+void TraceBuffer::push(TraceType type, uint32_t name, uint64_t begin_ns, uint64_t end_ns, uint64_t id)
+{
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[head % CAPACITY];
+    slot.name.store((static_cast<uint64_t>(type) << 32) | name, std::memory_order_relaxed);
+    slot.begin_ns.store(begin_ns, std::memory_order_relaxed);
+    slot.end_ns.store(end_ns, std::memory_order_relaxed);
+    slot.id.store(id, std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+}
+
+std::size_t TraceBuffer::read(std::vector<TraceRecord>& out)
+{
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t first = std::max<uint64_t>(tail, head > CAPACITY ? head - CAPACITY : 0);
+
+    std::size_t offset = out.size();
+    for (uint64_t i = first; i < head; ++i) {
+        const Slot& slot = slots_[i % CAPACITY];
+        uint64_t name = slot.name.load(std::memory_order_relaxed);
+        out.push_back(TraceRecord{ static_cast<TraceType>(name >> 32), static_cast<uint32_t>(name), slot.begin_ns.load(std::memory_order_relaxed), slot.end_ns.load(std::memory_order_relaxed),
+                                   slot.id.load(std::memory_order_relaxed) });
+    }
+
+    // the writer may have lapped us while copying, those records are torn
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t current = head_.load(std::memory_order_relaxed);
+    uint64_t first_valid = current + 1 > CAPACITY ? current + 1 - CAPACITY : 0;
+    if (first_valid > first) {
+        std::size_t torn = std::min<uint64_t>(first_valid, head) - first;
+        out.erase(out.begin() + offset, out.begin() + offset + torn);
+        first += torn;
+    }
+
+    std::size_t lost = first - tail;
+    tail_.store(head, std::memory_order_release);
+    return lost;
+}
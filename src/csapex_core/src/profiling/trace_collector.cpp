@@ -0,0 +1,95 @@
+/// HEADER
+#include <csapex/profiling/trace_collector.h>
+
+using namespace csapex;
+
+std::chrono::nanoseconds TraceStatistics::mean() const
+{
+    return count > 0 ? total / static_cast<std::chrono::nanoseconds::rep>(count) : std::chrono::nanoseconds(0);
+}
+
+TraceCollector& TraceCollector::instance()
+{
+    static TraceCollector collector;
+    return collector;
+}
+
+TraceCollector::TraceCollector() : lost_(0)
+{
+}
+
+void TraceCollector::collect()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+
+    std::vector<TraceRecord> records;
+    std::vector<TraceSpan> spans;
+    lost_ += TraceBuffer::takeDiscardedRecordCount();
+    for (const TraceBuffer::Ptr& buffer : TraceBuffer::getBuffers()) {
+        records.clear();
+        lost_ += buffer->read(records);
+
+        for (const TraceRecord& record : records) {
+            spans.push_back(TraceSpan{ record.type, record.name, buffer->getThreadIndex(), record.begin_ns, record.end_ns, record.id });
+
+            if (record.type != TraceType::SPAN && record.type != TraceType::WAIT) {
+                continue;
+            }
+
+            std::chrono::nanoseconds duration(record.end_ns - record.begin_ns);
+
+            TraceStatistics& stats = statistics_[record.name];
+            if (stats.count == 0 || duration < stats.min) {
+                stats.min = duration;
+            }
+            if (duration > stats.max) {
+                stats.max = duration;
+            }
+            stats.total += duration;
+            ++stats.count;
+        }
+    }
+
+    if (!spans.empty()) {
+        spans_collected(spans);
+    }
+}
+
+TraceStatistics TraceCollector::getStatistics(const std::string& name)
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    collect();
+
+    auto pos = statistics_.find(TraceBuffer::intern(name));
+    if (pos == statistics_.end()) {
+        return TraceStatistics();
+    }
+    return pos->second;
+}
+
+std::map<std::string, TraceStatistics> TraceCollector::getAllStatistics()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    collect();
+
+    std::map<std::string, TraceStatistics> result;
+    for (const auto& pair : statistics_) {
+        result[TraceBuffer::getName(pair.first)] = pair.second;
+    }
+    return result;
+}
+
+std::size_t TraceCollector::getLostRecordCount()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    collect();
+    return lost_;
+}
+
+void TraceCollector::reset()
+{
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
+    collect();
+    statistics_.clear();
+    lost_ = 0;
+}
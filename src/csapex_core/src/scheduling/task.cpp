@@ -3,10 +3,11 @@
 
 /// PROJECT
 #include <csapex/utility/assert.h>
+#include <csapex/profiling/trace_buffer.h>
 
 using namespace csapex;
 
-Task::Task(const std::string& name, std::function<void()> callback, long priority, TaskGenerator* parent) : parent_(parent), name_(name), callback_(callback), priority_(priority), scheduled_(false)
+Task::Task(const std::string& name, std::function<void()> callback, long priority, TaskGenerator* parent) : parent_(parent), name_(name), trace_name_(TraceBuffer::intern(name)), callback_(callback), priority_(priority), scheduled_(false), queued_(false), queue_position_(NOT_QUEUED), queue_sequence_(0)
 {
 }
 
@@ -29,6 +30,11 @@ std::string Task::getName() const
     return name_;
 }
 
+uint32_t Task::getTraceName() const
+{
+    return trace_name_;
+}
+
 void Task::setPriority(long priority)
 {
     priority_ = priority;
@@ -48,3 +54,19 @@ void Task::setScheduled(bool scheduled)
 {
     scheduled_ = scheduled;
 }
+
+bool Task::markQueued()
+{
+    bool expected = false;
+    return queued_.compare_exchange_strong(expected, true);
+}
+
+void Task::unmarkQueued()
+{
+    queued_ = false;
+}
+
+bool Task::isQueued() const
+{
+    return queued_;
+}
@@ -3,6 +3,26 @@
 
 using namespace csapex;
 
+TaskGenerator::TaskGenerator() : executing_(false)
+{
+}
+
 TaskGenerator::~TaskGenerator()
 {
 }
+
+bool TaskGenerator::tryBeginExecution()
+{
+    bool expected = false;
+    return executing_.compare_exchange_strong(expected, true);
+}
+
+void TaskGenerator::endExecution()
+{
+    executing_ = false;
+}
+
+bool TaskGenerator::isExecuting() const
+{
+    return executing_;
+}
@@ -0,0 +1,175 @@
+/// HEADER
+#include <csapex/scheduling/task_queue.h>
+
+/// PROJECT
+#include <csapex/scheduling/task.h>
+#include <csapex/utility/assert.h>
+
+/// SYSTEM
+#include <algorithm>
+
+using namespace csapex;
+
+TaskQueue::TaskQueue() : next_sequence_(0)
+{
+}
+
+TaskQueue::~TaskQueue()
+{
+    clear();
+}
+
+bool TaskQueue::push(const TaskPtr& task)
+{
+    if (!task->markQueued()) {
+        return false;
+    }
+
+    task->queue_sequence_ = next_sequence_++;
+
+    heap_.push_back(task);
+    place(heap_.size() - 1, task);
+    siftUp(heap_.size() - 1);
+
+    return true;
+}
+
+TaskPtr TaskQueue::pop()
+{
+    if (heap_.empty()) {
+        return nullptr;
+    }
+
+    TaskPtr top = heap_.front();
+    erase(0);
+    return top;
+}
+
+bool TaskQueue::remove(const TaskPtr& task)
+{
+    std::size_t pos = task->queue_position_;
+    if (pos >= heap_.size() || heap_[pos] != task) {
+        return false;
+    }
+
+    erase(pos);
+    return true;
+}
+
+std::vector<TaskPtr> TaskQueue::remove(TaskGenerator* generator)
+{
+    std::vector<TaskPtr> removed;
+    for (const TaskPtr& task : heap_) {
+        if (task->getParent() == generator) {
+            removed.push_back(task);
+        }
+    }
+    for (const TaskPtr& task : removed) {
+        remove(task);
+    }
+
+    std::sort(removed.begin(), removed.end(), [](const TaskPtr& a, const TaskPtr& b) { return a->queue_sequence_ < b->queue_sequence_; });
+    return removed;
+}
+
+std::vector<TaskPtr> TaskQueue::takeAll()
+{
+    std::vector<TaskPtr> result;
+    result.reserve(heap_.size());
+    while (!heap_.empty()) {
+        result.push_back(pop());
+    }
+    return result;
+}
+
+void TaskQueue::clear()
+{
+    for (const TaskPtr& task : heap_) {
+        task->queue_position_ = Task::NOT_QUEUED;
+        task->unmarkQueued();
+    }
+    heap_.clear();
+}
+
+bool TaskQueue::empty() const
+{
+    return heap_.empty();
+}
+
+std::size_t TaskQueue::size() const
+{
+    return heap_.size();
+}
+
+bool TaskQueue::before(std::size_t a, std::size_t b) const
+{
+    const Task& ta = *heap_[a];
+    const Task& tb = *heap_[b];
+    if (ta.getPriority() != tb.getPriority()) {
+        return ta.getPriority() > tb.getPriority();
+    }
+    return ta.queue_sequence_ < tb.queue_sequence_;
+}
+
+void TaskQueue::place(std::size_t pos, const TaskPtr& task)
+{
+    heap_[pos] = task;
+    task->queue_position_ = pos;
+}
+
+void TaskQueue::siftUp(std::size_t pos)
+{
+    while (pos > 0) {
+        std::size_t parent = (pos - 1) / 2;
+        if (!before(pos, parent)) {
+            break;
+        }
+        TaskPtr tmp = heap_[parent];
+        place(parent, heap_[pos]);
+        place(pos, tmp);
+        pos = parent;
+    }
+}
+
+void TaskQueue::siftDown(std::size_t pos)
+{
+    const std::size_t n = heap_.size();
+    while (true) {
+        std::size_t first = pos;
+        std::size_t left = 2 * pos + 1;
+        std::size_t right = left + 1;
+        if (left < n && before(left, first)) {
+            first = left;
+        }
+        if (right < n && before(right, first)) {
+            first = right;
+        }
+        if (first == pos) {
+            break;
+        }
+        TaskPtr tmp = heap_[first];
+        place(first, heap_[pos]);
+        place(pos, tmp);
+        pos = first;
+    }
+}
+
+void TaskQueue::erase(std::size_t pos)
+{
+    apex_assert_hard(pos < heap_.size());
+
+    TaskPtr task = heap_[pos];
+    task->queue_position_ = Task::NOT_QUEUED;
+    task->unmarkQueued();
+
+    std::size_t last = heap_.size() - 1;
+    if (pos != last) {
+        place(pos, heap_[last]);
+    }
+    heap_.pop_back();
+
+    if (pos < heap_.size()) {
+        siftDown(pos);
+        siftUp(pos);
+    }
+}
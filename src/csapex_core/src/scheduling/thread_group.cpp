@@ -12,6 +12,7 @@
 #include <csapex/scheduling/timed_queue.h>
 #include <csapex/profiling/profiler.h>
 #include <csapex/profiling/trace.h>
+#include <csapex/profiling/trace_buffer.h>
 
 /// SYSTEM
 #include <iostream>
@@ -19,16 +20,61 @@
 
 using namespace csapex;
 
+namespace
+{
+// identifies the worker that is running on the current thread, if any
+thread_local const ThreadGroup* current_group = nullptr;
+thread_local std::size_t current_worker = 0;
+thread_local const TaskGenerator* current_generator = nullptr;
+}  // namespace
+
+struct ThreadGroup::Worker
+{
+    std::size_t index;
+    std::thread thread;
+
+    std::mutex queue_mtx;
+    std::deque<TaskPtr> queue;
+
+    // the other workers in the order they are stolen from
+    std::vector<Worker*> victims;
+
+    std::recursive_mutex execution_mtx;
+};
+
+class ThreadGroup::ExecutionClaim
+{
+public:
+    ExecutionClaim(ThreadGroup* group, TaskGenerator* generator) : group_(group), generator_(generator), previous_(current_generator)
+    {
+        current_generator = generator_;
+    }
+    ~ExecutionClaim()
+    {
+        current_generator = previous_;
+        if (generator_) {
+            group_->endExecution(generator_);
+        }
+    }
+
+private:
+    ThreadGroup* group_;
+    TaskGenerator* generator_;
+    const TaskGenerator* previous_;
+};
+
 int ThreadGroup::next_id_ = ThreadGroup::MINIMUM_THREAD_ID;
 
 ThreadGroup::ThreadGroup(TimedQueuePtr timed_queue, ExceptionHandler& handler, int id, std::string name)
   : handler_(handler), destroyed_(false), id_(id), name_(name), cpu_affinity_(new CpuAffinity), timed_queue_(timed_queue), running_(false), pause_(false), stepping_(false)
+  , worker_count_(1), next_worker_(0), work_epoch_(0), idle_workers_(0), removals_waiting_(0), wake_ups_(0)
 {
     next_id_ = std::max(next_id_, id + 1);
     setup();
 }
 ThreadGroup::ThreadGroup(TimedQueuePtr timed_queue, ExceptionHandler& handler, std::string name)
   : handler_(handler), destroyed_(false), id_(next_id_++), name_(name), cpu_affinity_(new CpuAffinity), timed_queue_(timed_queue), running_(false), pause_(false), stepping_(false)
+  , worker_count_(1), next_worker_(0), work_epoch_(0), idle_workers_(0), removals_waiting_(0), wake_ups_(0)
 {
     setup();
 }
@@ -39,7 +85,11 @@ ThreadGroup::~ThreadGroup()
     for (const TaskGeneratorPtr& tg : generators_copy) {
         tg->detach();
     }
-    if (running_ || scheduler_thread_.joinable()) {
+    bool threads_active = scheduler_thread_.joinable();
+    for (const auto& worker : workers_) {
+        threads_active |= worker->thread.joinable();
+    }
+    if (running_ || threads_active) {
         stop();
     }
     destroyed_ = true;
@@ -52,7 +102,17 @@ void ThreadGroup::setup()
 
 void ThreadGroup::updateAffinity()
 {
-    if (!scheduler_thread_.joinable()) {
+    updateAffinity(scheduler_thread_);
+
+    std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
+    for (const auto& worker : workers_) {
+        updateAffinity(worker->thread);
+    }
+}
+
+void ThreadGroup::updateAffinity(std::thread& thread)
+{
+    if (!thread.joinable()) {
         return;
     }
 
@@ -67,7 +127,7 @@ void ThreadGroup::updateAffinity()
             CPU_SET(cpu, &cpuset);
         }
     }
-    int rc = pthread_setaffinity_np(scheduler_thread_.native_handle(), sizeof(cpu_set_t), &cpuset);
+    int rc = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset);
     if (rc != 0) {
         std::cerr << "failed to set cpu affinity in thread " << name_ << std::endl;
     }
@@ -103,9 +163,104 @@ CpuAffinityPtr ThreadGroup::getCpuAffinity() const
 
 const std::thread& ThreadGroup::thread() const
 {
+    if (!workers_.empty()) {
+        return workers_.front()->thread;
+    }
     return scheduler_thread_;
 }
 
+std::size_t ThreadGroup::getWorkerCount() const
+{
+    return worker_count_;
+}
+
+void ThreadGroup::setWorkerCount(std::size_t workers)
+{
+    workers = std::max<std::size_t>(1, workers);
+    if (workers == worker_count_) {
+        return;
+    }
+
+    std::unique_lock<std::recursive_mutex> lock(state_mtx_);
+    bool was_running = running_;
+    if (was_running) {
+        running_ = false;
+        pause_changed_.notify_all();
+        lock.unlock();
+        joinThreads();
+        lock.lock();
+    }
+
+    {
+        std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
+
+        // collect all pending tasks in the order they would have been executed
+        std::vector<TaskPtr> pending = tasks_.takeAll();
+        for (const auto& worker : workers_) {
+            std::unique_lock<std::mutex> queue_lock(worker->queue_mtx);
+            for (const TaskPtr& task : worker->queue) {
+                task->unmarkQueued();
+                pending.push_back(task);
+            }
+            worker->queue.clear();
+        }
+
+        worker_count_ = workers;
+        createWorkers(isWorkStealing() ? workers : 0);
+
+        for (const TaskPtr& task : pending) {
+            schedule(task);
+        }
+    }
+
+    if (was_running) {
+        running_ = true;
+        startThreads();
+    }
+
+    scheduler_changed();
+}
+
+bool ThreadGroup::isWorkStealing() const
+{
+    return worker_count_ > 1;
+}
+
+void ThreadGroup::createWorkers(std::size_t count)
+{
+    workers_.clear();
+    for (std::size_t i = 0; i < count; ++i) {
+        std::unique_ptr<Worker> worker(new Worker);
+        worker->index = i;
+        workers_.push_back(std::move(worker));
+    }
+    for (const auto& worker : workers_) {
+        for (std::size_t offset = 1; offset < count; ++offset) {
+            worker->victims.push_back(workers_[(worker->index + offset) % count].get());
+        }
+    }
+    next_worker_ = 0;
+}
+
+std::vector<std::unique_lock<std::recursive_mutex>> ThreadGroup::lockExecution()
+{
+    // tasks schedule other tasks while they are executed, so tasks_mtx_ must not be held while waiting for them
+    std::vector<Worker*> workers;
+    {
+        std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
+        for (const auto& worker : workers_) {
+            workers.push_back(worker.get());
+        }
+    }
+
+    std::vector<std::unique_lock<std::recursive_mutex>> locks;
+    locks.emplace_back(execution_mtx_);
+    for (Worker* worker : workers) {
+        locks.emplace_back(worker->execution_mtx);
+    }
+    return locks;
+}
+
 std::size_t ThreadGroup::size() const
 {
     return generators_.size();
@@ -154,7 +309,7 @@ void ThreadGroup::step()
 {
     begin_step();
 
-    std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+    auto execution_locks = lockExecution();
     for (auto generator : generators_) {
         generator->step();
     }
@@ -199,22 +354,59 @@ bool ThreadGroup::isStepDone() const
 void ThreadGroup::start()
 {
     std::unique_lock<std::recursive_mutex> lock(state_mtx_);
-    if (scheduler_thread_.joinable()) {
-        running_ = false;
-        pause_changed_.notify_all();
-        lock.unlock();
+    running_ = false;
+    pause_changed_.notify_all();
+    lock.unlock();
 
-        scheduler_thread_.join();
-    }
+    joinThreads();
 
     running_ = true;
 
-    scheduler_thread_ = std::thread([this]() {
-        csapex::thread::set_name((name_).c_str());
-        updateAffinity();
+    startThreads();
+}
+
+void ThreadGroup::startThreads()
+{
+    if (isWorkStealing()) {
+        for (const auto& worker : workers_) {
+            Worker* w = worker.get();
+            w->thread = std::thread([this, w]() {
+                csapex::thread::set_name((name_ + ":" + std::to_string(w->index)).c_str());
+                updateAffinity(w->thread);
+
+                workerLoop(w);
+            });
+        }
+
+    } else {
+        scheduler_thread_ = std::thread([this]() {
+            csapex::thread::set_name((name_).c_str());
+            updateAffinity(scheduler_thread_);
+
+            schedulingLoop();
+        });
+    }
+}
+
+void ThreadGroup::joinThreads()
+{
+    {
+        std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
+        work_available_.notify_all();
+    }
+    {
+        std::unique_lock<std::mutex> lock(idle_mtx_);
+        idle_changed_.notify_all();
+    }
 
-        schedulingLoop();
-    });
+    if (scheduler_thread_.joinable()) {
+        scheduler_thread_.join();
+    }
+    for (const auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
 }
 
 void ThreadGroup::stop()
@@ -225,16 +417,12 @@ void ThreadGroup::stop()
         pause_changed_.notify_all();
     }
     {
-        std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+        auto execution_locks = lockExecution();
     }
     {
-        std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
-        work_available_.notify_all();
-        if (scheduler_thread_.joinable()) {
-            lock.unlock();
+        joinThreads();
 
-            scheduler_thread_.join();
-        }
+        std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
 
         auto gen = generators_;
         for (const TaskGeneratorPtr& tg : gen) {
@@ -249,6 +437,11 @@ void ThreadGroup::stop()
     }
 }
 
+std::size_t ThreadGroup::getWakeUps() const
+{
+    return wake_ups_;
+}
+
 bool ThreadGroup::isRunning() const
 {
     return running_;
@@ -259,9 +452,17 @@ void ThreadGroup::clear()
     {
         std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
         tasks_.clear();
+
+        for (const auto& worker : workers_) {
+            std::unique_lock<std::mutex> queue_lock(worker->queue_mtx);
+            for (const TaskPtr& task : worker->queue) {
+                task->unmarkQueued();
+            }
+            worker->queue.clear();
+        }
     }
 
-    std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+    auto execution_locks = lockExecution();
     for (auto generator : generators_) {
         generator->reset();
     }
@@ -305,19 +506,23 @@ void ThreadGroup::checkIfStepIsDone()
 
 std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator)
 {
-    std::vector<TaskPtr> remaining_tasks;
-
     std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
 
     TaskGeneratorPtr removed;
 
-    for (auto it = tasks_.begin(); it != tasks_.end();) {
-        TaskPtr task = *it;
-        if (task->getParent() == generator) {
-            remaining_tasks.push_back(task);
-            it = tasks_.erase(it);
-        } else {
-            ++it;
+    std::vector<TaskPtr> remaining_tasks = tasks_.remove(generator);
+
+    for (const auto& worker : workers_) {
+        std::unique_lock<std::mutex> queue_lock(worker->queue_mtx);
+        for (auto it = worker->queue.begin(); it != worker->queue.end();) {
+            TaskPtr task = *it;
+            if (task->getParent() == generator) {
+                task->unmarkQueued();
+                remaining_tasks.push_back(task);
+                it = worker->queue.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 
@@ -336,6 +541,16 @@ std::vector<TaskPtr> ThreadGroup::remove(TaskGenerator* generator)
 
     generator_removed(removed);
 
+    lock.unlock();
+
+    // another worker might still be executing one of the generator's tasks
+    if (current_generator != generator) {
+        std::unique_lock<std::mutex> execution_lock(execution_finished_mtx_);
+        ++removals_waiting_;
+        execution_finished_.wait(execution_lock, [generator]() { return !generator->isExecuting(); });
+        --removals_waiting_;
+    }
+
     return remaining_tasks;
 }
 
@@ -345,24 +560,36 @@ void ThreadGroup::schedule(TaskPtr task)
 
     std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
 
-    if (!tasks_.empty()) {
-        //        for(const TaskPtr& t : tasks_) {
-        for (auto it = tasks_.begin(); it != tasks_.end(); ++it) {
-            const TaskPtr& t = *it;
-            if (t.get() == task.get()) {
-                return;
-            }
+    if (!workers_.empty()) {
+        if (!task->markQueued()) {
+            return;
         }
+        task->setScheduled(true);
+
+        // tasks spawned by a worker stay local, others are distributed round-robin
+        std::size_t index = current_group == this ? current_worker : next_worker_++;
+        Worker* worker = workers_[index % workers_.size()].get();
+        {
+            std::unique_lock<std::mutex> queue_lock(worker->queue_mtx);
+            worker->queue.push_back(task);
+        }
+        tasks_lock.unlock();
+
+        wakeWorker();
+        return;
     }
 
-    tasks_.insert(task);
+    if (!tasks_.push(task)) {
+        // already queued
+        return;
+    }
 
     task->setScheduled(true);
 
     work_available_.notify_all();
 }
 
-void ThreadGroup::scheduleDelayed(TaskPtr schedulable, std::chrono::system_clock::time_point time)
+void ThreadGroup::scheduleDelayed(TaskPtr schedulable, std::chrono::steady_clock::time_point time)
 {
     timed_queue_->schedule(shared_from_this(), schedulable, time);
 }
@@ -381,16 +608,14 @@ void ThreadGroup::schedulingLoop()
 
 bool ThreadGroup::waitForTasks()
 {
+    // stop notifies while holding tasks_mtx_, so checking running_ under the lock cannot miss it
     std::unique_lock<std::recursive_mutex> lock(tasks_mtx_);
-    while (tasks_.empty()) {
-        work_available_.wait_for(lock, std::chrono::seconds(1));
-
-        if (!running_) {
-            return false;
-        }
+    while (running_ && tasks_.empty()) {
+        work_available_.wait(lock);
+        ++wake_ups_;
     }
 
-    return true;
+    return running_;
 }
 
 void ThreadGroup::handlePause()
@@ -405,8 +630,7 @@ bool ThreadGroup::executeNextTask()
 {
     std::unique_lock<std::recursive_mutex> tasks_lock(tasks_mtx_);
     if (!tasks_.empty()) {
-        TaskPtr task = *tasks_.begin();
-        tasks_.erase(tasks_.begin());
+        TaskPtr task = tasks_.pop();
 
         task->setScheduled(false);
 
@@ -421,22 +645,138 @@ bool ThreadGroup::executeNextTask()
                 return true;
             }
         }
+
+        // the group is stopped or its workers are replaced, the task is taken over by whoever runs next
+        schedule(task);
     }
 
     return false;
 }
 
+void ThreadGroup::workerLoop(Worker* worker)
+{
+    current_group = this;
+    current_worker = worker->index;
+
+    while (running_) {
+        handlePause();
+        if (!running_) {
+            break;
+        }
+
+        std::size_t epoch = work_epoch_;
+        TaskPtr task = takeRunnableTask(worker);
+        if (task) {
+            executeTask(task, worker);
+        } else {
+            waitForWork(epoch);
+        }
+    }
+
+    current_group = nullptr;
+}
+
+TaskPtr ThreadGroup::takeRunnableTask(Worker* worker)
+{
+    if (TaskPtr task = takeRunnableTask(worker, false)) {
+        return task;
+    }
+
+    // the workers only exist while the worker threads are running, so their victims stay valid
+    for (Worker* victim : worker->victims) {
+        if (TaskPtr task = takeRunnableTask(victim, true)) {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+TaskPtr ThreadGroup::takeRunnableTask(Worker* worker, bool steal)
+{
+    auto claim = [](const TaskPtr& task) {
+        TaskGenerator* generator = task->getParent();
+        return generator == nullptr || generator->tryBeginExecution();
+    };
+
+    TaskPtr result;
+
+    std::unique_lock<std::mutex> queue_lock(worker->queue_mtx);
+    std::deque<TaskPtr>& queue = worker->queue;
+    if (steal) {
+        // thieves take the most recently scheduled task
+        for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+            if (claim(*it)) {
+                result = *it;
+                queue.erase(std::next(it).base());
+                break;
+            }
+        }
+    } else {
+        // the owner processes its tasks in order
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (claim(*it)) {
+                result = *it;
+                queue.erase(it);
+                break;
+            }
+        }
+    }
+    queue_lock.unlock();
+
+    if (result) {
+        result->setScheduled(false);
+        result->unmarkQueued();
+    }
+    return result;
+}
+
+void ThreadGroup::waitForWork(std::size_t epoch)
+{
+    std::unique_lock<std::mutex> lock(idle_mtx_);
+    ++idle_workers_;
+    while (running_ && work_epoch_ == epoch) {
+        idle_changed_.wait(lock);
+        ++wake_ups_;
+    }
+    --idle_workers_;
+}
+
+void ThreadGroup::wakeWorker()
+{
+    ++work_epoch_;
+    if (idle_workers_ > 0) {
+        std::unique_lock<std::mutex> lock(idle_mtx_);
+        idle_changed_.notify_one();
+    }
+}
+
+void ThreadGroup::executeTask(const TaskPtr& task, Worker* worker)
+{
+    // the generator has been claimed by takeRunnableTask
+    ExecutionClaim claim(this, task->getParent());
+
+    executeTask(task, worker->execution_mtx, worker->index);
+}
+
 void ThreadGroup::executeTask(const TaskPtr& task)
+{
+    executeTask(task, execution_mtx_, 0);
+}
+
+void ThreadGroup::executeTask(const TaskPtr& task, std::recursive_mutex& execution_mtx, std::size_t worker_index)
 {
     try {
-        std::unique_lock<std::recursive_mutex> state_lock(execution_mtx_);
+        std::unique_lock<std::recursive_mutex> state_lock(execution_mtx);
         ProfilerPtr profiler = getProfiler();
         Trace::Ptr interlude;
         if (profiler && profiler->isEnabled()) {
-            TimerPtr timer = profiler->getTimer(getName());
+            std::string timer_name = worker_index == 0 ? getName() : getName() + ":" + std::to_string(worker_index);
+            TimerPtr timer = profiler->getTimer(timer_name);
             interlude.reset(new Trace(timer, task->getName()));
         }
 
+        TraceScope trace(task->getTraceName());
         task->execute();
 
     } catch (const std::exception& e) {
@@ -456,6 +796,17 @@ void ThreadGroup::executeTask(const TaskPtr& task)
     }
 }
 
+void ThreadGroup::endExecution(TaskGenerator* generator)
+{
+    generator->endExecution();
+
+    if (removals_waiting_ > 0) {
+        // remove() waits until the generator is no longer executed
+        std::unique_lock<std::mutex> lock(execution_finished_mtx_);
+        execution_finished_.notify_all();
+    }
+}
+
 std::vector<TaskGeneratorPtr>::iterator ThreadGroup::begin()
 {
     return generators_.begin();
@@ -479,6 +830,7 @@ std::vector<TaskGeneratorPtr>::const_iterator ThreadGroup::end() const
 void ThreadGroup::saveSettings(YAML::Node& node)
 {
     node["affinity"] = cpu_affinity_->get();
+    node["workers"] = worker_count_.load();
 }
 
 void ThreadGroup::loadSettings(const YAML::Node& node)
@@ -487,4 +839,7 @@ void ThreadGroup::loadSettings(const YAML::Node& node)
         std::vector<bool> affinity = node["affinity"].as<std::vector<bool>>();
         cpu_affinity_->set(affinity);
     }
+    if (node["workers"].IsDefined()) {
+        setWorkerCount(node["workers"].as<std::size_t>());
+    }
 }
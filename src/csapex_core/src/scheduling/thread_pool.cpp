@@ -515,6 +515,10 @@ void ThreadPool::useProfiler(std::shared_ptr<Profiler> profiler)
 {
     Profilable::useProfiler(profiler);
 
+    if (timed_queue_) {
+        timed_queue_->useProfiler(profiler);
+    }
+
     for (const ThreadGroupPtr& group : groups_) {
         group->useProfiler(profiler);
     }
@@ -5,29 +5,46 @@
 #include <csapex/scheduling/scheduler.h>
 #include <csapex/scheduling/task.h>
 #include <csapex/utility/thread.h>
+#include <csapex/utility/assert.h>
+#include <csapex/profiling/profiler.h>
+#include <csapex/profiling/profiling_fwd.h>
+#include <csapex/profiling/trace_buffer.h>
+
+/// SYSTEM
+#include <algorithm>
 
 using namespace csapex;
 
-TimedQueue::TimedQueue() : scheduling_running_(false), sleeping_running_(false)
+constexpr std::chrono::microseconds::rep TimedQueue::TICK_US;
+
+TimedQueue::TimedQueue() : running_(false), origin_(clock::now()), current_tick_(0), next_wake_up_(clock::time_point::max()), next_handle_(INVALID_HANDLE + 1), wake_ups_(0)
 {
+    for (int level = 0; level < LEVELS; ++level) {
+        level_size_[level] = 0;
+    }
+    jitter_ = getProfiler()->getHistogram("timed queue");
 }
 TimedQueue::~TimedQueue()
 {
     stop();
 }
 
+void TimedQueue::useProfiler(std::shared_ptr<Profiler> profiler)
+{
+    Profilable::useProfiler(profiler);
+
+    std::unique_lock<std::mutex> lock(task_mtx_);
+    jitter_ = profiler->getHistogram("timed queue");
+}
+
 void TimedQueue::start()
 {
-    next_wake_up_ = std::chrono::system_clock::now();
+    if (scheduling_thread_.joinable()) {
+        return;
+    }
 
-    // this thread schedules tasks that have expired
-    scheduling_running_ = true;
+    running_ = true;
     scheduling_thread_ = std::thread([this]() { loop(); });
-
-    // this thread sleeps until the time given by 'next_wake_up_' is reached.
-    // it then wakes up the scheduling thread
-    sleeping_running_ = true;
-    sleeping_thread_ = std::thread([this]() { sleep(); });
 }
 
 void TimedQueue::stop()
@@ -35,104 +52,243 @@ void TimedQueue::stop()
     if (scheduling_thread_.joinable()) {
         {
             std::unique_lock<std::mutex> lock(task_mtx_);
-            scheduling_running_ = false;
+            running_ = false;
+            tasks_changed_.notify_all();
         }
-        apex_assert_eq_hard(false, scheduling_running_);
-        tasks_changed_.notify_all();
-        apex_assert_eq_hard(false, scheduling_running_);
         scheduling_thread_.join();
     }
-    if (sleeping_thread_.joinable()) {
-        {
-            std::unique_lock<std::mutex> lock(sleep_mtx_);
-            sleeping_running_ = false;
-        }
-        apex_assert_eq_hard(false, sleeping_running_);
-        next_wake_up_changed_.notify_all();
-        apex_assert_eq_hard(false, sleeping_running_);
-        sleeping_thread_.join();
+}
+
+std::size_t TimedQueue::size() const
+{
+    std::unique_lock<std::mutex> lock(task_mtx_);
+    return units_.size();
+}
+
+std::size_t TimedQueue::getWakeUps() const
+{
+    return wake_ups_;
+}
+
+std::uint64_t TimedQueue::toTick(clock::time_point time) const
+{
+    if (time <= origin_) {
+        return 0;
     }
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - origin_).count() / TICK_US;
 }
 
-void TimedQueue::loop()
+TimedQueue::clock::time_point TimedQueue::toTime(std::uint64_t tick) const
 {
-    csapex::thread::set_name("queue:exec");
+    return origin_ + std::chrono::microseconds(tick * TICK_US);
+}
 
-    std::unique_lock<std::mutex> lock(task_mtx_);
-    while (scheduling_running_) {
-        // wait until a task is available
-        while (tasks_.empty()) {
-            tasks_changed_.wait_for(lock, std::chrono::milliseconds(100));
-            if (!scheduling_running_) {
-                return;
+void TimedQueue::place(Slot& source, Slot::iterator unit)
+{
+    // overdue units go into the current slot
+    std::uint64_t tick = std::max(unit->tick, current_tick_);
+    std::uint64_t delta = tick - current_tick_;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    if (level == LEVELS - 1) {
+        // units beyond the range of the wheel are parked in one of the farthest slots and re-evaluated on cascade
+        std::uint64_t horizon = std::uint64_t(SLOTS - 2) << (SLOT_BITS * level);
+        tick = current_tick_ + std::min(delta, horizon);
+    }
+
+    unit->level = level;
+    unit->slot = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+    ++level_size_[level];
+
+    Slot& target = wheel_[level][unit->slot];
+    target.splice(target.end(), source, unit);
+}
+
+void TimedQueue::cascade(int level)
+{
+    Slot& slot = wheel_[level][(current_tick_ >> (SLOT_BITS * level)) & SLOT_MASK];
+    Slot pending;
+    pending.splice(pending.end(), slot);
+    level_size_[level] -= pending.size();
+
+    while (!pending.empty()) {
+        place(pending, pending.begin());
+    }
+}
+
+void TimedQueue::advance(clock::time_point now, Slot& expired)
+{
+    const std::uint64_t now_tick = toTick(now);
+
+    while (true) {
+        if (level_size_[0] > 0) {
+            Slot& slot = wheel_[0][current_tick_ & SLOT_MASK];
+            for (auto it = slot.begin(); it != slot.end();) {
+                auto next = std::next(it);
+                if (it->time <= now) {
+                    --level_size_[0];
+                    units_.erase(it->handle);
+                    expired.splice(expired.end(), slot, it);
+                }
+                it = next;
             }
         }
 
-        // schedule all tasks that have expired
-        while (!tasks_.empty()) {
-            const Unit& front = *tasks_.begin();
-
-            auto now = std::chrono::system_clock::now();
-            if (now >= front.time) {
-                Unit unit = front;
-                tasks_.erase(tasks_.begin());
-                lock.unlock();
+        if (current_tick_ >= now_tick) {
+            break;
+        }
 
-                unit.scheduler->schedule(unit.schedulable);
+        // skip ticks of levels that are empty, cascading is only necessary at boundaries of non-empty levels
+        std::uint64_t step = 1;
+        for (int level = 0; level < LEVELS - 1 && level_size_[level] == 0; ++level) {
+            step <<= SLOT_BITS;
+        }
+        std::uint64_t next_tick = (current_tick_ / step + 1) * step;
+        if (next_tick > now_tick && step > 1) {
+            // no boundary is crossed until now
+            current_tick_ = now_tick;
+            continue;
+        }
+        current_tick_ = next_tick;
 
-                lock.lock();
-            } else {
+        for (int level = 1; level < LEVELS; ++level) {
+            if ((current_tick_ & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) {
                 break;
             }
+            cascade(level);
         }
+    }
+}
 
-        // notify the sleeping thread, if there are remaining tasks
-        if (!tasks_.empty()) {
-            Unit front = *tasks_.begin();
-            lock.unlock();
+TimedQueue::clock::time_point TimedQueue::nextWakeUp() const
+{
+    clock::time_point next = clock::time_point::max();
 
-            {
-                std::unique_lock<std::mutex> lock(sleep_mtx_);
-                next_wake_up_ = front.time;
-                next_wake_up_changed_.notify_all();
+    if (level_size_[0] > 0) {
+        for (std::uint64_t offset = 0; offset < SLOTS; ++offset) {
+            const Slot& slot = wheel_[0][(current_tick_ + offset) & SLOT_MASK];
+            if (!slot.empty()) {
+                for (const Unit& unit : slot) {
+                    next = std::min(next, unit.time);
+                }
+                break;
             }
+        }
+    }
 
-            lock.lock();
+    // higher levels have to be cascaded when their slot is reached
+    for (int level = 1; level < LEVELS; ++level) {
+        if (level_size_[level] == 0) {
+            continue;
+        }
+        const int shift = SLOT_BITS * level;
+        const std::uint64_t base = current_tick_ >> shift;
+        // a deadline one full rotation ahead is stored in the current slot, so that slot is scanned last
+        for (std::uint64_t offset = 1; offset <= SLOTS; ++offset) {
+            if (!wheel_[level][(base + offset) & SLOT_MASK].empty()) {
+                next = std::min(next, toTime((base + offset) << shift));
+                break;
+            }
         }
     }
+
+    return next;
 }
 
-void TimedQueue::sleep()
+void TimedQueue::loop()
 {
-    csapex::thread::set_name("queue:sleep");
+    csapex::thread::set_name("timed queue");
 
-    std::unique_lock<std::mutex> lock(sleep_mtx_);
-    while (sleeping_running_) {
-        // wait for a sleep command
-        next_wake_up_changed_.wait(lock);
+    std::unique_lock<std::mutex> lock(task_mtx_);
+    while (running_) {
+        Slot expired;
+        advance(clock::now(), expired);
 
-        auto now = std::chrono::system_clock::now();
-        if (now < next_wake_up_) {
-            // the next sleep target is in the future -> sleep
-            std::this_thread::sleep_until(next_wake_up_);
-            tasks_changed_.notify_all();
+        if (!expired.empty()) {
+            // units with equal deadlines are dispatched in the order they were scheduled
+            expired.sort([](const Unit& a, const Unit& b) { return a.time < b.time || (a.time == b.time && a.handle < b.handle); });
+
+            Histogram::Ptr jitter = jitter_;
+            ProfilerPtr profiler = getProfiler();
+            bool record = profiler && profiler->isEnabled();
+            lock.unlock();
+
+            static const uint32_t wait_trace_name = TraceBuffer::intern("timed queue wait");
+            for (const Unit& unit : expired) {
+                if (record) {
+                    jitter->add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - unit.time));
+                }
+                TraceBuffer::record(TraceType::WAIT, wait_trace_name, unit.scheduled_ns, TraceBuffer::now(), unit.handle);
+                unit.scheduler->schedule(unit.schedulable);
+            }
+
+            lock.lock();
+            continue;
         }
+
+        next_wake_up_ = nextWakeUp();
+        if (next_wake_up_ == clock::time_point::max()) {
+            tasks_changed_.wait(lock);
+        } else {
+            tasks_changed_.wait_until(lock, next_wake_up_);
+        }
+        next_wake_up_ = clock::time_point::max();
+        ++wake_ups_;
     }
 }
 
-void TimedQueue::schedule(SchedulerPtr scheduler, TaskPtr schedulable, std::chrono::system_clock::time_point time)
+TimedQueue::Handle TimedQueue::schedule(SchedulerPtr scheduler, TaskPtr schedulable, clock::time_point time)
 {
-    Unit unit;
+    Slot pending;
+    pending.emplace_back();
+    Unit& unit = pending.back();
     unit.scheduler = scheduler;
     unit.schedulable = schedulable;
     unit.time = time;
+    unit.scheduled_ns = TraceBuffer::now();
+    unit.tick = toTick(time);
 
     std::unique_lock<std::mutex> lock(task_mtx_);
-    auto front = tasks_.begin();
-    tasks_.insert(unit);
+    unit.handle = next_handle_++;
+    Handle handle = unit.handle;
+
+    if (units_.empty()) {
+        // nothing is pending, so the wheel can be fast-forwarded without cascading
+        current_tick_ = std::max(current_tick_, toTick(clock::now()));
+    }
 
-    if (tasks_.begin() != front) {
-        // the earliest entry changed -> notify the scheduling thread immediately
+    auto it = pending.begin();
+    place(pending, it);
+    units_[handle] = it;
+
+    if (time < next_wake_up_) {
+        // the earliest deadline changed -> notify the scheduling thread immediately
         tasks_changed_.notify_all();
     }
+
+    return handle;
+}
+
+bool TimedQueue::cancel(Handle handle)
+{
+    std::unique_lock<std::mutex> lock(task_mtx_);
+    auto pos = units_.find(handle);
+    if (pos == units_.end()) {
+        return false;
+    }
+
+    Slot::iterator unit = pos->second;
+    --level_size_[unit->level];
+    wheel_[unit->level][unit->slot].erase(unit);
+    units_.erase(pos);
+
+    if (units_.empty() && next_wake_up_ != clock::time_point::max()) {
+        // the scheduling thread would wake up for nothing -> let it go to sleep without a deadline
+        tasks_changed_.notify_all();
+    }
+
+    return true;
 }
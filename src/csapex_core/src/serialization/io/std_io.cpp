@@ -6,16 +6,15 @@ using namespace csapex;
 // STRINGS
 SerializationBuffer& csapex::operator<<(SerializationBuffer& data, const std::string& s)
 {
-    apex_assert_lt_hard(s.size(), std::numeric_limits<uint16_t>::max());
-    data << static_cast<uint16_t>(s.size());
+    data.writeStringLength(s.size());
     data.writeRaw(s.data(), s.size());
     return data;
 }
 
 const SerializationBuffer& csapex::operator>>(const SerializationBuffer& data, std::string& s)
 {
-    uint16_t str_len;
-    data >> str_len;
+    std::size_t str_len = data.readStringLength();
+    s.clear();
     if (str_len > 0) {
         s.resize(str_len);
         data.readRaw(&s.at(0), str_len);
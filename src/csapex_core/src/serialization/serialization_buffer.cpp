@@ -23,14 +23,25 @@
 /// SYSTEM
 #include <yaml-cpp/yaml.h>
 #include <iostream>
+#include <algorithm>
+#include <cstring>
 
 using namespace csapex;
 
+constexpr SemanticVersion SerializationBuffer::FORMAT_VERSION;
+
+namespace
+{
+// lengths up to this value are stored directly, the value itself marks a varint
+constexpr uint8_t LONG_LENGTH_MARKER = std::numeric_limits<uint8_t>::max();
+constexpr uint16_t LONG_STRING_LENGTH_MARKER = std::numeric_limits<uint16_t>::max();
+}  // namespace
+
 bool SerializationBuffer::initialized_ = false;
 std::map<std::type_index, std::function<void(SerializationBuffer& buffer, const boost::any& a)>> SerializationBuffer::any_serializer;
 std::map<uint8_t, std::function<void(const SerializationBuffer& buffer, boost::any& a)>> SerializationBuffer::any_deserializer;
 
-SerializationBuffer::SerializationBuffer() : pos(HEADER_LENGTH)
+SerializationBuffer::SerializationBuffer() : pos(HEADER_LENGTH), format_version_(FORMAT_VERSION)
 {
     // the header is always 4 byte
     insert(end(), HEADER_LENGTH, 0);
@@ -38,7 +49,7 @@ SerializationBuffer::SerializationBuffer() : pos(HEADER_LENGTH)
     init();
 }
 
-SerializationBuffer::SerializationBuffer(const std::vector<uint8_t>& copy, bool insert_header) : pos(HEADER_LENGTH)
+SerializationBuffer::SerializationBuffer(const std::vector<uint8_t>& copy, bool insert_header) : pos(HEADER_LENGTH), format_version_(FORMAT_VERSION)
 {
     if (insert_header) {
         // the header is always 4 byte
@@ -52,7 +63,7 @@ SerializationBuffer::SerializationBuffer(const std::vector<uint8_t>& copy, bool
     init();
 }
 
-SerializationBuffer::SerializationBuffer(const uint8_t* raw_data, const std::size_t length, bool insert_header) : pos(HEADER_LENGTH)
+SerializationBuffer::SerializationBuffer(const uint8_t* raw_data, const std::size_t length, bool insert_header) : pos(HEADER_LENGTH), format_version_(FORMAT_VERSION)
 {
     if (insert_header) {
         // the header is always 4 byte
@@ -66,6 +77,15 @@ SerializationBuffer::SerializationBuffer(const uint8_t* raw_data, const std::siz
     init();
 }
 
+SerializationBuffer::SerializationBuffer(SerializationStorage& storage)
+  : std::vector<uint8_t, SerializationAllocator<uint8_t>>(SerializationAllocator<uint8_t>(&storage)), pos(HEADER_LENGTH), format_version_(FORMAT_VERSION)
+{
+    // the header is always 4 byte
+    insert(end(), HEADER_LENGTH, 0);
+
+    init();
+}
+
 void SerializationBuffer::init()
 {
     if (!initialized_) {
@@ -191,6 +211,93 @@ uint32_t SerializationBuffer::getPos() const
     return pos;
 }
 
+void SerializationBuffer::setFormatVersion(const SemanticVersion& version)
+{
+    format_version_ = version;
+}
+
+SemanticVersion SerializationBuffer::getFormatVersion() const
+{
+    return format_version_;
+}
+
+void SerializationBuffer::writeLength(uint64_t length)
+{
+    if (length < LONG_LENGTH_MARKER) {
+        operator<<(static_cast<uint8_t>(length));
+        return;
+    }
+
+    apex_assert_hard_msg(format_version_ >= SemanticVersion(1, 1, 0), "containers with more than 254 elements require format version 1.1.0");
+    operator<<(LONG_LENGTH_MARKER);
+    writeVarint(length);
+}
+
+uint64_t SerializationBuffer::readLength() const
+{
+    uint8_t length;
+    operator>>(length);
+    if (length < LONG_LENGTH_MARKER) {
+        return length;
+    }
+    return readVarint();
+}
+
+void SerializationBuffer::writeStringLength(uint64_t length)
+{
+    if (length < LONG_STRING_LENGTH_MARKER) {
+        operator<<(static_cast<uint16_t>(length));
+        return;
+    }
+
+    apex_assert_hard_msg(format_version_ >= SemanticVersion(1, 1, 0), "strings longer than 65534 bytes require format version 1.1.0");
+    operator<<(LONG_STRING_LENGTH_MARKER);
+    writeVarint(length);
+}
+
+uint64_t SerializationBuffer::readStringLength() const
+{
+    uint16_t length;
+    operator>>(length);
+    if (length < LONG_STRING_LENGTH_MARKER) {
+        return length;
+    }
+    return readVarint();
+}
+
+void SerializationBuffer::writeVarint(uint64_t value)
+{
+    // 7 bits per byte, least significant group first, the high bit marks a continuation
+    while (value >= 0x80) {
+        push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t SerializationBuffer::readVarint() const
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        checkReadable(1);
+        uint8_t byte = operator[](pos++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("SerializationBuffer: malformed varint");
+}
+
+void SerializationBuffer::reserveAdditional(std::size_t bytes)
+{
+    std::size_t required = size() + bytes;
+    if (required > capacity()) {
+        // keep the geometric growth, otherwise repeated hints would reallocate every time
+        reserve(std::max(required, 2 * capacity()));
+    }
+}
+
 std::string SerializationBuffer::toString() const
 {
     std::stringstream res;
@@ -237,27 +344,39 @@ StreamablePtr SerializationBuffer::read() const
 
 void SerializationBuffer::writeRaw(const char* data, const std::size_t length)
 {
-    reserve(size() + length);
-    std::copy(data, data + length, std::back_inserter(*this));
+    writeRaw(reinterpret_cast<const uint8_t*>(data), length);
 }
 
 void SerializationBuffer::writeRaw(const uint8_t* data, const std::size_t length)
 {
-    reserve(size() + length);
-    std::copy(data, data + length, std::back_inserter(*this));
+    if (length == 0) {
+        return;
+    }
+    std::size_t offset = size();
+    resize(offset + length);
+    std::memcpy(this->data() + offset, data, length);
 }
 
 void SerializationBuffer::readRaw(char* data, const std::size_t length) const
 {
-    const char* start = reinterpret_cast<const char*>(&at(pos));
-    std::copy(start, start + length, data);
-    pos += length;
+    readRaw(reinterpret_cast<uint8_t*>(data), length);
+}
+
+void SerializationBuffer::checkReadable(uint64_t count, std::size_t element_size) const
+{
+    // compared as a count, a corrupt length must not overflow the number of bytes
+    if (count > (size() - std::min(pos, size())) / element_size) {
+        throw std::out_of_range("SerializationBuffer: read past the end of the buffer");
+    }
 }
 
 void SerializationBuffer::readRaw(uint8_t* data, const std::size_t length) const
 {
-    const uint8_t* start = &at(pos);
-    std::copy(start, start + length, data);
+    if (length == 0) {
+        return;
+    }
+    checkReadable(length);
+    std::memcpy(data, this->data() + pos, length);
     pos += length;
 }
 
@@ -344,7 +463,9 @@ union _GDoubleIEEE754
 #error unknown ENDIAN type
 #endif /* !G_LITTLE_ENDIAN && !G_BIG_ENDIAN */
 
-SerializationBuffer& SerializationBuffer::operator<<(float f)
+namespace
+{
+void encodeFloat(float f, uint8_t* bytes)
 {
     _GFloatIEEE754 ieee;
     ieee.v_float = f;
@@ -354,41 +475,25 @@ SerializationBuffer& SerializationBuffer::operator<<(float f)
      *   1         23             8
      *   1   | 2 - 24      | 25 - 32
      */
-    uint8_t bytes[4];
-    // memset(&bytes[0], 0, 4);
     bytes[0] = ieee.mpn.sign << 7;
     bytes[0] |= (ieee.mpn.mantissa >> (23 - 7));
     bytes[1] = (ieee.mpn.mantissa >> (23 - 7 - 8)) & 0xFF;
     bytes[2] = (ieee.mpn.mantissa >> (23 - 7 - 16)) & 0xFF;
     bytes[3] = ieee.mpn.biased_exponent;
-
-    for (uint8_t i = 0; i < 4; ++i) {
-        push_back(bytes[i]);
-    }
-
-    return *this;
 }
 
-const SerializationBuffer& SerializationBuffer::operator>>(float& f) const
+float decodeFloat(const uint8_t* bytes)
 {
-    uint8_t bytes[4];
-    for (uint8_t i = 0; i < 4; ++i) {
-        bytes[i] = at(pos++);
-    }
-
     _GFloatIEEE754 ieee;
 
     ieee.mpn.sign = (bytes[0] & (1 << 7)) ? 1 : 0;
     ieee.mpn.mantissa = ((bytes[0] & (~(1 << 7))) << (23 - 7)) | (bytes[1] << (23 - 7 - 8)) | (bytes[2] << (23 - 7 - 16));
     ieee.mpn.biased_exponent = bytes[3];
 
-    f = ieee.v_float;
-
-    return *this;
+    return ieee.v_float;
 }
 
-// DOUBLES
-SerializationBuffer& SerializationBuffer::operator<<(double d)
+void encodeDouble(double d, uint8_t* bytes)
 {
     _GDoubleIEEE754 ieee;
     ieee.v_double = d;
@@ -398,8 +503,6 @@ SerializationBuffer& SerializationBuffer::operator<<(double d)
      *   1         11             20         |   32
      *   1   | 2 - 12         | 13 - 32      |   32
      */
-    uint8_t bytes[8];
-    // memset(&bytes[0], 0, 4);
     bytes[0] = ieee.mpn.sign << 7;
     bytes[0] |= (ieee.mpn.biased_exponent >> (11 - 7));
     bytes[1] = (ieee.mpn.biased_exponent << 4);
@@ -410,21 +513,10 @@ SerializationBuffer& SerializationBuffer::operator<<(double d)
     bytes[5] = (ieee.mpn.mantissa_low >> (2 * 8)) & 0xFF;
     bytes[6] = (ieee.mpn.mantissa_low >> (1 * 8)) & 0xFF;
     bytes[7] = (ieee.mpn.mantissa_low >> (0 * 8)) & 0xFF;
-
-    for (uint8_t i = 0; i < 8; ++i) {
-        push_back(bytes[i]);
-    }
-
-    return *this;
 }
 
-const SerializationBuffer& SerializationBuffer::operator>>(double& d) const
+double decodeDouble(const uint8_t* bytes)
 {
-    uint8_t bytes[8];
-    for (uint8_t i = 0; i < 8; ++i) {
-        bytes[i] = at(pos++);
-    }
-
     _GDoubleIEEE754 ieee;
 
     ieee.mpn.sign = (bytes[0] & (1 << 7)) ? 1 : 0;
@@ -433,11 +525,89 @@ const SerializationBuffer& SerializationBuffer::operator>>(double& d) const
 
     ieee.mpn.mantissa_low = (bytes[4] << (3 * 8)) | (bytes[5] << (2 * 8)) | (bytes[6] << (1 * 8)) | (bytes[7] << (0 * 8));
 
-    d = ieee.v_double;
+    return ieee.v_double;
+}
+}  // namespace
+
+// FLOATS
+SerializationBuffer& SerializationBuffer::operator<<(float f)
+{
+    uint8_t bytes[4];
+    encodeFloat(f, bytes);
+    insert(end(), bytes, bytes + 4);
 
     return *this;
 }
 
+const SerializationBuffer& SerializationBuffer::operator>>(float& f) const
+{
+    checkReadable(4);
+    f = decodeFloat(data() + pos);
+    pos += 4;
+
+    return *this;
+}
+
+// DOUBLES
+SerializationBuffer& SerializationBuffer::operator<<(double d)
+{
+    uint8_t bytes[8];
+    encodeDouble(d, bytes);
+    insert(end(), bytes, bytes + 8);
+
+    return *this;
+}
+
+const SerializationBuffer& SerializationBuffer::operator>>(double& d) const
+{
+    checkReadable(8);
+    d = decodeDouble(data() + pos);
+    pos += 8;
+
+    return *this;
+}
+
+// FLOATING POINT ARRAYS
+void SerializationBuffer::writeArray(const float* data, std::size_t count)
+{
+    std::size_t offset = size();
+    resize(offset + count * 4);
+    uint8_t* bytes = this->data() + offset;
+    for (std::size_t i = 0; i < count; ++i, bytes += 4) {
+        encodeFloat(data[i], bytes);
+    }
+}
+
+void SerializationBuffer::writeArray(const double* data, std::size_t count)
+{
+    std::size_t offset = size();
+    resize(offset + count * 8);
+    uint8_t* bytes = this->data() + offset;
+    for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+        encodeDouble(data[i], bytes);
+    }
+}
+
+void SerializationBuffer::readArray(float* data, std::size_t count) const
+{
+    checkReadable(count, 4);
+    const uint8_t* bytes = this->data() + pos;
+    for (std::size_t i = 0; i < count; ++i, bytes += 4) {
+        data[i] = decodeFloat(bytes);
+    }
+    pos += count * 4;
+}
+
+void SerializationBuffer::readArray(double* data, std::size_t count) const
+{
+    checkReadable(count, 8);
+    const uint8_t* bytes = this->data() + pos;
+    for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+        data[i] = decodeDouble(bytes);
+    }
+    pos += count * 8;
+}
+
 // YAML
 SerializationBuffer& SerializationBuffer::operator<<(const YAML::Node& node)
 {
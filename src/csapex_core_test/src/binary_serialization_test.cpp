@@ -7,8 +7,12 @@
 #include <csapex/serialization/io/csapex_io.h>
 #include <csapex/msg/io.h>
 #include <csapex_testing/mockup_msgs.h>
+#include <csapex/model/connection_description.h>
 
 #include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 
 using namespace csapex;
 using namespace connection_types;
@@ -285,6 +289,251 @@ TEST_F(BinarySerializationTest, TestMap)
     ASSERT_EQ(4, restored_map.at("d"));
 }
 
+TEST_F(BinarySerializationTest, TestInt64)
+{
+    std::vector<int64_t> values{ 0, 1, -1, 0x0123456789ABCDEFll, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max() };
+
+    for (int64_t i : values) {
+        SerializationBuffer buffer;
+        buffer << i;
+        ASSERT_EQ(SerializationBuffer::HEADER_LENGTH + sizeof(int64_t), buffer.size());
+
+        int64_t value;
+        buffer >> value;
+
+        ASSERT_EQ(i, value);
+    }
+}
+
+TEST_F(BinarySerializationTest, IntegersAreLittleEndianOnTheWire)
+{
+    SerializationBuffer buffer;
+    buffer << static_cast<uint32_t>(0x01020304);
+
+    ASSERT_EQ(0x04, buffer[SerializationBuffer::HEADER_LENGTH + 0]);
+    ASSERT_EQ(0x03, buffer[SerializationBuffer::HEADER_LENGTH + 1]);
+    ASSERT_EQ(0x02, buffer[SerializationBuffer::HEADER_LENGTH + 2]);
+    ASSERT_EQ(0x01, buffer[SerializationBuffer::HEADER_LENGTH + 3]);
+}
+
+TEST_F(BinarySerializationTest, ReadingPastTheEndThrows)
+{
+    SerializationBuffer buffer;
+    buffer << static_cast<uint16_t>(42);
+
+    uint32_t value;
+    ASSERT_THROW(buffer >> value, std::out_of_range);
+}
+
+TEST_F(BinarySerializationTest, IntegralVectorsAreCopiedInBulk)
+{
+    std::vector<int32_t> values;
+    for (int i = 0; i < 200; ++i) {
+        values.push_back(i * 100000 - 7);
+    }
+
+    SerializationBuffer buffer;
+    buffer << values;
+
+    // one length byte followed by the elements in the same layout as single integers
+    SerializationBuffer expected;
+    expected << static_cast<uint8_t>(values.size());
+    for (int32_t v : values) {
+        expected << v;
+    }
+    ASSERT_EQ(std::vector<uint8_t>(expected.begin(), expected.end()), std::vector<uint8_t>(buffer.begin(), buffer.end()));
+
+    std::vector<int32_t> restored;
+    buffer >> restored;
+    ASSERT_EQ(values, restored);
+}
+
+TEST_F(BinarySerializationTest, BoolVectorsAreStillSupported)
+{
+    std::vector<bool> values{ true, false, false, true };
+
+    SerializationBuffer buffer;
+    buffer << values;
+
+    std::vector<bool> restored;
+    buffer >> restored;
+    ASSERT_EQ(values, restored);
+}
+
+TEST_F(BinarySerializationTest, FloatingPointVectorsKeepTheElementEncoding)
+{
+    std::vector<float> floats{ 1.f, -2.5f, 3.75f, 1e-30f };
+    std::vector<double> doubles{ 1.0, -2.5, 3.75, 1e-300 };
+
+    SerializationBuffer elementwise;
+    elementwise.writeLength(floats.size());
+    for (float f : floats) {
+        elementwise << f;
+    }
+    elementwise.writeLength(doubles.size());
+    for (double d : doubles) {
+        elementwise << d;
+    }
+
+    SerializationBuffer buffer;
+    buffer << floats << doubles;
+    ASSERT_EQ(std::vector<uint8_t>(elementwise.begin(), elementwise.end()), std::vector<uint8_t>(buffer.begin(), buffer.end()));
+
+    std::vector<float> restored_floats;
+    std::vector<double> restored_doubles;
+    buffer >> restored_floats >> restored_doubles;
+    ASSERT_EQ(floats, restored_floats);
+    ASSERT_EQ(doubles, restored_doubles);
+}
+
+TEST_F(BinarySerializationTest, CorruptVectorLengthsAreRejected)
+{
+    SerializationBuffer buffer;
+    buffer.writeLength(std::numeric_limits<uint64_t>::max() / 4);
+    buffer << 1.0;
+
+    std::vector<double> doubles;
+    ASSERT_THROW(buffer >> doubles, std::out_of_range);
+
+    buffer.rewind();
+    std::vector<int32_t> integers;
+    ASSERT_THROW(buffer >> integers, std::out_of_range);
+}
+
+TEST_F(BinarySerializationTest, ReserveAdditionalAvoidsReallocation)
+{
+    SerializationBuffer buffer;
+    buffer.reserveAdditional(1024);
+    const uint8_t* data = buffer.data();
+
+    for (int i = 0; i < 256; ++i) {
+        buffer << static_cast<uint32_t>(i);
+    }
+    ASSERT_EQ(data, buffer.data());
+}
+
+TEST_F(BinarySerializationTest, BulkThroughputBenchmark)
+{
+    const std::size_t count = 1 << 22;
+    std::vector<double> values(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = i * 0.5;
+    }
+    double megabytes = count * sizeof(double) / (1024.0 * 1024.0);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    SerializationBuffer elementwise;
+    for (double v : values) {
+        elementwise << v;
+    }
+    std::vector<double> elementwise_restored(count);
+    for (double& v : elementwise_restored) {
+        elementwise >> v;
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+
+    SerializationBuffer bulk;
+    bulk << values;
+    std::vector<double> bulk_restored;
+    bulk >> bulk_restored;
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ASSERT_EQ(values, elementwise_restored);
+    ASSERT_EQ(values, bulk_restored);
+
+    double elementwise_s = std::chrono::duration<double>(middle - start).count();
+    double bulk_s = std::chrono::duration<double>(end - middle).count();
+    std::cout << "[ BENCHMARK ] " << megabytes << " MB of doubles: element-wise " << (megabytes / elementwise_s) << " MB/s, bulk " << (megabytes / bulk_s) << " MB/s" << std::endl;
+}
+
+TEST_F(BinarySerializationTest, ShortContainersKeepTheSingleByteLength)
+{
+    std::vector<std::string> values{ "a", "b", "c" };
+
+    SerializationBuffer buffer;
+    buffer << values;
+
+    ASSERT_EQ(3, buffer[SerializationBuffer::HEADER_LENGTH]);
+}
+
+TEST_F(BinarySerializationTest, LegacyContainerEncodingCanBeRead)
+{
+    // format 1.0.0: a single length byte followed by the elements
+    SerializationBuffer buffer;
+    buffer << static_cast<uint8_t>(254);
+    for (int i = 0; i < 254; ++i) {
+        buffer << static_cast<int16_t>(-i);
+    }
+
+    std::vector<int16_t> restored;
+    buffer >> restored;
+    ASSERT_EQ(254u, restored.size());
+    for (int i = 0; i < 254; ++i) {
+        ASSERT_EQ(-i, restored[i]);
+    }
+}
+
+TEST_F(BinarySerializationTest, VarintLengthsRoundTrip)
+{
+    std::vector<uint64_t> lengths{ 0, 1, 254, 255, 256, 16383, 16384, 1ull << 32, std::numeric_limits<uint64_t>::max() };
+
+    SerializationBuffer buffer;
+    for (uint64_t length : lengths) {
+        buffer.writeLength(length);
+    }
+    for (uint64_t length : lengths) {
+        ASSERT_EQ(length, buffer.readLength());
+    }
+}
+
+TEST_F(BinarySerializationTest, ContainersWithManyElements)
+{
+    std::vector<std::string> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(std::to_string(i));
+    }
+
+    SerializationBuffer buffer;
+    buffer << values;
+
+    std::vector<std::string> restored;
+    buffer >> restored;
+    ASSERT_EQ(values, restored);
+}
+
+TEST_F(BinarySerializationTest, LongStrings)
+{
+    std::string value(100000, 'x');
+    value.back() = 'y';
+
+    SerializationBuffer buffer;
+    buffer << value;
+    buffer << std::string("next");
+
+    std::string restored;
+    buffer >> restored;
+    ASSERT_EQ(value, restored);
+    buffer >> restored;
+    ASSERT_EQ("next", restored);
+}
+
+TEST_F(BinarySerializationTest, VectorWithTenMillionElements)
+{
+    const std::size_t count = 10 * 1000 * 1000;
+    std::vector<int32_t> values(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<int32_t>(i * 7);
+    }
+
+    SerializationBuffer buffer;
+    buffer << values;
+
+    std::vector<int32_t> restored;
+    buffer >> restored;
+    ASSERT_EQ(count, restored.size());
+    ASSERT_EQ(values, restored);
+}
+
 TEST_F(BinarySerializationTest, TestUUID)
 {
     UUID uuid1 = UUIDProvider::makeUUID_without_parent("test:|:1");
@@ -301,6 +550,43 @@ TEST_F(BinarySerializationTest, TestUUID)
     ASSERT_EQ(uuid2.getFullName(), value.getFullName());
 }
 
+TEST_F(BinarySerializationTest, ConnectionDescriptionsContainTheBuffer)
+{
+    ConnectionDescription description(UUIDProvider::makeUUID_without_parent("a:|:out_0"), UUIDProvider::makeUUID_without_parent("b:|:in_0"), nullptr, 1, 0, false, {});
+    description.queue_depth = 4;
+    description.buffer_policy = BufferPolicy::DROP_OLDEST;
+
+    SerializationBuffer buffer;
+    buffer << description;
+
+    ConnectionDescription restored;
+    buffer >> restored;
+    ASSERT_EQ(4, restored.queue_depth);
+    ASSERT_EQ(BufferPolicy::DROP_OLDEST, restored.buffer_policy);
+}
+
+TEST_F(BinarySerializationTest, ConnectionDescriptionsWithoutBufferCanBeRead)
+{
+    ConnectionDescription description(UUIDProvider::makeUUID_without_parent("a:|:out_0"), UUIDProvider::makeUUID_without_parent("b:|:in_0"), nullptr, 1, 0, false, {});
+    description.queue_depth = 4;
+
+    // written like before the buffer was added
+    SemanticVersion legacy;
+    SerializationBuffer buffer;
+    buffer << legacy;
+    description.serialize(buffer, legacy);
+    buffer << static_cast<uint8_t>(42);
+
+    ConnectionDescription restored;
+    buffer >> restored;
+    ASSERT_EQ(description.to.getFullName(), restored.to.getFullName());
+    ASSERT_EQ(1, restored.queue_depth);
+
+    uint8_t next;
+    buffer >> next;
+    ASSERT_EQ(42, next);
+}
+
 TEST_F(BinarySerializationTest, SpecificTokenSerialization)
 {
     SerializationBuffer data;
@@ -194,4 +194,45 @@ TEST_F(CommandTest, DeleteAllWorks)
 
     EXPECT_EQ(0, graph->countNodes());
 }
+TEST_F(CommandTest, MainLoopOnlyWakesUpForDeferredCommands)
+{
+    ExceptionHandler eh(false);
+    SettingsImplementation settings;
+
+    std::string path_to_bin("");
+    settings.set("path_to_bin", path_to_bin);
+    settings.set("use_boot_plugins", false);
+
+    CsApexCore core(settings, eh);
+
+    NodeFactoryImplementation& factory = *core.getNodeFactory();
+    GraphFacadeImplementationPtr graph = core.getRoot();
+
+    factory.registerNodeType(std::make_shared<NodeConstructor>("MockupSource", std::bind(&detail::makeNode<MockupSource>)));
+
+    CommandDispatcher& dispatcher = *core.getCommandDispatcher();
+
+    core.startMainLoop();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // IDLE
+    std::size_t wake_ups = core.getMainLoopWakeUps();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(wake_ups, core.getMainLoopWakeUps());
+
+    // DEFERRED
+    auto node_uuid = graph->generateUUID("MockupSource");
+    dispatcher.executeLater(std::make_shared<command::AddNode>(graph->getAbsoluteUUID(), "MockupSource", Point{ 50.0, 50.0 }, node_uuid, NodeStatePtr()));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (graph->countNodes() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(1, graph->countNodes());
+    EXPECT_LT(wake_ups, core.getMainLoopWakeUps());
+
+    core.shutdown();
+    core.joinMainLoop();
+}
+
 }  // namespace csapex
@@ -60,6 +60,33 @@ private:
     Output* output_;
 };
 
+class IterationDoubler
+{
+public:
+    IterationDoubler()
+    {
+    }
+
+    void setup(csapex::NodeModifier& node_modifier)
+    {
+        input_ = node_modifier.addInput<int>("input");
+        output_ = node_modifier.addOutput<int>("output");
+    }
+
+    void setupParameters(Parameterizable& /*parameters*/)
+    {
+    }
+
+    void process(NodeModifier& node_modifier, Parameterizable& /*parameters*/)
+    {
+        msg::publish(output_, 2 * msg::getValue<int>(input_));
+    }
+
+private:
+    Input* input_;
+    Output* output_;
+};
+
 class IterationSource : public Node
 {
 public:
@@ -169,6 +196,10 @@ protected:
             csapex::NodeConstructor::Ptr constructor(new csapex::NodeConstructor("IterationCombiner", std::bind(&ContainerIterationTest::makeCombiner)));
             factory.registerNodeType(constructor);
         }
+        {
+            csapex::NodeConstructor::Ptr constructor(new csapex::NodeConstructor("IterationDoubler", std::bind(&ContainerIterationTest::makeDoubler)));
+            factory.registerNodeType(constructor);
+        }
         {
             csapex::NodeConstructor::Ptr constructor(new csapex::NodeConstructor("IterationSource", std::bind(&ContainerIterationTest::makeSource)));
             factory.registerNodeType(constructor);
@@ -199,6 +230,10 @@ protected:
     {
         return NodePtr(new NodeWrapper<IterationCombiner>());
     }
+    static NodePtr makeDoubler()
+    {
+        return NodePtr(new NodeWrapper<IterationDoubler>());
+    }
     static NodePtr makeSource()
     {
         return NodePtr(new IterationSource());
@@ -415,4 +450,82 @@ TEST_F(ContainerIterationTest, VectorCanBeForwardedAndIteratedInSubGraph)
         }
     }
 }
+
+TEST_F(ContainerIterationTest, VectorCanBeIteratedInPipelinedSubGraph)
+{
+    GraphFacadeImplementation main_graph_facade(executor, graph, graph_node);
+
+    // MAIN GRAPH
+    NodeFacadeImplementationPtr src = factory.makeNode("IterationSource", UUIDProvider::makeUUID_without_parent("src"), graph);
+    ASSERT_NE(nullptr, src);
+    graph->addNode(src);
+
+    NodeFacadeImplementationPtr constant = factory.makeNode("IterationConstant", UUIDProvider::makeUUID_without_parent("const"), graph);
+    ASSERT_NE(nullptr, constant);
+    graph->addNode(constant);
+
+    NodeFacadeImplementationPtr sink_p = factory.makeNode("IterationSink", UUIDProvider::makeUUID_without_parent("Sink"), graph);
+    main_graph_facade.addNode(sink_p);
+    std::shared_ptr<IterationSink> sink = std::dynamic_pointer_cast<IterationSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    // NESTED GRAPH
+    NodeFacadeImplementationPtr sub_graph_node_facade = factory.makeNode("csapex::Graph", graph->generateUUID("subgraph"), graph);
+    SubgraphNodePtr sub_graph = std::dynamic_pointer_cast<SubgraphNode>(sub_graph_node_facade->getNode());
+    apex_assert_hard(sub_graph);
+
+    GraphFacadeImplementation sub_graph_facade(executor, sub_graph->getLocalGraph(), sub_graph);
+
+    // two stages, so that consecutive elements can be processed at the same time
+    NodeFacadeImplementationPtr n2 = factory.makeNode("IterationCombiner", UUIDProvider::makeUUID_without_parent("n2"), sub_graph->getLocalGraph());
+    ASSERT_NE(nullptr, n2);
+    sub_graph_facade.addNode(n2);
+
+    NodeFacadeImplementationPtr n3 = factory.makeNode("IterationDoubler", UUIDProvider::makeUUID_without_parent("n3"), sub_graph->getLocalGraph());
+    ASSERT_NE(nullptr, n3);
+    sub_graph_facade.addNode(n3);
+
+    apex_assert_hard(sub_graph_node_facade);
+    graph->addNode(sub_graph_node_facade);
+
+    auto type = connection_types::GenericVectorMessage::make<int>();
+
+    auto in_vec_map = sub_graph->addForwardingInput(type, "forwarding_vector", false);
+    auto in_const_map = sub_graph->addForwardingInput(makeEmpty<connection_types::GenericValueMessage<int>>(), "forwarding_const", false);
+    auto out_map = sub_graph->addForwardingOutput(type, "forwarding");
+
+    sub_graph->setIterationEnabled(in_vec_map.external, true);
+    sub_graph->setIterationPipelineDepth(4);
+    ASSERT_EQ(4, sub_graph->getIterationPipelineDepth());
+
+    // forwarding connections
+    sub_graph_facade.connect(in_vec_map.internal, n2, "input_a");
+    sub_graph_facade.connect(in_const_map.internal, n2, "input_b");
+    sub_graph_facade.connect(n2, "output", n3, "input");
+    sub_graph_facade.connect(n3, "output", out_map.internal);
+
+    // crossing connections
+    main_graph_facade.connect(src, "output", in_vec_map.external);
+    main_graph_facade.connect(constant, "output", in_const_map.external);
+    main_graph_facade.connect(out_map.external, sink_p, "input");
+
+    executor.start();
+
+    // execution
+    ASSERT_TRUE(sink->getValue().empty());
+    for (int iter = 0; iter < 23; ++iter) {
+        step();
+
+        std::vector<int> res = sink->getValue();
+
+        ASSERT_EQ(8, res.size());
+
+        int constant = iter;
+
+        // the results are collected in the order of the input elements
+        for (std::size_t j = 0; j < res.size(); ++j) {
+            ASSERT_EQ(2 * iter * j * constant, res[j]);
+        }
+    }
+}
 }  // namespace csapex
@@ -1,6 +1,7 @@
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/node.h>
 #include <csapex/model/node_handle.h>
+#include <csapex/model/node_state.h>
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/factory/node_factory_impl.h>
 #include <csapex/core/settings/settings_impl.h>
@@ -9,8 +10,18 @@
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/msg/any_message.h>
 #include <csapex/msg/input.h>
+#include <csapex/msg/output.h>
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/connection.h>
+#include <csapex/core/graphio.h>
 
 #include <csapex_testing/csapex_test_case.h>
+#include <csapex_testing/node_constructing_test.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <chrono>
+#include <iostream>
 
 namespace csapex
 {
@@ -226,4 +237,257 @@ TEST_F(GraphTest, RootCanBeFound)
     ASSERT_EQ(main_facade, nodefacade_found);
 }
 
+class GraphIndexTest : public NodeConstructingTest
+{
+protected:
+    // builds a chain of nodes in a separate graph and stores it
+    YAML::Node makeChainConfig(const std::vector<std::string>& names)
+    {
+        SubgraphNodePtr config_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+        GraphImplementationPtr config_graph = config_node->getLocalGraph();
+        GraphFacadeImplementation config_facade(executor, config_graph, config_node);
+
+        NodeFacadeImplementationPtr previous;
+        for (const std::string& name : names) {
+            NodeFacadeImplementationPtr nf = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent(name), config_graph);
+            config_facade.addNode(nf);
+            if (previous) {
+                config_facade.connect(previous, "output", nf, "input_a");
+            }
+            previous = nf;
+        }
+
+        YAML::Node config;
+        GraphIO io(config_facade, &factory, true);
+        io.saveGraphTo(config);
+        return config;
+    }
+};
+
+TEST_F(GraphIndexTest, ConnectionsCanBeFoundUntilDeleted)
+{
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+
+    NodeFacadeImplementationPtr a = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent("a"), graph);
+    facade.addNode(a);
+    NodeFacadeImplementationPtr b = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent("b"), graph);
+    facade.addNode(b);
+
+    ConnectionPtr c = facade.connect(a, "output", b, "input_a");
+    ASSERT_NE(nullptr, c);
+
+    UUID from = c->from()->getUUID();
+    UUID to = c->to()->getUUID();
+
+    EXPECT_TRUE(graph->isConnected(from, to));
+    EXPECT_EQ(c, graph->getConnection(from, to));
+    EXPECT_EQ(c, graph->getConnectionWithId(c->id()));
+    EXPECT_EQ(a->getNodeHandle().get(), graph->findNodeHandleForConnector(from));
+    EXPECT_EQ(b->getNodeHandle().get(), graph->findNodeHandleForConnector(to));
+
+    graph->deleteConnection(c);
+
+    EXPECT_FALSE(graph->isConnected(from, to));
+    EXPECT_EQ(nullptr, graph->getConnection(from, to));
+    EXPECT_EQ(nullptr, graph->getConnectionWithId(c->id()));
+
+    graph->deleteNode(b->getUUID());
+
+    EXPECT_EQ(nullptr, graph->findNodeHandleNoThrow(b->getUUID()));
+    EXPECT_EQ(nullptr, graph->findConnectorNoThrow(to));
+    EXPECT_EQ(a->getNodeHandle().get(), graph->findNodeHandleNoThrow(a->getUUID()));
+}
+
+TEST_F(GraphIndexTest, LoadingLargeGraphBenchmark)
+{
+    const int nodes = 5000;
+
+    YAML::Node store;
+    std::size_t connections = 0;
+    {
+        GraphFacadeImplementation facade(executor, graph, graph_node);
+
+        graph->beginTransaction();
+        std::vector<NodeFacadeImplementationPtr> node_facades;
+        for (int i = 0; i < nodes; ++i) {
+            NodeFacadeImplementationPtr nf = factory.makeNode("DynamicMultiplier", UUIDProvider::makeUUID_without_parent("node_" + std::to_string(i)), graph);
+            facade.addNode(nf);
+            node_facades.push_back(nf);
+        }
+        // every node feeds its two successors, which results in roughly two connections per node
+        facade.connect(node_facades[0], "output", node_facades[1], "input_b");
+        for (int i = 0; i + 1 < nodes; ++i) {
+            facade.connect(node_facades[i], "output", node_facades[i + 1], "input_a");
+            if (i + 2 < nodes) {
+                facade.connect(node_facades[i], "output", node_facades[i + 2], "input_b");
+            }
+        }
+        graph->finalizeTransaction();
+
+        connections = graph->getConnections().size();
+        ASSERT_EQ(2u * nodes - 2, connections);
+
+        GraphIO io(facade, &factory, true);
+        io.saveGraphTo(store);
+    }
+
+    SubgraphNodePtr loaded_node = std::make_shared<SubgraphNode>(std::make_shared<GraphImplementation>());
+    GraphImplementationPtr loaded_graph = loaded_node->getLocalGraph();
+    GraphFacadeImplementation loaded_facade(executor, loaded_graph, loaded_node);
+
+    GraphIO io(loaded_facade, &factory, true);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_NO_THROW(io.loadGraphFrom(store));
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(static_cast<std::size_t>(nodes), loaded_graph->countNodes());
+    EXPECT_EQ(connections, loaded_graph->getConnections().size());
+
+    std::cout << "[ BENCHMARK ] loading " << nodes << " nodes and " << connections << " connections took " << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() << "ms" << std::endl;
+}
+
+TEST_F(GraphIndexTest, BuffersAreSavedWithThePolicyName)
+{
+    YAML::Node config = makeChainConfig({ "a", "b" });
+    ASSERT_EQ(1u, config["connections"].size());
+    config["connections"][0]["buffers"].push_back(YAML::Load("{depth: 3, policy: drop_oldest}"));
+
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+    GraphIO io(facade, &factory, true);
+    ASSERT_NO_THROW(io.loadGraphFrom(config));
+
+    ASSERT_EQ(1u, graph->getConnections().size());
+    ConnectionPtr connection = graph->getConnections().front();
+    EXPECT_EQ(3, connection->getQueueDepth());
+    EXPECT_EQ(BufferPolicy::DROP_OLDEST, connection->getBufferPolicy());
+
+    YAML::Node saved;
+    io.saveGraphTo(saved);
+    EXPECT_EQ(3, saved["connections"][0]["buffers"][0]["depth"].as<int>());
+    EXPECT_EQ("drop_oldest", saved["connections"][0]["buffers"][0]["policy"].as<std::string>());
+}
+
+TEST_F(GraphIndexTest, InvalidQueueDepthsAreLoadErrors)
+{
+    YAML::Node config = makeChainConfig({ "a", "b" });
+    config["connections"][0]["buffers"].push_back(YAML::Load("{depth: 0, policy: block}"));
+
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+    GraphIO io(facade, &factory, true);
+    EXPECT_THROW(io.loadGraphFrom(config), std::logic_error);
+}
+
+TEST_F(GraphIndexTest, ReloadOnlyRecreatesChangedNodes)
+{
+    YAML::Node before = makeChainConfig({ "a", "b", "c" });
+    YAML::Node after = makeChainConfig({ "a", "b", "d" });
+
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+    GraphIO io(facade, &factory, true);
+    ASSERT_NO_THROW(io.loadGraphFrom(before));
+    ASSERT_EQ(3u, graph->countNodes());
+
+    UUID a = UUIDProvider::makeUUID_without_parent("a");
+    UUID b = UUIDProvider::makeUUID_without_parent("b");
+    NodeFacadePtr a_before = graph->findNodeFacade(a);
+    NodeFacadePtr b_before = graph->findNodeFacade(b);
+    ConnectionPtr a_to_b;
+    for (const ConnectionPtr& c : graph->getConnections()) {
+        if (c->from()->getUUID().parentUUID() == a) {
+            a_to_b = c;
+        }
+    }
+    ASSERT_NE(nullptr, a_to_b);
+
+    GraphIO::ReloadStatistics statistics = io.reloadGraphFrom(after);
+
+    EXPECT_EQ(2u, statistics.nodes_kept);
+    EXPECT_EQ(1u, statistics.nodes_created);
+    EXPECT_EQ(1u, statistics.nodes_removed);
+    EXPECT_EQ(1u, statistics.connections_created);
+    EXPECT_EQ(1u, statistics.connections_removed);
+
+    // the unchanged part of the graph keeps running
+    EXPECT_EQ(a_before, graph->findNodeFacade(a));
+    EXPECT_EQ(b_before, graph->findNodeFacade(b));
+    EXPECT_EQ(a_to_b, graph->getConnection(a_to_b->from()->getUUID(), a_to_b->to()->getUUID()));
+
+    EXPECT_EQ(nullptr, graph->findNodeFacadeNoThrow(UUIDProvider::makeUUID_without_parent("c")));
+    NodeFacadePtr d = graph->findNodeFacadeNoThrow(UUIDProvider::makeUUID_without_parent("d"));
+    ASSERT_NE(nullptr, d);
+
+    ASSERT_EQ(3u, graph->countNodes());
+    ASSERT_EQ(2u, graph->getConnections().size());
+    for (const ConnectionPtr& c : graph->getConnections()) {
+        if (c != a_to_b) {
+            EXPECT_EQ(b, c->from()->getUUID().parentUUID());
+            EXPECT_EQ(d->getUUID(), c->to()->getUUID().parentUUID());
+        }
+    }
+}
+
+TEST_F(GraphIndexTest, ReloadComparesToTheCurrentGraph)
+{
+    YAML::Node config = makeChainConfig({ "a", "b", "c" });
+
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+    GraphIO io(facade, &factory, true);
+    ASSERT_NO_THROW(io.loadGraphFrom(config));
+
+    // the graph is edited after loading, so reloading the same document has to restore it
+    UUID c = UUIDProvider::makeUUID_without_parent("c");
+    for (const ConnectionPtr& connection : graph->getConnections()) {
+        if (connection->to()->getUUID().parentUUID() == c) {
+            graph->deleteConnection(connection);
+        }
+    }
+    graph->deleteNode(c);
+    ASSERT_EQ(1u, graph->getConnections().size());
+    ASSERT_EQ(2u, graph->countNodes());
+
+    GraphIO::ReloadStatistics statistics = io.reloadGraphFrom(config);
+
+    EXPECT_EQ(2u, statistics.nodes_kept);
+    EXPECT_EQ(1u, statistics.nodes_created);
+    EXPECT_EQ(0u, statistics.nodes_removed);
+    EXPECT_EQ(1u, statistics.connections_created);
+
+    EXPECT_EQ(3u, graph->countNodes());
+    EXPECT_NE(nullptr, graph->findNodeFacadeNoThrow(c));
+    EXPECT_EQ(2u, graph->getConnections().size());
+}
+
+TEST_F(GraphIndexTest, ReloadUpdatesTheViewOfNodesInPlace)
+{
+    YAML::Node before = makeChainConfig({ "a", "b" });
+
+    GraphFacadeImplementation facade(executor, graph, graph_node);
+    GraphIO io(facade, &factory, true);
+    ASSERT_NO_THROW(io.loadGraphFrom(before));
+
+    UUID b = UUIDProvider::makeUUID_without_parent("b");
+    NodeFacadePtr b_before = graph->findNodeFacade(b);
+
+    YAML::Node after = YAML::Clone(before);
+    for (YAML::Node node : after["nodes"]) {
+        if (node["uuid"].as<std::string>() == b.getFullName()) {
+            node["pos"][0] = 42.0;
+            node["pos"][1] = 23.0;
+            node["color"][0] = 255;
+        }
+    }
+
+    GraphIO::ReloadStatistics statistics = io.reloadGraphFrom(after);
+
+    EXPECT_EQ(2u, statistics.nodes_kept);
+    EXPECT_EQ(0u, statistics.nodes_created);
+    EXPECT_EQ(0u, statistics.nodes_removed);
+
+    EXPECT_EQ(b_before, graph->findNodeFacade(b));
+    NodeStatePtr state = graph->findNodeHandle(b)->getNodeState();
+    EXPECT_EQ(42.0, state->getPos().x);
+    EXPECT_EQ(23.0, state->getPos().y);
+}
+
 }  // namespace csapex
@@ -23,6 +23,8 @@
 #include <csapex_testing/mockup_nodes.h>
 #include <csapex_testing/test_exception_handler.h>
 
+#include <chrono>
+#include <iostream>
 #include <mutex>
 #include <condition_variable>
 
@@ -30,8 +32,32 @@
 
 namespace csapex
 {
+class PayloadPassThrough : public Node
+{
+public:
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<std::string>("payload");
+        out = node_modifier.addOutput<std::string>("payload");
+    }
+
+    void process() override
+    {
+        msg::publish(out, msg::getMessage(in));
+    }
+
+private:
+    Input* in;
+    Output* out;
+};
+
 class NodeWorkerTest : public SteppingTest
 {
+public:
+    NodeWorkerTest()
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("PayloadPassThrough", []() { return NodePtr(new PayloadPassThrough); }));
+    }
 };
 
 void runSyncTest(NodeFacadeImplementationPtr node_facade, int value = 23)
@@ -285,4 +311,72 @@ TEST_F(NodeWorkerTest, SubprocessHandlesAsynchronousPorts)
 
     slot->removeConnection(tmp_out.get());
 }
+
+namespace
+{
+double measurePayloadRoundTrip(NodeFacadeImplementationPtr node_facade, std::size_t payload_size, int iterations)
+{
+    NodeHandle& nh = *node_facade->getNodeHandle();
+    const std::string node_id = nh.getUUID().getFullName();
+    InputPtr input = nh.getInput(UUIDProvider::makeUUID_without_parent(node_id + ":|:in_0"));
+    OutputPtr output = nh.getOutput(UUIDProvider::makeUUID_without_parent(node_id + ":|:out_0"));
+    EXPECT_NE(nullptr, input);
+    EXPECT_NE(nullptr, output);
+    if (!input || !output) {
+        return 0.0;
+    }
+
+    const std::string payload(payload_size, 'p');
+
+    std::chrono::nanoseconds total(0);
+    for (int i = 0; i < iterations; ++i) {
+        OutputPtr tmp_out = std::make_shared<StaticOutput>(UUIDProvider::makeUUID_without_parent("tmp_out"));
+        ConnectionPtr connection = DirectConnection::connect(tmp_out, input);
+
+        msg::publish(tmp_out.get(), payload);
+        tmp_out->commitMessages(false);
+        tmp_out->publish();
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT_TRUE(node_facade->startProcessingMessages());
+        total += std::chrono::steady_clock::now() - start;
+
+        auto msg_out = std::dynamic_pointer_cast<connection_types::GenericValueMessage<std::string> const>(output->getToken()->getTokenData());
+        EXPECT_NE(nullptr, msg_out);
+        if (msg_out) {
+            EXPECT_EQ(payload_size, msg_out->value.size());
+        }
+
+        input->removeConnection(tmp_out.get());
+    }
+
+    return std::chrono::duration<double, std::micro>(total).count() / iterations;
+}
+}  // namespace
+
+TEST_F(NodeWorkerTest, SubprocessPayloadLatencyBenchmark)
+{
+    NodeStatePtr direct_state = std::make_shared<NodeState>(nullptr);
+    direct_state->setExecutionType(ExecutionType::DIRECT);
+    NodeFacadeImplementationPtr direct = factory.makeNode("PayloadPassThrough", UUIDProvider::makeUUID_without_parent("PayloadDirect"), graph, direct_state);
+
+    NodeStatePtr subprocess_state = std::make_shared<NodeState>(nullptr);
+    subprocess_state->setExecutionType(ExecutionType::SUBPROCESS);
+    NodeFacadeImplementationPtr subprocess = factory.makeNode("PayloadPassThrough", UUIDProvider::makeUUID_without_parent("PayloadSubprocess"), graph, subprocess_state);
+
+    struct Case
+    {
+        std::string label;
+        std::size_t size;
+        int iterations;
+    };
+    std::vector<Case> cases{ { "1 KB", 1024, 200 }, { "1 MB", 1024 * 1024, 20 }, { "50 MB", 50 * 1024 * 1024, 3 } };
+
+    for (const Case& c : cases) {
+        double direct_us = measurePayloadRoundTrip(direct, c.size, c.iterations);
+        double subprocess_us = measurePayloadRoundTrip(subprocess, c.size, c.iterations);
+
+        std::cout << "[ BENCHMARK ] " << c.label << " payload: DIRECT " << direct_us << " us, SUBPROCESS " << subprocess_us << " us per message" << std::endl;
+    }
+}
 }  // namespace csapex
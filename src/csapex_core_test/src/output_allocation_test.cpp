@@ -5,6 +5,9 @@
 #include <csapex/model/node_state.h>
 #include <csapex/msg/message_allocator.h>
 #include <csapex/msg/output.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/model/node_worker.h>
+#include <csapex/profiling/profiler_impl.h>
 
 #include <csapex_testing/test_exception_handler.h>
 #include <csapex_testing/mockup_nodes.h>
@@ -157,6 +160,60 @@ TEST_F(OutputAllocationTest, AllocatorCanBeSet)
     EXPECT_STREQ("frame", msgptr->frame_id.c_str());
 }
 
+TEST_F(OutputAllocationTest, PooledAllocatorRecyclesReleasedMessages)
+{
+    MessageAllocator allocator;
+    allocator.enablePooling();
+
+    using M = connection_types::GenericValueMessage<int>;
+
+    M::Ptr first = allocator.allocate<M>(42, "frame");
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(42, first->value);
+
+    const M* first_address = first.get();
+    first.reset();
+
+    M::Ptr second = allocator.allocate<M>(23, "frame");
+    ASSERT_NE(nullptr, second);
+    EXPECT_EQ(23, second->value);
+    EXPECT_EQ(first_address, second.get());
+
+    EXPECT_EQ(1u, allocator.getPoolMisses()->get());
+    EXPECT_EQ(1u, allocator.getPoolHits()->get());
+}
+
+TEST_F(OutputAllocationTest, PooledOutputDoesNotAllocateInSteadyState)
+{
+    NodeFacadeImplementationPtr nf = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("src1"), graph);
+    ASSERT_NE(nullptr, nf);
+
+    OutputPtr output = testing::getOutput(nf, "out_0");
+    ASSERT_NE(nullptr, output);
+
+    nf->getNodeHandle()->enableMessagePooling(output.get());
+    ASSERT_TRUE(output->isPooling());
+
+    // the first messages fill the pool, every following envelope is recycled
+    for (int i = 0; i < 10; ++i) {
+        msg::publish(output.get(), i);
+    }
+    std::size_t misses = output->getPoolMisses()->get();
+
+    for (int i = 0; i < 1000; ++i) {
+        msg::publish(output.get(), i);
+    }
+
+    EXPECT_EQ(misses, output->getPoolMisses()->get());
+    EXPECT_GE(output->getPoolHits()->get(), 2000u);
+
+    NodeWorkerPtr worker = nf->getNodeWorker().lock();
+    ASSERT_NE(nullptr, worker);
+    std::shared_ptr<ProfilerImplementation> profiler = worker->getProfiler();
+    ASSERT_NE(nullptr, profiler);
+    EXPECT_EQ(output->getPoolHits(), profiler->getCounter(output->getLabel() + " pool hits"));
+}
+
 using namespace boost::interprocess;
 
 template <typename T>
@@ -0,0 +1,154 @@
+#include <csapex/model/parameterizable.h>
+#include <csapex/model/parameter_handle.h>
+#include <csapex/param/parameter_factory.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace csapex
+{
+class ParameterHandleTest : public CsApexTestCase
+{
+protected:
+    ParameterHandleTest()
+    {
+        params.addParameter(param::factory::declareValue("number", 42));
+        params.addParameter(param::factory::declareValue("factor", 0.5));
+        params.addParameter(param::factory::declareText("text", "foo"));
+    }
+
+    Parameterizable params;
+};
+
+TEST_F(ParameterHandleTest, HandlesReadTheInitialValue)
+{
+    ParameterHandle<int> number = params.getParameterHandle<int>("number");
+    ParameterHandle<double> factor = params.getParameterHandle<double>("factor");
+    ParameterHandle<std::string> text = params.getParameterHandle<std::string>("text");
+
+    ASSERT_TRUE(number.isValid());
+    EXPECT_EQ(42, number.get());
+    EXPECT_DOUBLE_EQ(0.5, factor.get());
+    EXPECT_EQ("foo", *text);
+}
+
+TEST_F(ParameterHandleTest, HandlesAreUpdatedWithTheChangedParameters)
+{
+    ParameterHandle<int> number = params.getParameterHandle<int>("number");
+    ParameterHandle<std::string> text = params.getParameterHandle<std::string>("text");
+
+    params.setParameter("number", 23);
+    params.setParameter<std::string>("text", "bar");
+
+    // like callbacks, the new values become visible when the changes are handled
+    EXPECT_EQ(42, number.get());
+    EXPECT_EQ("foo", text.get());
+
+    params.getChangedParameters();
+
+    EXPECT_EQ(23, number.get());
+    EXPECT_EQ("bar", text.get());
+}
+
+TEST_F(ParameterHandleTest, CopiesShareTheValue)
+{
+    ParameterHandle<int> number = params.getParameterHandle<int>("number");
+    ParameterHandle<int> copy = number;
+
+    params.setParameter("number", 7);
+    params.getChangedParameters();
+
+    EXPECT_EQ(7, copy.get());
+}
+
+TEST_F(ParameterHandleTest, StringsAreReadWithoutCopying)
+{
+    ParameterHandle<std::string> text = params.getParameterHandle<std::string>("text");
+
+    const std::string& before = text.get();
+    EXPECT_EQ(&before, &text.get());
+
+    params.setParameter<std::string>("text", "bar");
+    params.getChangedParameters();
+
+    // the previous value outlives the update that replaced it
+    EXPECT_EQ("foo", before);
+    EXPECT_EQ("bar", text.get());
+}
+
+namespace
+{
+struct Pair
+{
+    int64_t a;
+    int64_t b;
+    int64_t c;
+};
+}  // namespace
+
+TEST_F(ParameterHandleTest, ConcurrentReadsAreNeverTorn)
+{
+    ParameterHandle<Pair> handle(Pair{ 0, 0, 0 });
+
+    std::atomic<bool> running(true);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i) {
+        readers.emplace_back([&]() {
+            while (running) {
+                Pair p = handle.get();
+                if (p.b != -p.a || p.c != 2 * p.a) {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    for (int64_t i = 1; i < 100000; ++i) {
+        handle.update(Pair{ i, -i, 2 * i });
+    }
+
+    running = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, torn);
+    EXPECT_EQ(99999, handle.get().a);
+}
+
+TEST_F(ParameterHandleTest, ReadingBenchmark)
+{
+    const int reads = 10000000;
+
+    ParameterHandle<int> number = params.getParameterHandle<int>("number");
+
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reads; ++i) {
+        sum += number.get();
+    }
+    auto handle_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(42l * reads, sum);
+
+    // the lookup is much slower, a tenth of the reads is enough for a comparison
+    const int lookups = reads / 10;
+    sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        sum += params.readParameter<int>("number");
+    }
+    auto lookup_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(42l * lookups, sum);
+
+    std::cout << "[ BENCHMARK ] " << reads << " handle reads: " << handle_duration.count() / 1000000 << "ms (" << handle_duration.count() / double(reads) << "ns per read), readParameter: "
+              << lookup_duration.count() / double(lookups) << "ns per read" << std::endl;
+}
+
+}  // namespace csapex
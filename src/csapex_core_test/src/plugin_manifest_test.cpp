@@ -0,0 +1,102 @@
+#include <csapex/plugin/plugin_manifest.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+namespace csapex
+{
+namespace bf = boost::filesystem;
+
+class PluginManifestTest : public CsApexTestCase
+{
+protected:
+    void SetUp() override
+    {
+        CsApexTestCase::SetUp();
+
+        dir = bf::temp_directory_path() / bf::unique_path("csapex_manifest_test_%%%%%%");
+        bf::create_directories(dir);
+
+        manifest_file = (dir / "plugins.xml").string();
+        cache_file = (dir / "cache.yaml").string();
+
+        std::ofstream manifest(manifest_file.c_str());
+        manifest << "<library path=\"libtest_plugins\">\n"
+                    "  <class type=\"test::Foo\" base_class_type=\"csapex::Node\">\n"
+                    "    <description>foo node</description>\n"
+                    "    <tags>Test</tags>\n"
+                    "  </class>\n"
+                    "  <class name=\"Bar\" type=\"test::BarImpl\" base_class_type=\"csapex::Node\"/>\n"
+                    "</library>\n";
+    }
+
+    void TearDown() override
+    {
+        bf::remove_all(dir);
+
+        CsApexTestCase::TearDown();
+    }
+
+    bf::path dir;
+    std::string manifest_file;
+    std::string cache_file;
+};
+
+TEST_F(PluginManifestTest, ManifestIsParsed)
+{
+    PluginManifest manifest = PluginManifest::parse(manifest_file);
+
+    ASSERT_TRUE(manifest.valid);
+    ASSERT_EQ(1, manifest.libraries.size());
+    EXPECT_EQ("libtest_plugins", manifest.libraries[0].path);
+
+    ASSERT_EQ(2, manifest.libraries[0].classes.size());
+    EXPECT_EQ("test::Foo", manifest.libraries[0].classes[0].lookup_name);
+    EXPECT_EQ("foo node", manifest.libraries[0].classes[0].description);
+    EXPECT_EQ("Test", manifest.libraries[0].classes[0].tags);
+    EXPECT_EQ("Bar", manifest.libraries[0].classes[1].lookup_name);
+    EXPECT_EQ("test::BarImpl", manifest.libraries[0].classes[1].type);
+}
+
+TEST_F(PluginManifestTest, UnchangedManifestsAreTakenFromTheCache)
+{
+    {
+        PluginManifestCache cache(cache_file);
+        PluginManifestCache::Statistics statistics;
+        std::vector<PluginManifest> manifests = cache.load({ manifest_file }, &statistics);
+        ASSERT_EQ(1, manifests.size());
+        EXPECT_TRUE(manifests[0].valid);
+        EXPECT_EQ(1, statistics.parsed);
+        EXPECT_EQ(0, statistics.cached);
+    }
+
+    // a new cache reads the index from disk
+    PluginManifestCache cache(cache_file);
+    PluginManifestCache::Statistics statistics;
+    std::vector<PluginManifest> manifests = cache.load({ manifest_file }, &statistics);
+    EXPECT_EQ(0, statistics.parsed);
+    EXPECT_EQ(1, statistics.cached);
+
+    ASSERT_EQ(1, manifests.size());
+    ASSERT_EQ(1, manifests[0].libraries.size());
+    ASSERT_EQ(2, manifests[0].libraries[0].classes.size());
+    EXPECT_EQ("Bar", manifests[0].libraries[0].classes[1].lookup_name);
+}
+
+TEST_F(PluginManifestTest, ModifiedManifestsAreParsedAgain)
+{
+    PluginManifestCache cache(cache_file);
+    cache.load({ manifest_file });
+
+    // the cache is keyed by the modification time
+    bf::last_write_time(manifest_file, bf::last_write_time(manifest_file) + 10);
+
+    PluginManifestCache::Statistics statistics;
+    cache.load({ manifest_file }, &statistics);
+    EXPECT_EQ(1, statistics.parsed);
+    EXPECT_EQ(0, statistics.cached);
+}
+
+}  // namespace csapex
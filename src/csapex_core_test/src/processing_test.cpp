@@ -19,6 +19,8 @@
 #include <csapex_testing/mockup_nodes.h>
 #include <csapex_testing/test_exception_handler.h>
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <condition_variable>
 
@@ -26,8 +28,221 @@
 
 namespace csapex
 {
+namespace
+{
+const int CHAIN_TOKENS = 20000;
+
+class ChainSource : public Node
+{
+public:
+    ChainSource() : next_(0)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    bool canProcess() const override
+    {
+        return next_ < CHAIN_TOKENS;
+    }
+
+    void process() override
+    {
+        msg::publish(out, next_++);
+    }
+
+private:
+    Output* out;
+    std::atomic<int> next_;
+};
+
+class ChainPassThrough : public Node
+{
+public:
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<int>("input");
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    void process() override
+    {
+        msg::publish(out, msg::getValue<int>(in));
+    }
+
+private:
+    Input* in;
+    Output* out;
+};
+
+class ChainSink : public Node
+{
+public:
+    ChainSink() : received_(0)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<int>("input");
+    }
+
+    void process() override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++received_;
+        changed_.notify_all();
+    }
+
+    bool waitFor(int count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::seconds(60), [this, count]() { return received_ >= count; });
+    }
+
+private:
+    Input* in;
+
+    int received_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+};
+
+const int FAN_OUT_TOKENS = 500;
+// roughly a 1080p RGB image
+const std::size_t FAN_OUT_PAYLOAD = 1920 * 1080 * 3;
+
+class FanOutSource : public Node
+{
+public:
+    FanOutSource() : next_(0)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        out = node_modifier.addOutput<std::string>("output");
+    }
+
+    bool canProcess() const override
+    {
+        return next_ < FAN_OUT_TOKENS;
+    }
+
+    void process() override
+    {
+        ++next_;
+        msg::publish(out, std::string(FAN_OUT_PAYLOAD, 'x'));
+    }
+
+private:
+    Output* out;
+    std::atomic<int> next_;
+};
+
+class FanOutSink : public Node
+{
+public:
+    FanOutSink(bool modify) : modify_(modify)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<std::string>("input");
+    }
+
+    void process() override
+    {
+        // addresses of freed messages can be reused, a weak pointer identifies the message by its control block instead
+        std::weak_ptr<const TokenData> payload;
+        if (modify_) {
+            auto msg = msg::getClonedMessage<connection_types::GenericValueMessage<std::string>>(in);
+            msg->value[0] = 'y';
+            payload = msg;
+        } else {
+            payload = msg::getMessage<connection_types::GenericValueMessage<std::string>>(in);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        payloads_.push_back(payload);
+        changed_.notify_all();
+    }
+
+    bool waitFor(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::seconds(60), [this, count]() { return payloads_.size() >= count; });
+    }
+
+    std::vector<std::weak_ptr<const TokenData>> getPayloads()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return payloads_;
+    }
+
+    Input* in;
+
+private:
+    bool modify_;
+
+    std::vector<std::weak_ptr<const TokenData>> payloads_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+};
+
+bool isSameMessage(const std::weak_ptr<const TokenData>& a, const std::weak_ptr<const TokenData>& b)
+{
+    return !a.owner_before(b) && !b.owner_before(a);
+}
+}  // namespace
+
 class ProcessingTest : public NodeConstructingTest
 {
+protected:
+    double measureChainThroughput(int queue_depth)
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("ChainSource", []() { return NodePtr(new ChainSource); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("ChainPassThrough", []() { return NodePtr(new ChainPassThrough); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("ChainSink", []() { return NodePtr(new ChainSink); }));
+
+        GraphFacadeImplementationPtr main_graph_facade = std::make_shared<GraphFacadeImplementation>(executor, graph, graph_node);
+        graph->setNodeFacade(main_graph_facade->getLocalNodeFacade().get());
+        executor.setSuppressExceptions(false);
+
+        NodeFacadeImplementationPtr previous = factory.makeNode("ChainSource", UUIDProvider::makeUUID_without_parent("src"), graph);
+        main_graph_facade->addNode(previous);
+
+        // 10 no-op nodes between the source and the sink
+        for (int i = 0; i < 10; ++i) {
+            NodeFacadeImplementationPtr node = factory.makeNode("ChainPassThrough", UUIDProvider::makeUUID_without_parent("pass_" + std::to_string(i)), graph);
+            main_graph_facade->addNode(node);
+            main_graph_facade->connect(previous, "output", node, "input")->setQueueDepth(queue_depth);
+            previous = node;
+        }
+
+        NodeFacadeImplementationPtr sink_p = factory.makeNode("ChainSink", UUIDProvider::makeUUID_without_parent("sink"), graph);
+        main_graph_facade->addNode(sink_p);
+        main_graph_facade->connect(previous, "output", sink_p, "input")->setQueueDepth(queue_depth);
+
+        std::shared_ptr<ChainSink> sink = std::dynamic_pointer_cast<ChainSink>(sink_p->getNode());
+        EXPECT_NE(nullptr, sink);
+        if (!sink) {
+            return 0.0;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        executor.start();
+        EXPECT_TRUE(sink->waitFor(CHAIN_TOKENS));
+        auto end = std::chrono::high_resolution_clock::now();
+        executor.stop();
+
+        double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+        return CHAIN_TOKENS / seconds;
+    }
 };
 
 TEST_F(ProcessingTest, DirectCallToProcess)
@@ -110,4 +325,72 @@ TEST_F(ProcessingTest, CallToProcessViaNodeWorker)
 
     ASSERT_EQ(23 * 4, msg_out->value);
 }
+
+// the two chains only differ in their connections, compare them to see what the connection queue costs
+TEST_F(ProcessingTest, LinearChainThroughputBenchmark)
+{
+    std::cout << "[ BENCHMARK ] 10 node chain, single slot connections: " << static_cast<long>(measureChainThroughput(1)) << " tokens/s" << std::endl;
+}
+
+TEST_F(ProcessingTest, BufferedLinearChainThroughputBenchmark)
+{
+    std::cout << "[ BENCHMARK ] 10 node chain, queue depth 4: " << static_cast<long>(measureChainThroughput(4)) << " tokens/s" << std::endl;
+}
+
+TEST_F(ProcessingTest, FanOutSharesMessagesBenchmark)
+{
+    factory.registerNodeType(std::make_shared<NodeConstructor>("FanOutSource", []() { return NodePtr(new FanOutSource); }));
+    factory.registerNodeType(std::make_shared<NodeConstructor>("FanOutSink", []() { return NodePtr(new FanOutSink(false)); }));
+    factory.registerNodeType(std::make_shared<NodeConstructor>("FanOutModifyingSink", []() { return NodePtr(new FanOutSink(true)); }));
+
+    GraphFacadeImplementationPtr main_graph_facade = std::make_shared<GraphFacadeImplementation>(executor, graph, graph_node);
+    graph->setNodeFacade(main_graph_facade->getLocalNodeFacade().get());
+    executor.setSuppressExceptions(false);
+
+    NodeFacadeImplementationPtr source = factory.makeNode("FanOutSource", UUIDProvider::makeUUID_without_parent("src"), graph);
+    main_graph_facade->addNode(source);
+
+    // four consumers read the message, one of them needs a mutable copy
+    std::vector<std::shared_ptr<FanOutSink>> sinks;
+    for (int i = 0; i < 4; ++i) {
+        std::string type = i == 3 ? "FanOutModifyingSink" : "FanOutSink";
+        NodeFacadeImplementationPtr sink_p = factory.makeNode(type, UUIDProvider::makeUUID_without_parent("sink_" + std::to_string(i)), graph);
+        main_graph_facade->addNode(sink_p);
+        main_graph_facade->connect(source, "output", sink_p, "input");
+
+        std::shared_ptr<FanOutSink> sink = std::dynamic_pointer_cast<FanOutSink>(sink_p->getNode());
+        ASSERT_NE(nullptr, sink);
+        sinks.push_back(sink);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    executor.start();
+    for (const std::shared_ptr<FanOutSink>& sink : sinks) {
+        ASSERT_TRUE(sink->waitFor(FAN_OUT_TOKENS));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    executor.stop();
+
+    // the read-only consumers all see the same message
+    std::vector<std::weak_ptr<const TokenData>> shared = sinks[0]->getPayloads();
+    for (int sink = 1; sink < 3; ++sink) {
+        std::vector<std::weak_ptr<const TokenData>> payloads = sinks[sink]->getPayloads();
+        ASSERT_EQ(shared.size(), payloads.size());
+        for (std::size_t i = 0; i < shared.size(); ++i) {
+            EXPECT_TRUE(isSameMessage(shared[i], payloads[i]));
+        }
+    }
+
+    // only the explicit request for a mutable message copies
+    EXPECT_EQ(0, sinks[0]->in->getCopyCounter()->get());
+    EXPECT_EQ(FAN_OUT_TOKENS, sinks[3]->in->getCopyCounter()->get());
+    std::vector<std::weak_ptr<const TokenData>> copied = sinks[3]->getPayloads();
+    ASSERT_EQ(shared.size(), copied.size());
+    for (std::size_t i = 0; i < shared.size(); ++i) {
+        EXPECT_FALSE(isSameMessage(shared[i], copied[i]));
+    }
+
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+    std::cout << "[ BENCHMARK ] 1 to 4 fan-out of " << FAN_OUT_PAYLOAD / 1024 << " KiB messages: " << static_cast<long>(FAN_OUT_TOKENS / seconds) << " messages/s" << std::endl;
+}
 }  // namespace csapex
@@ -0,0 +1,185 @@
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node.h>
+#include <csapex/model/node_modifier.h>
+#include <csapex/model/subgraph_node.h>
+#include <csapex/msg/generic_value_message.hpp>
+#include <csapex/msg/io.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/node_constructing_test.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace csapex
+{
+namespace
+{
+const int TOKEN_COUNT = 32;
+const int REPLICAS = 4;
+}  // namespace
+
+class CountingSource : public Node
+{
+public:
+    CountingSource() : next_(0)
+    {
+    }
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    bool canProcess() const override
+    {
+        return next_ < TOKEN_COUNT;
+    }
+
+    void process() override
+    {
+        msg::publish(out, next_++);
+    }
+
+private:
+    Output* out;
+    std::atomic<int> next_;
+};
+
+class ShuffledReplicaNode : public Node
+{
+public:
+    static std::atomic<int> running;
+    static std::atomic<int> max_running;
+
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<int>("input");
+        out = node_modifier.addOutput<int>("output");
+    }
+
+    int getReplicaCount() const override
+    {
+        return REPLICAS;
+    }
+
+    void process() override
+    {
+        int current = ++running;
+        int max = max_running;
+        while (current > max && !max_running.compare_exchange_weak(max, current)) {
+        }
+
+        int value = msg::getValue<int>(in);
+
+        // later tokens finish first, so the results arrive out of order
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * (REPLICAS - value % REPLICAS)));
+
+        --running;
+
+        msg::publish(out, value);
+    }
+
+private:
+    Input* in;
+    Output* out;
+};
+
+std::atomic<int> ShuffledReplicaNode::running(0);
+std::atomic<int> ShuffledReplicaNode::max_running(0);
+
+class CollectingSink : public Node
+{
+public:
+    void setup(NodeModifier& node_modifier) override
+    {
+        in = node_modifier.addInput<int>("input");
+    }
+
+    void process() override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        values_.push_back(msg::getValue<int>(in));
+        changed_.notify_all();
+    }
+
+    std::vector<int> waitForValues(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait_for(lock, std::chrono::seconds(10), [this, count]() { return values_.size() >= count; });
+        return values_;
+    }
+
+private:
+    Input* in;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<int> values_;
+};
+
+class ReplicaTest : public NodeConstructingTest
+{
+protected:
+    ReplicaTest()
+    {
+        factory.registerNodeType(std::make_shared<NodeConstructor>("CountingSource", []() { return NodePtr(new CountingSource); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("ShuffledReplicaNode", []() { return NodePtr(new ShuffledReplicaNode); }));
+        factory.registerNodeType(std::make_shared<NodeConstructor>("CollectingSink", []() { return NodePtr(new CollectingSink); }));
+    }
+
+    void SetUp() override
+    {
+        NodeConstructingTest::SetUp();
+
+        main_graph_facade = std::make_shared<GraphFacadeImplementation>(executor, graph, graph_node);
+        graph->setNodeFacade(main_graph_facade->getLocalNodeFacade().get());
+
+        executor.setSuppressExceptions(false);
+
+        ShuffledReplicaNode::running = 0;
+        ShuffledReplicaNode::max_running = 0;
+    }
+
+    void TearDown() override
+    {
+        executor.stop();
+        NodeConstructingTest::TearDown();
+    }
+
+    GraphFacadeImplementationPtr main_graph_facade;
+};
+
+TEST_F(ReplicaTest, ReplicatedNodeKeepsTheTokenOrder)
+{
+    NodeFacadeImplementationPtr src = factory.makeNode("CountingSource", UUIDProvider::makeUUID_without_parent("src"), graph);
+    main_graph_facade->addNode(src);
+    NodeFacadeImplementationPtr replicated = factory.makeNode("ShuffledReplicaNode", UUIDProvider::makeUUID_without_parent("replicated"), graph);
+    main_graph_facade->addNode(replicated);
+    NodeFacadeImplementationPtr sink_p = factory.makeNode("CollectingSink", UUIDProvider::makeUUID_without_parent("sink"), graph);
+    main_graph_facade->addNode(sink_p);
+
+    std::shared_ptr<CollectingSink> sink = std::dynamic_pointer_cast<CollectingSink>(sink_p->getNode());
+    ASSERT_NE(nullptr, sink);
+
+    main_graph_facade->connect(src, "output", replicated, "input");
+    main_graph_facade->connect(replicated, "output", sink_p, "input");
+
+    executor.start();
+
+    std::vector<int> values = sink->waitForValues(TOKEN_COUNT);
+    ASSERT_EQ(TOKEN_COUNT, (int)values.size());
+    for (int i = 0; i < TOKEN_COUNT; ++i) {
+        EXPECT_EQ(i, values[i]);
+    }
+
+    EXPECT_GT(ShuffledReplicaNode::max_running, 1);
+    EXPECT_LE(ShuffledReplicaNode::max_running, REPLICAS);
+}
+
+}  // namespace csapex
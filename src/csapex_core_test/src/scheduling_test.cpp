@@ -3,11 +3,21 @@
 #include <csapex/model/graph/graph_impl.h>
 #include <csapex/model/execution_type.h>
 #include <csapex/model/node_state.h>
+#include <csapex/scheduling/thread_group.h>
+#include <csapex/scheduling/task_queue.h>
+#include <csapex/scheduling/timed_queue.h>
+#include <csapex/profiling/profiler.h>
 
 #include <csapex_testing/test_exception_handler.h>
 #include <csapex_testing/mockup_nodes.h>
 #include <csapex_testing/stepping_test.h>
 
+/// SYSTEM
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
 namespace csapex
 {
 class SchedulingTest : public SteppingTest
@@ -101,6 +111,55 @@ TEST_F(SchedulingTest, SteppingWorksForProcessingGraphsInSubprocess)
     testStepping(ExecutionType::SUBPROCESS);
 }
 
+TEST_F(SchedulingTest, SteppingWorksWithMultipleWorkers)
+{
+    executor.getDefaultGroup()->setWorkerCount(4);
+    ASSERT_EQ(4u, executor.getDefaultGroup()->getWorkerCount());
+
+    testStepping(ExecutionType::DIRECT);
+}
+
+TEST_F(SchedulingTest, WorkerCountIsSavedAndLoaded)
+{
+    executor.getDefaultGroup()->setWorkerCount(3);
+
+    YAML::Node settings;
+    executor.getDefaultGroup()->saveSettings(settings);
+
+    executor.getDefaultGroup()->setWorkerCount(1);
+    ASSERT_EQ(1u, executor.getDefaultGroup()->getWorkerCount());
+
+    executor.getDefaultGroup()->loadSettings(settings);
+    ASSERT_EQ(3u, executor.getDefaultGroup()->getWorkerCount());
+}
+
+TEST_F(SchedulingTest, WorkerCountCanChangeWhileTasksAreScheduled)
+{
+    TimedQueuePtr timed_queue = std::make_shared<TimedQueue>();
+    ThreadGroupPtr group = std::make_shared<ThreadGroup>(timed_queue, eh, "resized");
+    group->start();
+
+    const int count = 2000;
+    std::atomic<int> executed(0);
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            group->schedule(std::make_shared<Task>(std::to_string(i), [&executed]() { ++executed; }));
+        }
+    });
+
+    for (std::size_t workers : { 4, 1, 3, 2, 1 }) {
+        group->setWorkerCount(workers);
+    }
+    producer.join();
+
+    for (int i = 0; i < 1000 && executed < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(count, executed);
+
+    group->stop();
+}
+
 TEST_F(SchedulingTest, SteppingWorksForSourceGraphs)
 {
     // NESTED GRAPH
@@ -192,4 +251,210 @@ TEST_F(SchedulingTest, SteppingWorksForOutputToSlot)
 TEST_F(SchedulingTest, SteppingWorksForEventToInput)
 {
 }
+TEST_F(SchedulingTest, TaskQueueRejectsDuplicatesAndKeepsOrder)
+{
+    TaskQueue queue;
+
+    std::vector<TaskPtr> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back(std::make_shared<Task>(std::to_string(i), []() {}));
+    }
+    TaskPtr urgent = std::make_shared<Task>("urgent", []() {}, 10);
+
+    for (const TaskPtr& t : tasks) {
+        ASSERT_TRUE(queue.push(t));
+    }
+    ASSERT_FALSE(queue.push(tasks[2]));
+    ASSERT_TRUE(queue.push(urgent));
+    ASSERT_EQ(6u, queue.size());
+
+    ASSERT_TRUE(queue.remove(tasks[3]));
+    ASSERT_FALSE(tasks[3]->isQueued());
+
+    ASSERT_EQ(urgent, queue.pop());
+    ASSERT_EQ(tasks[0], queue.pop());
+    ASSERT_EQ(tasks[1], queue.pop());
+    ASSERT_EQ(tasks[2], queue.pop());
+    ASSERT_EQ(tasks[4], queue.pop());
+    ASSERT_TRUE(queue.empty());
+
+    ASSERT_TRUE(queue.push(tasks[2]));
+}
+
+TEST_F(SchedulingTest, ScheduleAndExecuteBenchmark)
+{
+    TimedQueuePtr timed_queue = std::make_shared<TimedQueue>();
+
+    for (std::size_t count : { 10, 100, 1000 }) {
+        ThreadGroupPtr group = std::make_shared<ThreadGroup>(timed_queue, eh, "benchmark");
+
+        std::mutex done_mutex;
+        std::condition_variable done;
+        std::size_t executed = 0;
+
+        std::vector<TaskPtr> tasks;
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.push_back(std::make_shared<Task>("task", [&]() {
+                std::unique_lock<std::mutex> lock(done_mutex);
+                if (++executed == count) {
+                    done.notify_all();
+                }
+            }));
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const TaskPtr& task : tasks) {
+            group->schedule(task);
+        }
+        // rescheduling queued tasks must be rejected cheaply
+        for (const TaskPtr& task : tasks) {
+            group->schedule(task);
+        }
+        auto scheduled = std::chrono::high_resolution_clock::now();
+
+        group->start();
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            ASSERT_TRUE(done.wait_for(lock, std::chrono::seconds(10), [&]() { return executed == count; }));
+        }
+        auto finished = std::chrono::high_resolution_clock::now();
+        group->stop();
+
+        ASSERT_EQ(count, executed);
+
+        auto schedule_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(scheduled - start).count();
+        auto execute_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(finished - scheduled).count();
+        std::cout << "[ BENCHMARK ] " << count << " queued tasks: schedule " << (schedule_ns / (2 * count)) << " ns/task, execute " << (execute_ns / count) << " ns/task" << std::endl;
+    }
+}
+class TimedQueueTest : public SchedulingTest
+{
+protected:
+    void SetUp() override
+    {
+        SchedulingTest::SetUp();
+
+        timed_queue = std::make_shared<TimedQueue>();
+        group = std::make_shared<ThreadGroup>(timed_queue, eh, "timed");
+        group->start();
+        timed_queue->start();
+    }
+
+    void TearDown() override
+    {
+        timed_queue->stop();
+        group->stop();
+
+        SchedulingTest::TearDown();
+    }
+
+    TaskPtr makeTask(int id)
+    {
+        return std::make_shared<Task>(std::to_string(id), [this, id]() {
+            std::unique_lock<std::mutex> lock(executed_mutex);
+            executed.push_back(id);
+            executed_changed.notify_all();
+        });
+    }
+
+    bool waitForExecutions(std::size_t count, std::chrono::milliseconds timeout = std::chrono::milliseconds(1000))
+    {
+        std::unique_lock<std::mutex> lock(executed_mutex);
+        return executed_changed.wait_for(lock, timeout, [&]() { return executed.size() >= count; });
+    }
+
+protected:
+    TimedQueuePtr timed_queue;
+    ThreadGroupPtr group;
+
+    std::mutex executed_mutex;
+    std::condition_variable executed_changed;
+    std::vector<int> executed;
+};
+
+TEST_F(TimedQueueTest, TasksWithEqualDeadlinesAreAllDispatched)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+    timed_queue->schedule(group, makeTask(0), deadline);
+    timed_queue->schedule(group, makeTask(1), deadline);
+    timed_queue->schedule(group, makeTask(2), deadline);
+
+    ASSERT_TRUE(waitForExecutions(3));
+    ASSERT_EQ((std::vector<int>{ 0, 1, 2 }), executed);
+}
+
+TEST_F(TimedQueueTest, TasksAreDispatchedInDeadlineOrder)
+{
+    auto now = std::chrono::steady_clock::now();
+    timed_queue->schedule(group, makeTask(3), now + std::chrono::microseconds(3500));
+    timed_queue->schedule(group, makeTask(1), now + std::chrono::microseconds(1500));
+    timed_queue->schedule(group, makeTask(4), now + std::chrono::milliseconds(40));
+    timed_queue->schedule(group, makeTask(2), now + std::chrono::microseconds(2500));
+    timed_queue->schedule(group, makeTask(0), now - std::chrono::milliseconds(1));
+
+    ASSERT_TRUE(waitForExecutions(5));
+    ASSERT_EQ((std::vector<int>{ 0, 1, 2, 3, 4 }), executed);
+    ASSERT_EQ(0u, timed_queue->size());
+
+    Histogram::Ptr jitter = timed_queue->getProfiler()->getHistogram("timed queue");
+    ASSERT_EQ(5u, jitter->count());
+}
+
+TEST_F(TimedQueueTest, CancelledTasksAreNotDispatched)
+{
+    auto now = std::chrono::steady_clock::now();
+    TimedQueue::Handle cancelled = timed_queue->schedule(group, makeTask(0), now + std::chrono::milliseconds(5));
+    timed_queue->schedule(group, makeTask(1), now + std::chrono::milliseconds(10));
+
+    ASSERT_TRUE(timed_queue->cancel(cancelled));
+    ASSERT_FALSE(timed_queue->cancel(cancelled));
+
+    ASSERT_TRUE(waitForExecutions(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ((std::vector<int>{ 1 }), executed);
+}
+
+TEST_F(TimedQueueTest, DeadlinesOnHigherLevelsAreCascaded)
+{
+    auto now = std::chrono::steady_clock::now();
+    // one slot of the lowest level is 100us, so both deadlines are on the second level and need one cascade
+    timed_queue->schedule(group, makeTask(1), now + std::chrono::milliseconds(60));
+    timed_queue->schedule(group, makeTask(0), now + std::chrono::milliseconds(30));
+    TimedQueue::Handle far = timed_queue->schedule(group, makeTask(2), now + std::chrono::hours(24 * 30));
+
+    ASSERT_TRUE(waitForExecutions(2));
+    ASSERT_EQ((std::vector<int>{ 0, 1 }), executed);
+    ASSERT_EQ(1u, timed_queue->size());
+    ASSERT_TRUE(timed_queue->cancel(far));
+}
+
+TEST_F(TimedQueueTest, DeadlinesOneRotationAheadAreDispatched)
+{
+    // a deadline one rotation of the second level ahead is stored in the slot that is currently active
+    auto delay = std::chrono::microseconds(TimedQueue::TICK_US * ((1 << 16) - 1));
+    timed_queue->schedule(group, makeTask(0), std::chrono::steady_clock::now() + delay);
+
+    ASSERT_TRUE(waitForExecutions(1, std::chrono::duration_cast<std::chrono::milliseconds>(delay) + std::chrono::milliseconds(1000)));
+    ASSERT_EQ((std::vector<int>{ 0 }), executed);
+}
+
+TEST_F(TimedQueueTest, IdleSchedulersDoNotWakeUp)
+{
+    timed_queue->schedule(group, makeTask(0), std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+    ASSERT_TRUE(waitForExecutions(1));
+
+    // the last deadline is cancelled, so nothing is pending afterwards
+    TimedQueue::Handle cancelled = timed_queue->schedule(group, makeTask(1), std::chrono::steady_clock::now() + std::chrono::milliseconds(20));
+    ASSERT_TRUE(timed_queue->cancel(cancelled));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    std::size_t queue_wake_ups = timed_queue->getWakeUps();
+    std::size_t group_wake_ups = group->getWakeUps();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    ASSERT_EQ(queue_wake_ups, timed_queue->getWakeUps());
+    ASSERT_EQ(group_wake_ups, group->getWakeUps());
+    ASSERT_EQ((std::vector<int>{ 0 }), executed);
+}
 }  // namespace csapex
@@ -0,0 +1,160 @@
+#include <csapex/io/session.h>
+#include <csapex/io/protcol/connector_notes.h>
+#include <csapex/io/raw_data_stream.h>
+#include <csapex/io/raw_message.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade_impl.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/serialization/serialization_buffer.h>
+#include <csapex/utility/uuid_provider.h>
+
+#include <csapex_testing/node_constructing_test.h>
+
+#include <boost/asio.hpp>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace csapex
+{
+class SessionTest : public NodeConstructingTest
+{
+protected:
+    void SetUp() override
+    {
+        NodeConstructingTest::SetUp();
+
+        using boost::asio::ip::tcp;
+
+        tcp::acceptor acceptor(io_service, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+        client_socket.reset(new tcp::socket(io_service));
+        client_socket->connect(acceptor.local_endpoint());
+        tcp::socket server_socket(io_service);
+        acceptor.accept(server_socket);
+
+        session = std::make_shared<Session>(std::move(server_socket), "session test");
+        session->start();
+
+        work.reset(new boost::asio::io_service::work(io_service));
+        io_thread = std::thread([this]() { io_service.run(); });
+    }
+
+    void TearDown() override
+    {
+        session->stop();
+        session.reset();
+
+        work.reset();
+        io_service.stop();
+        io_thread.join();
+        client_socket.reset();
+
+        NodeConstructingTest::TearDown();
+    }
+
+    std::shared_ptr<const SerializationBuffer> makeFrame(std::size_t bytes)
+    {
+        std::shared_ptr<SerializationBuffer> frame = std::make_shared<SerializationBuffer>(std::vector<uint8_t>(bytes), true);
+        frame->finalize();
+        return frame;
+    }
+
+    bool waitForQueueDepth(std::size_t depth)
+    {
+        for (int i = 0; i < 100; ++i) {
+            if (session->getWriteStatistics().queue_depth == depth) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    void occupyConnection()
+    {
+        // the client never reads, so this frame does not fit into the socket buffers and stays in flight
+        session->writeFrame("occupied", makeFrame(64 << 20));
+        ASSERT_TRUE(waitForQueueDepth(0));
+    }
+
+protected:
+    boost::asio::io_service io_service;
+    std::unique_ptr<boost::asio::io_service::work> work;
+    std::thread io_thread;
+
+    std::unique_ptr<boost::asio::ip::tcp::socket> client_socket;
+    SessionPtr session;
+};
+
+TEST_F(SessionTest, FramesOfASlowClientAreReplacedOrDropped)
+{
+    session->setMaxQueuedPackets(4);
+    occupyConnection();
+
+    std::shared_ptr<const SerializationBuffer> frame = makeFrame(1024);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        session->writeFrame("stream", frame);
+    }
+    for (int i = 0; i < 10; ++i) {
+        session->writeFrame("stream " + std::to_string(i), frame);
+    }
+    // responses are never dropped, even if the queue is full
+    session->write("feedback");
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    Session::WriteStatistics statistics = session->getWriteStatistics();
+    EXPECT_EQ(99u, statistics.packets_superseded);
+    EXPECT_EQ(7u, statistics.packets_dropped);
+    EXPECT_EQ(5u, statistics.queue_depth);
+
+    // writers are never delayed by a full queue
+    EXPECT_LT(duration, std::chrono::milliseconds(500));
+}
+
+TEST_F(SessionTest, StateNotesReplaceTheirQueuedPredecessor)
+{
+    session->setMaxQueuedPackets(1);
+    occupyConnection();
+
+    AUUID a(UUIDProvider::makeUUID_without_parent("a"));
+    AUUID b(UUIDProvider::makeUUID_without_parent("b"));
+    for (int i = 0; i < 10; ++i) {
+        session->write(std::make_shared<ConnectorNote>(ConnectorNoteType::isEnabledChanged, a, i % 2 == 0));
+        session->write(std::make_shared<ConnectorNote>(ConnectorNoteType::isEnabledChanged, b, i % 2 == 0));
+    }
+
+    // every state is queued once, even beyond the limit, because only the latest value is kept
+    Session::WriteStatistics statistics = session->getWriteStatistics();
+    EXPECT_EQ(2u, statistics.queue_depth);
+    EXPECT_EQ(18u, statistics.packets_superseded);
+    EXPECT_EQ(0u, statistics.packets_dropped);
+}
+
+TEST_F(SessionTest, RawDataOfASlowClientOnlyKeepsTheLatestFrame)
+{
+    NodeFacadeImplementationPtr node = factory.makeNode("MockupSource", UUIDProvider::makeUUID_without_parent("raw"), graph);
+    NodeHandlePtr nh = node->getNodeHandle();
+
+    occupyConnection();
+    RawDataStream::addClient(nh, session, RawDataStream::ClientOptions());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        nh->raw_data_connection(std::make_shared<RawMessage>(std::vector<uint8_t>(1024), nh->getAUUID()));
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    Session::WriteStatistics statistics = session->getWriteStatistics();
+    EXPECT_EQ(1u, statistics.queue_depth);
+    EXPECT_EQ(99u, statistics.packets_superseded);
+
+    // the node is never delayed by a slow client
+    EXPECT_LT(duration, std::chrono::milliseconds(500));
+
+    RawDataStream::removeClient(nh, session.get());
+}
+
+}  // namespace csapex
@@ -0,0 +1,212 @@
+#include <csapex/profiling/chrome_trace_writer.h>
+#include <csapex/profiling/trace_buffer.h>
+#include <csapex/profiling/trace_collector.h>
+
+#include <csapex_testing/csapex_test_case.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace csapex
+{
+class TraceBufferTest : public CsApexTestCase
+{
+};
+
+TEST_F(TraceBufferTest, NamesAreInternedOnce)
+{
+    uint32_t a = TraceBuffer::intern("TraceBufferTest a");
+    uint32_t b = TraceBuffer::intern("TraceBufferTest b");
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, TraceBuffer::intern("TraceBufferTest a"));
+    EXPECT_EQ("TraceBufferTest b", TraceBuffer::getName(b));
+}
+
+TEST_F(TraceBufferTest, RecordedSpansAreAggregated)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest aggregated");
+
+    TraceBuffer::record(name, 100, 110);
+    TraceBuffer::record(name, 200, 220);
+    TraceBuffer::record(name, 300, 330);
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest aggregated");
+    EXPECT_EQ(3u, stats.count);
+    EXPECT_EQ(10, stats.min.count());
+    EXPECT_EQ(30, stats.max.count());
+    EXPECT_EQ(60, stats.total.count());
+    EXPECT_EQ(20, stats.mean().count());
+}
+
+TEST_F(TraceBufferTest, ScopesRecordTheirLifetime)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest scope");
+    {
+        TraceScope scope(name);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest scope");
+    ASSERT_EQ(1u, stats.count);
+    EXPECT_GE(stats.total, std::chrono::milliseconds(2));
+}
+
+TEST_F(TraceBufferTest, ThreadsRecordIntoSeparateBuffers)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest threads");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([name]() {
+            for (int i = 0; i < 1000; ++i) {
+                TraceBuffer::record(name, i, i + 1);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest threads");
+    EXPECT_EQ(4000u, stats.count);
+}
+
+TEST_F(TraceBufferTest, OverwrittenRecordsAreCounted)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest overwritten");
+
+    std::size_t lost_before = TraceCollector::instance().getLostRecordCount();
+
+    std::thread writer([name]() {
+        for (std::size_t i = 0; i < TraceBuffer::CAPACITY + 100; ++i) {
+            TraceBuffer::record(name, i, i + 1);
+        }
+    });
+    writer.join();
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest overwritten");
+    EXPECT_LE(stats.count, static_cast<std::size_t>(TraceBuffer::CAPACITY));
+    EXPECT_GE(stats.count, static_cast<std::size_t>(TraceBuffer::CAPACITY) - 1);
+    EXPECT_GE(TraceCollector::instance().getLostRecordCount() - lost_before, 100u);
+}
+
+TEST_F(TraceBufferTest, BuffersOfFinishedThreadsAreReleased)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest finished");
+
+    TraceCollector::instance().collect();
+    std::size_t buffers_before = TraceBuffer::countBuffers();
+
+    // a drained buffer is released as soon as its thread finishes
+    std::thread drained([name]() {
+        TraceBuffer::record(name, 0, 1);
+        TraceCollector::instance().collect();
+    });
+    drained.join();
+    EXPECT_EQ(buffers_before, TraceBuffer::countBuffers());
+
+    // an unread buffer is released once it has been read
+    std::thread unread([name]() { TraceBuffer::record(name, 0, 1); });
+    unread.join();
+    EXPECT_EQ(buffers_before + 1, TraceBuffer::countBuffers());
+
+    TraceCollector::instance().collect();
+    EXPECT_EQ(buffers_before, TraceBuffer::countBuffers());
+}
+
+TEST_F(TraceBufferTest, UnreadBuffersAreBoundedWithoutCollection)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest uncollected");
+
+    TraceCollector::instance().collect();
+    std::size_t buffers_before = TraceBuffer::countBuffers();
+    std::size_t lost_before = TraceCollector::instance().getLostRecordCount();
+
+    for (std::size_t i = 0; i < TraceBuffer::MAX_RETIRED_BUFFERS + 10; ++i) {
+        std::thread writer([name]() { TraceBuffer::record(name, 0, 1); });
+        writer.join();
+    }
+    EXPECT_EQ(buffers_before + TraceBuffer::MAX_RETIRED_BUFFERS, TraceBuffer::countBuffers());
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest uncollected");
+    EXPECT_EQ(static_cast<std::size_t>(TraceBuffer::MAX_RETIRED_BUFFERS), stats.count);
+    EXPECT_EQ(10u, TraceCollector::instance().getLostRecordCount() - lost_before);
+    EXPECT_EQ(buffers_before, TraceBuffer::countBuffers());
+}
+
+TEST_F(TraceBufferTest, OnlySpansAndWaitsAreAggregated)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest typed");
+
+    TraceBuffer::record(TraceType::SPAN, name, 100, 110, 0);
+    TraceBuffer::record(TraceType::WAIT, name, 200, 220, 1);
+    TraceBuffer::record(TraceType::FLOW_BEGIN, name, 300, 300, 2);
+    TraceBuffer::record(TraceType::FLOW_END, name, 400, 400, 2);
+
+    TraceStatistics stats = TraceCollector::instance().getStatistics("TraceBufferTest typed");
+    EXPECT_EQ(2u, stats.count);
+    EXPECT_EQ(30, stats.total.count());
+}
+
+TEST_F(TraceBufferTest, ChromeTraceContainsAllRecordTypes)
+{
+    boost::filesystem::path file = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("csapex_trace_%%%%-%%%%.json");
+
+    {
+        ChromeTraceWriter writer(file.string());
+        ASSERT_TRUE(writer.isOpen());
+
+        uint32_t name = TraceBuffer::intern("TraceBufferTest \"chrome\"");
+        TraceBuffer::record(TraceType::SPAN, name, 1000, 3500, 0);
+        TraceBuffer::record(TraceType::WAIT, name, 1000, 2000, 7);
+        TraceBuffer::record(TraceType::FLOW_BEGIN, name, 1500, 1500, 42);
+
+        std::thread consumer([name]() { TraceBuffer::record(TraceType::FLOW_END, name, 4000, 4000, 42); });
+        consumer.join();
+    }
+
+    std::ifstream in(file.string());
+    std::stringstream content;
+    content << in.rdbuf();
+    boost::filesystem::remove(file);
+
+    std::string json = content.str();
+    ASSERT_FALSE(json.empty());
+    EXPECT_EQ('[', json.front());
+    EXPECT_EQ("]\n", json.substr(json.size() - 2));
+
+    EXPECT_NE(std::string::npos, json.find(R"("name":"TraceBufferTest \"chrome\"")"));
+    EXPECT_NE(std::string::npos, json.find(R"("ph":"X","pid":1)"));
+    EXPECT_NE(std::string::npos, json.find(R"("ts":1.000,"dur":2.500})"));
+    EXPECT_NE(std::string::npos, json.find(R"("ph":"b")"));
+    EXPECT_NE(std::string::npos, json.find(R"("ph":"e")"));
+    EXPECT_NE(std::string::npos, json.find(R"("ph":"s")"));
+    EXPECT_NE(std::string::npos, json.find(R"("id":"42","bp":"e"})"));
+    EXPECT_NE(std::string::npos, json.find(R"("ph":"M")"));
+}
+
+TEST_F(TraceBufferTest, RecordingBenchmark)
+{
+    uint32_t name = TraceBuffer::intern("TraceBufferTest benchmark");
+
+    const int events = 1000000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; ++i) {
+        TraceScope scope(name);
+    }
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    double ns_per_event = std::chrono::duration<double, std::nano>(duration).count() / events;
+    std::cout << "[ BENCHMARK ] trace scope: " << ns_per_event << " ns per recorded span" << std::endl;
+
+    TraceCollector::instance().collect();
+}
+
+}  // namespace csapex
@@ -90,10 +90,11 @@ protected:
         ASSERT_EQ(value_message->value, expected);
     }
 
-    void sendMessage(Output& o, int i)
+    void sendMessage(Output& o, int i, Message::Stamp stamp = 0)
     {
         GenericValueMessage<int>::Ptr msg(new GenericValueMessage<int>);
         msg->value = i;
+        msg->stamp_micro_seconds = stamp;
         o.addMessage(std::make_shared<Token>(msg));
     }
 };
@@ -408,3 +409,218 @@ TEST_F(TransitionTest, TestBundledAndDirectConnectionsCanBeMixed)
         ASSERT_RECEIVED(*i2, iter);
     }
 }
+
+TEST_F(TransitionTest, BufferedConnectionLetsProducerRunAhead)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueDepth(3);
+
+    // the producer can run ahead until the connection holds three tokens
+    for (int value = 0; value < 3; ++value) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, value);
+        ot.sendMessages(false);
+    }
+    ASSERT_FALSE(ot.canStartSendingMessages());
+    ASSERT_EQ(2u, c->countQueuedTokens());
+
+    // the consumer sees the tokens in order, each one makes room for the producer
+    for (int value = 0; value < 3; ++value) {
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+        ASSERT_RECEIVED(*i1, value);
+
+        it.notifyMessageRead();
+        it.notifyMessageProcessed();
+
+        ASSERT_TRUE(ot.canStartSendingMessages());
+    }
+
+    ASSERT_FALSE(it.isEnabled());
+    ASSERT_EQ(0u, c->countQueuedTokens());
+    ASSERT_EQ(0u, c->countDroppedTokens());
+}
+
+TEST_F(TransitionTest, DropOldestKeepsTheNewestTokens)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueDepth(2);
+    c->setBufferPolicy(BufferPolicy::DROP_OLDEST);
+
+    // a dropping connection never blocks the producer
+    for (int value = 0; value < 5; ++value) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, value);
+        ot.sendMessages(false);
+    }
+    ASSERT_EQ(1u, c->countQueuedTokens());
+    ASSERT_EQ(3u, c->countDroppedTokens());
+
+    // the consumer never started on the head, so it was dropped as well
+    std::vector<int> expected{ 3, 4 };
+    for (int value : expected) {
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+        ASSERT_RECEIVED(*i1, value);
+
+        it.notifyMessageRead();
+        it.notifyMessageProcessed();
+    }
+    ASSERT_FALSE(it.isEnabled());
+}
+
+TEST_F(TransitionTest, DropNewestKeepsTheOldestTokens)
+{
+    OutputTransition ot;
+    ot.addOutput(o1);
+
+    InputTransition it;
+    it.addInput(i1);
+
+    ConnectionPtr c = DirectConnection::connect(o1, i1);
+    c->setQueueDepth(2);
+    c->setBufferPolicy(BufferPolicy::DROP_NEWEST);
+
+    for (int value = 0; value < 5; ++value) {
+        ASSERT_TRUE(ot.canStartSendingMessages());
+        sendMessage(*o1, value);
+        ot.sendMessages(false);
+    }
+    ASSERT_EQ(1u, c->countQueuedTokens());
+    ASSERT_EQ(3u, c->countDroppedTokens());
+
+    std::vector<int> expected{ 0, 1 };
+    for (int value : expected) {
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+        ASSERT_RECEIVED(*i1, value);
+
+        it.notifyMessageRead();
+        it.notifyMessageProcessed();
+    }
+    ASSERT_FALSE(it.isEnabled());
+}
+
+TEST_F(TransitionTest, ApproximateTimeMatchesStampsWithinTheSlop)
+{
+    OutputTransition fast;
+    fast.addOutput(o1);
+    OutputTransition slow;
+    slow.addOutput(o2);
+
+    InputTransition it;
+    it.addInput(i1);
+    it.addInput(i2);
+    it.setSynchronizationPolicy(InputSyncPolicy::APPROXIMATE_TIME);
+    it.setSynchronizationSlop(5000);
+
+    ConnectionPtr c1 = DirectConnection::connect(o1, i1);
+    ConnectionPtr c2 = DirectConnection::connect(o2, i2);
+
+    // the fast producer is never held back by the slow one, values are the stamps in ms
+    for (int ms = 0; ms <= 100; ms += 10) {
+        ASSERT_TRUE(fast.canStartSendingMessages());
+        sendMessage(*o1, ms, ms * 1000);
+        fast.sendMessages(false);
+    }
+    ASSERT_FALSE(it.isEnabled());
+
+    sendMessage(*o2, 52, 52000);
+    slow.sendMessages(false);
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 50);
+    ASSERT_RECEIVED(*i2, 52);
+    ASSERT_EQ(5u, it.countDroppedTokens());
+
+    it.notifyMessageRead();
+    it.notifyMessageProcessed();
+    ASSERT_FALSE(it.isEnabled());
+    ASSERT_TRUE(slow.canStartSendingMessages());
+
+    // tokens that are too old to be matched are dropped, the buffer is bounded
+    for (int ms = 110; ms <= 500; ms += 10) {
+        ASSERT_TRUE(fast.canStartSendingMessages());
+        sendMessage(*o1, ms, ms * 1000);
+        fast.sendMessages(false);
+    }
+    ASSERT_EQ(5u + 45u - it.getSynchronizationBufferSize(), it.countDroppedTokens());
+
+    sendMessage(*o2, 498, 498000);
+    slow.sendMessages(false);
+
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 500);
+    ASSERT_RECEIVED(*i2, 498);
+}
+
+TEST_F(TransitionTest, LatestValueSamplesTheSecondaryInputs)
+{
+    OutputTransition primary;
+    primary.addOutput(o1);
+    OutputTransition secondary;
+    secondary.addOutput(o2);
+
+    InputTransition it;
+    it.addInput(i1);
+    it.addInput(i2);
+    it.setSynchronizationPolicy(InputSyncPolicy::LATEST_VALUE);
+    ASSERT_EQ(i1, it.getPrimaryInput());
+
+    ConnectionPtr c1 = DirectConnection::connect(o1, i1);
+    ConnectionPtr c2 = DirectConnection::connect(o2, i2);
+
+    // the secondary input only provides values, it does not trigger processing
+    for (int value : { 100, 101 }) {
+        ASSERT_TRUE(secondary.canStartSendingMessages());
+        sendMessage(*o2, value);
+        secondary.sendMessages(false);
+        ASSERT_FALSE(it.isEnabled());
+    }
+
+    sendMessage(*o1, 1);
+    primary.sendMessages(false);
+    ASSERT_TRUE(it.isEnabled());
+    it.forwardMessages();
+    ASSERT_RECEIVED(*i1, 1);
+    ASSERT_RECEIVED(*i2, 101);
+
+    // the primary producer waits for the consumer, the secondary one does not
+    ASSERT_FALSE(primary.canStartSendingMessages());
+    ASSERT_TRUE(secondary.canStartSendingMessages());
+    sendMessage(*o2, 102);
+    secondary.sendMessages(false);
+
+    it.notifyMessageRead();
+    it.notifyMessageProcessed();
+    ASSERT_FALSE(it.isEnabled());
+
+    // the latest value is used for every message of the primary input
+    for (int value : { 2, 3 }) {
+        ASSERT_TRUE(primary.canStartSendingMessages());
+        sendMessage(*o1, value);
+        primary.sendMessages(false);
+
+        ASSERT_TRUE(it.isEnabled());
+        it.forwardMessages();
+        ASSERT_RECEIVED(*i1, value);
+        ASSERT_RECEIVED(*i2, 102);
+
+        it.notifyMessageRead();
+        it.notifyMessageProcessed();
+    }
+}
@@ -42,6 +42,7 @@ public:
     // CORE
     virtual void reset() = 0;
     virtual void load(const std::string& file) = 0;
+    virtual void reload(const std::string& file) = 0;
     virtual void saveAs(const std::string& file, bool quiet = false) = 0;
 
     virtual SnippetPtr serializeNodes(const AUUID& graph_id, const std::vector<UUID>& nodes) const = 0;
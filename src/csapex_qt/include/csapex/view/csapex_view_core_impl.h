@@ -17,6 +17,7 @@ public:
     // CORE
     void reset() override;
     void load(const std::string& file) override;
+    void reload(const std::string& file) override;
     void saveAs(const std::string& file, bool quiet = false) override;
 
     SnippetPtr serializeNodes(const AUUID& graph_id, const std::vector<UUID>& nodes) const override;
@@ -165,6 +165,11 @@ void CsApexViewCoreImplementation::load(const std::string& file)
     core_->load(file);
 }
 
+void CsApexViewCoreImplementation::reload(const std::string& file)
+{
+    core_->reload(file);
+}
+
 void CsApexViewCoreImplementation::saveAs(const std::string& file, bool quiet)
 {
     core_->saveAs(file, quiet);
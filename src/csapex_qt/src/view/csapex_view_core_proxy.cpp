@@ -273,6 +273,11 @@ void CsApexViewCoreProxy::load(const std::string& file)
     session_->sendRequest<CoreRequests>(CoreRequests::CoreRequestType::CoreLoad, file);
 }
 
+void CsApexViewCoreProxy::reload(const std::string& file)
+{
+    session_->sendRequest<CoreRequests>(CoreRequests::CoreRequestType::CoreReload, file);
+}
+
 void CsApexViewCoreProxy::saveAs(const std::string& file, bool quiet)
 {
     session_->sendRequest<CoreRequests>(CoreRequests::CoreRequestType::CoreSave, file, quiet);
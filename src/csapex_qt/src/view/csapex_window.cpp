@@ -1132,7 +1132,7 @@ void CsApexWindow::saveAsCopy()
 
 void CsApexWindow::reload()
 {
-    view_core_.load(getConfigFile());
+    view_core_.reload(getConfigFile());
 }
 
 void CsApexWindow::reset()
@@ -32,6 +32,7 @@
 #include <QtGui>
 #include <QtOpenGL>
 #include <QTimer>
+#include <QInputDialog>
 
 #ifndef GL_MULTISAMPLE
 #define GL_MULTISAMPLE 0x809D
@@ -1395,6 +1396,23 @@ bool DesignerScene::showConnectionContextMenu()
     active->setChecked(c.active);
     menu.addAction(active);
 
+    QMenu* buffer = menu.addMenu("buffering");
+    QAction* depth = new QAction(QString("queue depth: %1 ...").arg(c.queue_depth), buffer);
+    buffer->addAction(depth);
+    buffer->addSeparator();
+
+    std::map<QAction*, BufferPolicy> policies;
+    auto addPolicy = [&](const QString& label, BufferPolicy policy) {
+        QAction* action = new QAction(label, buffer);
+        action->setCheckable(true);
+        action->setChecked(c.buffer_policy == policy);
+        buffer->addAction(action);
+        policies[action] = policy;
+    };
+    addPolicy("block when full", BufferPolicy::BLOCK);
+    addPolicy("drop oldest when full", BufferPolicy::DROP_OLDEST);
+    addPolicy("drop newest when full", BufferPolicy::DROP_NEWEST);
+
     QAction* selectedItem = menu.exec(QCursor::pos());
 
     if (selectedItem == del) {
@@ -1405,6 +1423,16 @@ bool DesignerScene::showConnectionContextMenu()
 
     } else if (selectedItem == active) {
         view_core_.getCommandDispatcher()->execute(CommandFactory(graph_facade_.get()).setConnectionActive(highlight_connection_id_, active->isChecked()));
+
+    } else if (selectedItem == depth) {
+        bool ok = false;
+        int queue_depth = QInputDialog::getInt(QApplication::activeWindow(), "Queue depth", "Number of tokens the connection can hold", c.queue_depth, 1, 1024, 1, &ok);
+        if (ok && queue_depth != c.queue_depth) {
+            view_core_.getCommandDispatcher()->execute(CommandFactory(graph_facade_.get()).setConnectionBuffer(highlight_connection_id_, queue_depth, c.buffer_policy));
+        }
+
+    } else if (policies.find(selectedItem) != policies.end()) {
+        view_core_.getCommandDispatcher()->execute(CommandFactory(graph_facade_.get()).setConnectionBuffer(highlight_connection_id_, c.queue_depth, policies[selectedItem]));
     }
 
     return true;
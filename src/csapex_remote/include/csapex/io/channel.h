@@ -23,6 +23,17 @@ public:
         apex_assert_hard(res);
         return res->template getResult<Result>();
     }
+    template <typename Result, typename Request, typename Type, typename... Args>
+    std::future<Result> requestAsync(Type type, Args&&... args) const
+    {
+        using ResponseFuture = std::future<std::shared_ptr<typename Request::ResponseT const>>;
+        std::shared_ptr<ResponseFuture> res = std::make_shared<ResponseFuture>(session_.sendRequestAsync<Request>(type, name_, std::forward<Args>(args)...));
+        return std::async(std::launch::deferred, [res]() {
+            auto response = res->get();
+            apex_assert_hard(response);
+            return response->template getResult<Result>();
+        });
+    }
     template <typename Request, typename Type, typename... Args>
     void sendRequest(Type type, Args&&... args) const
     {
@@ -41,6 +52,7 @@ public:
     void handleNote(const io::NoteConstPtr& note);
 
     Session& getSession();
+    const AUUID& getName() const;
 
 public:
     slim_signal::Signal<void(const StreamableConstPtr&)> raw_packet_received;
@@ -25,6 +25,13 @@ public:
 
     AUUID getAUUID() const;
 
+    /**
+     * @brief getSupersedeKey identifies the state that this note reports.
+     *        A newer note with the same key makes an older note, that has not been sent yet, obsolete.
+     *        Notes that report events rather than the latest value of some state return an empty key.
+     */
+    virtual std::string getSupersedeKey() const;
+
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
@@ -28,7 +28,7 @@ public:
     class CommandRequest : public RequestImplementation<CommandRequest>
     {
     public:
-        CommandRequest(uint8_t request_id);
+        CommandRequest(uint32_t request_id);
         CommandRequest(CommandRequestType request_type);
 
         CommandRequest(CommandRequestType request_type, const CommandPtr& param) : CommandRequest(request_type)
@@ -55,9 +55,9 @@ public:
     class CommandResponse : public ResponseImplementation<CommandResponse>
     {
     public:
-        CommandResponse(uint8_t request_id);
-        CommandResponse(CommandRequestType request_type, uint8_t request_id);
-        CommandResponse(CommandRequestType request_type, bool result, uint8_t request_id);
+        CommandResponse(uint32_t request_id);
+        CommandResponse(CommandRequestType request_type, uint32_t request_id);
+        CommandResponse(CommandRequestType request_type, bool result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
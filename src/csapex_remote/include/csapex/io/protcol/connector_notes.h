@@ -35,6 +35,8 @@ public:
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
+    std::string getSupersedeKey() const override;
+
     ConnectorNoteType getNoteType() const
     {
         return note_type_;
@@ -26,7 +26,7 @@ public:
     class ConnectorRequest : public RequestImplementation<ConnectorRequest>
     {
     public:
-        ConnectorRequest(uint8_t request_id);
+        ConnectorRequest(uint32_t request_id);
         ConnectorRequest(ConnectorRequestType request_type, const AUUID& uuid);
         ConnectorRequest(ConnectorRequestType request_type, const AUUID& uuid, const boost::any& payload);
 
@@ -54,9 +54,9 @@ public:
     class ConnectorResponse : public ResponseImplementation<ConnectorResponse>
     {
     public:
-        ConnectorResponse(uint8_t request_id);
-        ConnectorResponse(ConnectorRequestType request_type, uint8_t request_id, const AUUID& uuid);
-        ConnectorResponse(ConnectorRequestType request_type, boost::any result, uint8_t request_id, const AUUID& uuid);
+        ConnectorResponse(uint32_t request_id);
+        ConnectorResponse(ConnectorRequestType request_type, uint32_t request_id, const AUUID& uuid);
+        ConnectorResponse(ConnectorRequestType request_type, boost::any result, uint32_t request_id, const AUUID& uuid);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
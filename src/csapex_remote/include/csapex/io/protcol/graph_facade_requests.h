@@ -30,7 +30,7 @@ public:
     class GraphFacadeRequest : public RequestImplementation<GraphFacadeRequest>
     {
     public:
-        GraphFacadeRequest(uint8_t request_id);
+        GraphFacadeRequest(uint32_t request_id);
         GraphFacadeRequest(GraphFacadeRequestType request_type, const AUUID& uuid);
 
         template <typename... Args>
@@ -64,9 +64,9 @@ public:
     class GraphFacadeResponse : public ResponseImplementation<GraphFacadeResponse>
     {
     public:
-        GraphFacadeResponse(uint8_t request_id);
-        GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, uint8_t request_id);
-        GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id);
+        GraphFacadeResponse(uint32_t request_id);
+        GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, uint32_t request_id);
+        GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
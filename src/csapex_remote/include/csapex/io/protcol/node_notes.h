@@ -63,6 +63,8 @@ public:
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
+    std::string getSupersedeKey() const override;
+
     NodeNoteType getNoteType() const
     {
         return note_type_;
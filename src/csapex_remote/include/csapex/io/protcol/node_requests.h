@@ -36,7 +36,7 @@ public:
     class NodeRequest : public RequestImplementation<NodeRequest>
     {
     public:
-        NodeRequest(uint8_t request_id);
+        NodeRequest(uint32_t request_id);
         NodeRequest(NodeRequestType request_type, const AUUID& uuid);
 
         template <typename... Args>
@@ -61,6 +61,11 @@ public:
             return boost::any_cast<R>(arguments_.at(i));
         }
 
+        std::size_t countArguments() const
+        {
+            return arguments_.size();
+        }
+
     private:
         NodeRequestType request_type_;
         AUUID uuid_;
@@ -70,9 +75,9 @@ public:
     class NodeResponse : public ResponseImplementation<NodeResponse>
     {
     public:
-        NodeResponse(uint8_t request_id);
-        NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint8_t request_id);
-        NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id);
+        NodeResponse(uint32_t request_id);
+        NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint32_t request_id);
+        NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -31,6 +31,8 @@ public:
     virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
     virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
 
+    std::string getSupersedeKey() const override;
+
     ProfilerNoteType getNoteType() const
     {
         return note_type_;
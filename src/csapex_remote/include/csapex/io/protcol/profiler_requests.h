@@ -20,7 +20,7 @@ public:
     class ProfilerRequest : public RequestImplementation<ProfilerRequest>
     {
     public:
-        ProfilerRequest(uint8_t request_id);
+        ProfilerRequest(uint32_t request_id);
         ProfilerRequest(ProfilerRequestType request_type, const AUUID& uuid);
 
         template <typename... Args>
@@ -54,9 +54,9 @@ public:
     class ProfilerResponse : public ResponseImplementation<ProfilerResponse>
     {
     public:
-        ProfilerResponse(uint8_t request_id);
-        ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint8_t request_id);
-        ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id);
+        ProfilerResponse(uint32_t request_id);
+        ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint32_t request_id);
+        ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -0,0 +1,87 @@
+#ifndef REQUEST_NODE_SNAPSHOTS_H
+#define REQUEST_NODE_SNAPSHOTS_H
+
+/// PROJECT
+#include <csapex/io/request_impl.hpp>
+#include <csapex/io/response_impl.hpp>
+#include <csapex/model/connector_description.h>
+#include <csapex/model/model_fwd.h>
+#include <csapex/param/parameter.h>
+#include <csapex/serialization/serialization_fwd.h>
+
+namespace csapex
+{
+/**
+ * @brief The NodeSnapshot struct contains everything a NodeFacadeProxy needs to be constructed
+ */
+struct NodeSnapshot
+{
+    UUID uuid;
+    NodeStatePtr state;
+    std::vector<param::ParameterPtr> parameters;
+
+    std::vector<ConnectorDescription> external_inputs;
+    std::vector<ConnectorDescription> external_outputs;
+    std::vector<ConnectorDescription> external_events;
+    std::vector<ConnectorDescription> external_slots;
+
+    std::vector<ConnectorDescription> internal_inputs;
+    std::vector<ConnectorDescription> internal_outputs;
+    std::vector<ConnectorDescription> internal_events;
+    std::vector<ConnectorDescription> internal_slots;
+};
+
+/**
+ * @brief The RequestNodeSnapshots class fetches the snapshots of all nodes of a graph in one round-trip
+ */
+class RequestNodeSnapshots
+{
+public:
+    class SnapshotRequest : public RequestImplementation<SnapshotRequest>
+    {
+    public:
+        SnapshotRequest(const AUUID& graph);
+        SnapshotRequest(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        virtual ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const override;
+
+        std::string getType() const override
+        {
+            return "RequestNodeSnapshots";
+        }
+
+    private:
+        AUUID graph_;
+    };
+
+    class SnapshotResponse : public ResponseImplementation<SnapshotResponse>
+    {
+    public:
+        SnapshotResponse(const std::vector<NodeSnapshot>& snapshots, uint32_t request_id);
+        SnapshotResponse(uint32_t request_id);
+
+        virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
+        virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
+
+        const std::vector<NodeSnapshot>& getSnapshots() const;
+
+        std::string getType() const override
+        {
+            return "RequestNodeSnapshots";
+        }
+
+    private:
+        std::vector<NodeSnapshot> snapshots_;
+    };
+
+public:
+    using RequestT = SnapshotRequest;
+    using ResponseT = SnapshotResponse;
+};
+
+}  // namespace csapex
+
+#endif  // REQUEST_NODE_SNAPSHOTS_H
@@ -16,7 +16,7 @@ public:
     {
     public:
         NodeRequest();
-        NodeRequest(uint8_t request_id);
+        NodeRequest(uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -32,8 +32,8 @@ public:
     class NodeResponse : public ResponseImplementation<NodeResponse>
     {
     public:
-        NodeResponse(const std::map<std::string, std::vector<NodeConstructorPtr>>& tag_map, uint8_t request_id);
-        NodeResponse(uint8_t request_id);
+        NodeResponse(const std::map<std::string, std::vector<NodeConstructorPtr>>& tag_map, uint32_t request_id);
+        NodeResponse(uint32_t request_id);
 
         virtual void serialize(SerializationBuffer& data, SemanticVersion& version) const override;
         virtual void deserialize(const SerializationBuffer& data, const SemanticVersion& version) override;
@@ -28,6 +28,26 @@ protected:
         return res->template getResult<Result>();
     }
 
+    template <typename Result, typename Request, typename Type, typename... Args>
+    std::future<Result> requestAsync(Type type, Args&&... args) const
+    {
+        using ResponseFuture = std::future<std::shared_ptr<typename Request::ResponseT const>>;
+        std::shared_ptr<ResponseFuture> res = std::make_shared<ResponseFuture>(session_->sendRequestAsync<Request>(type, std::forward<Args>(args)...));
+        return std::async(std::launch::deferred, [res]() {
+            auto response = res->get();
+            apex_assert_hard(response);
+            return response->template getResult<Result>();
+        });
+    }
+
+    template <typename Result>
+    static std::future<Result> makeReadyFuture(const Result& value)
+    {
+        std::promise<Result> promise;
+        promise.set_value(value);
+        return promise.get_future();
+    }
+
 protected:
     SessionPtr session_;
 
@@ -0,0 +1,80 @@
+#ifndef RAW_DATA_STREAM_H
+#define RAW_DATA_STREAM_H
+
+/// PROJECT
+#include <csapex/model/model_fwd.h>
+#include <csapex/io/remote_io_fwd.h>
+#include <csapex/model/observer.h>
+#include <csapex/serialization/serialization_fwd.h>
+#include <csapex/utility/uuid.h>
+
+/// SYSTEM
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace csapex
+{
+/**
+ * @brief The RawDataStream class forwards the raw data of a node to all sessions that watch it.
+ *        Every message is serialized at most once and the buffer is shared by all clients that are due.
+ *        Clients can limit the rate at which they receive messages, messages in between are dropped.
+ *        Messages are queued as frames, so a slow client only receives the most recent one.
+ */
+class RawDataStream : public Observer
+{
+public:
+    /// creates a smaller version of a message, e.g. a decimated point cloud or a thumbnail
+    using PreviewEncoder = std::function<RawMessageConstPtr(const RawMessageConstPtr&)>;
+
+    struct ClientOptions
+    {
+        ClientOptions();
+
+        /// maximum number of messages per second, 0 means unlimited
+        double max_frequency;
+        /// request the preview instead of the full message
+        bool preview;
+    };
+
+public:
+    static void addClient(const NodeHandlePtr& node, const SessionPtr& session, const ClientOptions& options);
+    static void removeClient(const NodeHandlePtr& node, Session* session);
+
+    static void setPreviewEncoder(PreviewEncoder encoder);
+
+    ~RawDataStream();
+
+private:
+    RawDataStream(const NodeHandlePtr& node);
+
+    void addClient(const SessionPtr& session, const ClientOptions& options);
+    bool removeClient(Session* session);
+
+    void publish(const StreamableConstPtr& data);
+
+    static void release(const AUUID& uuid, Session* session);
+
+private:
+    struct Client
+    {
+        Session* key;
+        std::weak_ptr<Session> session;
+        std::chrono::steady_clock::duration min_interval;
+        bool preview;
+        std::chrono::steady_clock::time_point last_sent;
+        slim_signal::ScopedConnection stopped;
+    };
+
+    NodeHandleWeakPtr node_;
+    AUUID uuid_;
+    std::string stream_key_;
+
+    std::mutex clients_mutex_;
+    std::vector<Client> clients_;
+};
+
+}  // namespace csapex
+
+#endif  // RAW_DATA_STREAM_H
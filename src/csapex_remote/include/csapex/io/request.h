@@ -14,7 +14,7 @@ namespace csapex
 class Request : public Streamable
 {
 public:
-    Request(uint8_t id);
+    Request(uint32_t id);
 
     static const uint8_t PACKET_TYPE_ID = 2;
 
@@ -23,11 +23,11 @@ public:
 
     virtual ResponsePtr execute(const SessionPtr& session, CsApexCore& core) const = 0;
 
-    void overwriteRequestID(uint8_t id) const;
-    uint8_t getRequestID() const;
+    void overwriteRequestID(uint32_t id) const;
+    uint32_t getRequestID() const;
 
 private:
-    mutable uint8_t request_id_;
+    mutable uint32_t request_id_;
 };
 
 }  // namespace csapex
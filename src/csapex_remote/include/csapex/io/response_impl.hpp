@@ -14,7 +14,7 @@ protected:
     CLONABLE_IMPLEMENTATION_CONSTRUCTOR(I, 0);
 
 protected:
-    ResponseImplementation(uint8_t id) : Response(id)
+    ResponseImplementation(uint32_t id) : Response(id)
     {
     }
 };
@@ -11,6 +11,7 @@
 
 /// SYSTEM
 #include <boost/asio.hpp>
+#include <chrono>
 #include <deque>
 #include <future>
 #include <unordered_map>
@@ -31,6 +32,18 @@ public:
         }
     };
 
+    struct WriteStatistics
+    {
+        std::size_t queue_depth;
+        std::size_t max_queue_depth;
+
+        uint64_t packets_sent;
+        uint64_t packets_superseded;
+        uint64_t packets_dropped;
+        uint64_t bytes_sent;
+        double bytes_per_second;
+    };
+
 public:
     Session(Socket socket, const std::string& name);
     ~Session();
@@ -49,6 +62,19 @@ public:
 
     void write(const StreamableConstPtr& packet);
     void write(const std::string& message);
+    /// writes a packet that has already been serialized and finalized, so that it can be shared between sessions
+    void write(const std::shared_ptr<const SerializationBuffer>& serialized);
+    /// writes a serialized frame of a stream, it replaces the frame of the same stream that has not been sent yet
+    void writeFrame(const std::string& stream, const std::shared_ptr<const SerializationBuffer>& serialized);
+
+    /**
+     * @brief setMaxQueuedPackets limits the number of queued outgoing packets. Writers are never delayed.
+     *        A full queue only accepts requests and responses, because their number is bounded by the open requests.
+     *        Notes that report the latest value of some state replace their queued predecessor and are only queued once per state.
+     *        Frames, other notes and broadcasts are dropped.
+     */
+    void setMaxQueuedPackets(std::size_t max);
+    WriteStatistics getWriteStatistics() const;
 
 
     //
@@ -56,6 +82,9 @@ public:
     //
     ResponseConstPtr sendRequest(RequestConstPtr request);
 
+    /// sends the request without waiting, the response is delivered through the returned future
+    std::future<ResponseConstPtr> sendRequestAsync(RequestConstPtr request);
+
     template <typename RequestWrapper>
     std::shared_ptr<typename RequestWrapper::ResponseT const> sendRequest(std::shared_ptr<typename RequestWrapper::RequestT const> request)
     {
@@ -75,6 +104,23 @@ public:
         return nullptr;
     }
 
+    template <typename RequestWrapper, typename... Args>
+    std::future<std::shared_ptr<typename RequestWrapper::ResponseT const>> sendRequestAsync(Args&&... args)
+    {
+        std::shared_ptr<std::future<ResponseConstPtr>> response = std::make_shared<std::future<ResponseConstPtr>>(sendRequestAsync(std::make_shared<typename RequestWrapper::RequestT>(std::forward<Args>(args)...)));
+        SessionPtr self = shared_from_this();
+        return std::async(std::launch::deferred, [self, response]() -> std::shared_ptr<typename RequestWrapper::ResponseT const> {
+            auto res = response->get();
+            apex_assert_hard(res);
+            if (auto casted = std::dynamic_pointer_cast<typename RequestWrapper::ResponseT const>(res)) {
+                return casted;
+            } else {
+                self->handleFeedback(res);
+            }
+            return nullptr;
+        });
+    }
+
     //
     // NOTE
     //
@@ -119,21 +165,57 @@ protected:
 
     void read_async();
 
-    void write_packet(SerializationBuffer& buffer);
+    void write_async(const std::vector<std::shared_ptr<const SerializationBuffer>>& buffers);
+    void writeCompleted(std::size_t packets, std::size_t bytes);
+
+    enum class WritePolicy
+    {
+        RELIABLE,
+        LATEST_STATE,
+        DROPPABLE
+    };
+
+    struct OutgoingPacket
+    {
+        StreamableConstPtr packet;
+        std::shared_ptr<const SerializationBuffer> serialized;
+        std::string key;
+    };
+
+    void enqueue(OutgoingPacket&& outgoing, WritePolicy policy);
+    void dequeue();
+
+    uint32_t generateRequestID();
 
 protected:
     std::thread packet_handler_thread_;
     std::unique_ptr<Socket> socket_;
 
-    uint8_t next_request_id_;
+    std::atomic<uint32_t> next_request_id_;
 
-    std::recursive_mutex packets_mutex_;
+    mutable std::recursive_mutex packets_mutex_;
     std::condition_variable_any packets_available_;
     std::deque<StreamableConstPtr> packets_received_;
-    std::deque<StreamableConstPtr> packets_to_send_;
+    std::deque<OutgoingPacket> packets_to_send_;
+    std::size_t max_queued_packets_;
+    bool write_in_flight_;
+
+    // keyed packets are found by their sequence number, the front of the queue has the number packets_dequeued_
+    std::unordered_map<std::string, uint64_t> queued_keys_;
+    uint64_t packets_enqueued_;
+    uint64_t packets_dequeued_;
+
+    std::size_t max_queue_depth_;
+    std::atomic<uint64_t> packets_sent_count_;
+    std::atomic<uint64_t> packets_superseded_;
+    std::atomic<uint64_t> packets_dropped_;
+    std::atomic<uint64_t> bytes_sent_;
+    std::atomic<double> bytes_per_second_;
+    std::chrono::steady_clock::time_point rate_window_start_;
+    uint64_t rate_window_bytes_;
 
     std::recursive_mutex open_requests_mutex_;
-    std::map<uint8_t, std::promise<ResponseConstPtr>*> open_requests_;
+    std::unordered_map<uint32_t, std::shared_ptr<std::promise<ResponseConstPtr>>> open_requests_;
 
     std::recursive_mutex running_mutex_;
     std::atomic<bool> running_;
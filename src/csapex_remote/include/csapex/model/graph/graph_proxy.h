@@ -10,6 +10,7 @@
 namespace csapex
 {
 class GraphImplementation;
+struct NodeSnapshot;
 
 class GraphProxy : public Graph, public Observer
 {
@@ -60,7 +61,7 @@ public:
      **/
 
 private:
-    void vertexAdded(const UUID& id);
+    void vertexAdded(const UUID& id, const NodeSnapshot* snapshot = nullptr);
     void vertexRemoved(const UUID& id);
 
     void connectionAdded(const ConnectionDescription& id);
@@ -8,16 +8,25 @@
 #include <csapex/io/proxy.h>
 
 /// SYSTEM
+#include <atomic>
+#include <future>
 #include <unordered_map>
 
 namespace csapex
 {
 class ProfilerProxy;
+struct NodeSnapshot;
 
 class CSAPEX_CORE_EXPORT NodeFacadeProxy : public NodeFacade, public Proxy
 {
 public:
-    NodeFacadeProxy(const SessionPtr& session, AUUID uuid);
+    /**
+     * @brief NodeFacadeProxy
+     * @param session the connection to the server
+     * @param uuid the absolute id of the node
+     * @param snapshot if given, the initial state is taken from it instead of being requested
+     */
+    NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot* snapshot = nullptr);
 
     ~NodeFacadeProxy();
 
@@ -28,6 +37,13 @@ public:
 
     void setProfiling(bool profiling) override;
 
+    /**
+     * @brief setRawDataOptions configures how the server streams the raw data of the node
+     * @param max_frequency maximum number of messages per second, 0 means unlimited
+     * @param preview request the smaller preview instead of the full messages, if the server can encode them
+     */
+    void setRawDataOptions(double max_frequency, bool preview);
+
     bool isParameterInput(const UUID& id) override;
     bool isParameterOutput(const UUID& id) override;
 
@@ -66,6 +82,20 @@ public:
      * end: generate getters
      **/
 
+/**
+ * begin: generate asynchronous getters
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function) std::future<type> function##Async() const;
+
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function) HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+    /**
+     * end: generate asynchronous getters
+     **/
+
     void createConnectorProxy(const ConnectorDescription& cd);
     void removeConnectorProxy(const ConnectorDescription& cd);
 
@@ -73,6 +103,7 @@ private:
     void handleBroadcast(const BroadcastMessageConstPtr& message) override;
 
     void createParameterProxy(param::ParameterPtr proxy) const;
+    void requestRawData();
 
 private:
     AUUID uuid_;
@@ -98,6 +129,9 @@ private:
 
     long guard_;
 
+    std::atomic<double> raw_data_max_frequency_;
+    std::atomic<bool> raw_data_preview_;
+
     NodeStatePtr state_proxy_;
 
     mutable std::vector<param::ParameterPtr> parameters_;
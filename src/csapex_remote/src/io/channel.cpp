@@ -24,3 +24,8 @@ Session& Channel::getSession()
 {
     return session_;
 }
+
+const AUUID& Channel::getName() const
+{
+    return name_;
+}
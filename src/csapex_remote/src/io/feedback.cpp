@@ -14,7 +14,7 @@ Feedback::Feedback(const std::string& message) : Response(0), message_(message)
 {
 }
 
-Feedback::Feedback(const std::string& message, uint8_t request_id) : Response(request_id), message_(message)
+Feedback::Feedback(const std::string& message, uint32_t request_id) : Response(request_id), message_(message)
 {
 }
 
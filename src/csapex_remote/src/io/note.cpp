@@ -22,6 +22,11 @@ AUUID Note::getAUUID() const
     return uuid_;
 }
 
+std::string Note::getSupersedeKey() const
+{
+    return std::string();
+}
+
 void Note::serialize(SerializationBuffer& data, SemanticVersion& version) const
 {
     data << uuid_;
@@ -24,7 +24,7 @@ AddParameter::ParameterRequest::ParameterRequest(const AUUID& id, const std::str
     apex_assert_hard(!name_.empty());
 }
 
-AddParameter::ParameterRequest::ParameterRequest(uint8_t request_id) : RequestImplementation(request_id)
+AddParameter::ParameterRequest::ParameterRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -68,10 +68,10 @@ void AddParameter::ParameterRequest::deserialize(const SerializationBuffer& data
 /// RESPONSE
 ///
 
-AddParameter::ParameterResponse::ParameterResponse(const param::ParameterConstPtr& parameter, uint8_t request_id) : ResponseImplementation(request_id), param_(parameter)
+AddParameter::ParameterResponse::ParameterResponse(const param::ParameterConstPtr& parameter, uint32_t request_id) : ResponseImplementation(request_id), param_(parameter)
 {
 }
-AddParameter::ParameterResponse::ParameterResponse(uint8_t request_id) : ResponseImplementation(request_id)
+AddParameter::ParameterResponse::ParameterResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
@@ -24,7 +24,7 @@ CommandRequests::CommandRequest::CommandRequest(CommandRequestType request_type)
 {
 }
 
-CommandRequests::CommandRequest::CommandRequest(uint8_t request_id) : RequestImplementation(request_id)
+CommandRequests::CommandRequest::CommandRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -83,13 +83,13 @@ void CommandRequests::CommandRequest::deserialize(const SerializationBuffer& dat
 /// RESPONSE
 ///
 
-CommandRequests::CommandResponse::CommandResponse(CommandRequestType request_type, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(false)
+CommandRequests::CommandResponse::CommandResponse(CommandRequestType request_type, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(false)
 {
 }
-CommandRequests::CommandResponse::CommandResponse(CommandRequestType request_type, bool result, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(result)
+CommandRequests::CommandResponse::CommandResponse(CommandRequestType request_type, bool result, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), result_(result)
 {
 }
-CommandRequests::CommandResponse::CommandResponse(uint8_t request_id) : ResponseImplementation(request_id), result_(false)
+CommandRequests::CommandResponse::CommandResponse(uint32_t request_id) : ResponseImplementation(request_id), result_(false)
 {
 }
 
@@ -36,3 +36,9 @@ void ConnectorNote::deserialize(const SerializationBuffer& data, const SemanticV
     data >> note_type_;
     data >> payload_;
 }
+
+std::string ConnectorNote::getSupersedeKey() const
+{
+    // all connector notes report the latest value of a dynamic accessor
+    return getType() + ":" + uuid_.getFullName() + ":" + std::to_string(static_cast<int>(note_type_));
+}
@@ -28,7 +28,7 @@ GraphFacadeRequests::GraphFacadeRequest::GraphFacadeRequest(GraphFacadeRequestTy
 {
 }
 
-GraphFacadeRequests::GraphFacadeRequest::GraphFacadeRequest(uint8_t request_id) : RequestImplementation(request_id)
+GraphFacadeRequests::GraphFacadeRequest::GraphFacadeRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -93,16 +93,16 @@ void GraphFacadeRequests::GraphFacadeRequest::deserialize(const SerializationBuf
 /// RESPONSE
 ///
 
-GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, uint8_t request_id)
+GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(GraphFacadeRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(uint8_t request_id) : ResponseImplementation(request_id)
+GraphFacadeRequests::GraphFacadeResponse::GraphFacadeResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
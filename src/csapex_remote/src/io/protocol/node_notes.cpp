@@ -36,3 +36,24 @@ void NodeNote::deserialize(const SerializationBuffer& data, const SemanticVersio
     data >> note_type_;
     data >> payload_;
 }
+
+std::string NodeNote::getSupersedeKey() const
+{
+    switch (note_type_) {
+        case NodeNoteType::NodeStateChanged:
+/**
+ * begin: state notes
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function) case NodeNoteType::function##Changed:
+#define HANDLE_SIGNAL(_enum, signal)
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+            /**
+             * end: state notes
+             **/
+            return getType() + ":" + uuid_.getFullName() + ":" + std::to_string(static_cast<int>(note_type_));
+        default:
+            return std::string();
+    }
+}
@@ -4,7 +4,7 @@
 /// PROJECT
 #include <csapex/command/command.h>
 #include <csapex/io/feedback.h>
-#include <csapex/io/raw_message.h>
+#include <csapex/io/raw_data_stream.h>
 #include <csapex/io/session.h>
 #include <csapex/model/graph_facade_impl.h>
 #include <csapex/model/graph/graph_impl.h>
@@ -31,7 +31,7 @@ NodeRequests::NodeRequest::NodeRequest(NodeRequestType request_type, const AUUID
 {
 }
 
-NodeRequests::NodeRequest::NodeRequest(uint8_t request_id) : RequestImplementation(request_id)
+NodeRequests::NodeRequest::NodeRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -44,23 +44,15 @@ ResponsePtr NodeRequests::NodeRequest::execute(const SessionPtr& session, CsApex
 
     switch (request_type_) {
         case NodeRequestType::AddClient: {
-            nh->raw_data_connection.connect([session](StreamableConstPtr data) {
-                if (RawMessageConstPtr msg = std::dynamic_pointer_cast<RawMessage const>(data)) {
-                    session->write(msg);
-                } else {
-                    // TODO: what to do here? we need a uuid
-                }
-            });
-            NodeHandle* nhp = nh.get();
-            session->stopped.connect([nhp](Session* session) {
-                (void)session;
-                // TODO: disconnect only the appropriate client...
-                nhp->raw_data_connection.disconnectAll();
-            });
+            RawDataStream::ClientOptions options;
+            if (countArguments() >= 2) {
+                options.max_frequency = getArgument<double>(0);
+                options.preview = getArgument<bool>(1);
+            }
+            RawDataStream::addClient(nh, session, options);
         } break;
         case NodeRequestType::RemoveClient: {
-            // TODO: disconnect only the appropriate client...
-            nh->raw_data_connection.disconnectAll();
+            RawDataStream::removeClient(nh, session.get());
         } break;
 
         case NodeRequestType::GetParameters: {
@@ -131,15 +123,15 @@ void NodeRequests::NodeRequest::deserialize(const SerializationBuffer& data, con
 /// RESPONSE
 ///
 
-NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint8_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
+NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, uint32_t request_id) : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+NodeRequests::NodeResponse::NodeResponse(NodeRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-NodeRequests::NodeResponse::NodeResponse(uint8_t request_id) : ResponseImplementation(request_id)
+NodeRequests::NodeResponse::NodeResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
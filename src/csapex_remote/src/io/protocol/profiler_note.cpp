@@ -36,3 +36,11 @@ void ProfilerNote::deserialize(const SerializationBuffer& data, const SemanticVe
     data >> note_type_;
     data >> payload_;
 }
+
+std::string ProfilerNote::getSupersedeKey() const
+{
+    if (note_type_ == ProfilerNoteType::EnabledChanged) {
+        return getType() + ":" + uuid_.getFullName();
+    }
+    return std::string();
+}
@@ -32,7 +32,7 @@ ProfilerRequests::ProfilerRequest::ProfilerRequest(ProfilerRequestType request_t
 {
 }
 
-ProfilerRequests::ProfilerRequest::ProfilerRequest(uint8_t request_id) : RequestImplementation(request_id)
+ProfilerRequests::ProfilerRequest::ProfilerRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -75,16 +75,16 @@ void ProfilerRequests::ProfilerRequest::deserialize(const SerializationBuffer& d
 /// RESPONSE
 ///
 
-ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint8_t request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid)
 {
 }
-ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint8_t request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(ProfilerRequestType request_type, const AUUID& uuid, boost::any result, uint32_t request_id)
   : ResponseImplementation(request_id), request_type_(request_type), uuid_(uuid), result_(result)
 {
 }
 
-ProfilerRequests::ProfilerResponse::ProfilerResponse(uint8_t request_id) : ResponseImplementation(request_id)
+ProfilerRequests::ProfilerResponse::ProfilerResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
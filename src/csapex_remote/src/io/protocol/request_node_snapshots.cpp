@@ -0,0 +1,130 @@
+/// HEADER
+#include <csapex/io/protcol/request_node_snapshots.h>
+
+/// PROJECT
+#include <csapex/model/graph_facade_impl.h>
+#include <csapex/model/graph/graph_impl.h>
+#include <csapex/model/node_facade.h>
+#include <csapex/model/node_state.h>
+#include <csapex/serialization/request_serializer.h>
+#include <csapex/serialization/io/std_io.h>
+#include <csapex/serialization/io/csapex_io.h>
+#include <csapex/utility/uuid_provider.h>
+
+/// SYSTEM
+#include <iostream>
+
+CSAPEX_REGISTER_REQUEST_SERIALIZER(RequestNodeSnapshots)
+
+using namespace csapex;
+
+///
+/// REQUEST
+///
+RequestNodeSnapshots::SnapshotRequest::SnapshotRequest(const AUUID& graph) : RequestImplementation(0), graph_(graph)
+{
+}
+
+RequestNodeSnapshots::SnapshotRequest::SnapshotRequest(uint32_t request_id) : RequestImplementation(request_id)
+{
+}
+
+ResponsePtr RequestNodeSnapshots::SnapshotRequest::execute(const SessionPtr& session, CsApexCore& core) const
+{
+    (void)session;
+
+    GraphFacadePtr gf = graph_.empty() ? core.getRoot() : core.getRoot()->getSubGraph(graph_);
+    GraphFacadeImplementationPtr gf_local = std::dynamic_pointer_cast<GraphFacadeImplementation>(gf);
+    apex_assert_hard(gf_local);
+
+    std::vector<NodeSnapshot> snapshots;
+    for (const NodeFacadePtr& nf : gf_local->getLocalGraph()->getAllNodeFacades()) {
+        NodeSnapshot snapshot;
+        snapshot.uuid = nf->getUUID();
+        snapshot.state = nf->getNodeState();
+        snapshot.parameters = nf->getParameters();
+
+        snapshot.external_inputs = nf->getExternalInputs();
+        snapshot.external_outputs = nf->getExternalOutputs();
+        snapshot.external_events = nf->getExternalEvents();
+        snapshot.external_slots = nf->getExternalSlots();
+
+        snapshot.internal_inputs = nf->getInternalInputs();
+        snapshot.internal_outputs = nf->getInternalOutputs();
+        snapshot.internal_events = nf->getInternalEvents();
+        snapshot.internal_slots = nf->getInternalSlots();
+
+        snapshots.push_back(std::move(snapshot));
+    }
+
+    return std::make_shared<SnapshotResponse>(snapshots, getRequestID());
+}
+
+void RequestNodeSnapshots::SnapshotRequest::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << graph_;
+}
+
+void RequestNodeSnapshots::SnapshotRequest::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    data >> graph_;
+}
+
+///
+/// RESPONSE
+///
+
+RequestNodeSnapshots::SnapshotResponse::SnapshotResponse(const std::vector<NodeSnapshot>& snapshots, uint32_t request_id) : ResponseImplementation(request_id), snapshots_(snapshots)
+{
+}
+RequestNodeSnapshots::SnapshotResponse::SnapshotResponse(uint32_t request_id) : ResponseImplementation(request_id)
+{
+}
+
+void RequestNodeSnapshots::SnapshotResponse::serialize(SerializationBuffer& data, SemanticVersion& version) const
+{
+    data << static_cast<uint64_t>(snapshots_.size());
+    for (const NodeSnapshot& snapshot : snapshots_) {
+        data << snapshot.uuid;
+        data << snapshot.state;
+        data << snapshot.parameters;
+
+        data << snapshot.external_inputs;
+        data << snapshot.external_outputs;
+        data << snapshot.external_events;
+        data << snapshot.external_slots;
+
+        data << snapshot.internal_inputs;
+        data << snapshot.internal_outputs;
+        data << snapshot.internal_events;
+        data << snapshot.internal_slots;
+    }
+}
+
+void RequestNodeSnapshots::SnapshotResponse::deserialize(const SerializationBuffer& data, const SemanticVersion& version)
+{
+    uint64_t count;
+    data >> count;
+
+    snapshots_.resize(count);
+    for (NodeSnapshot& snapshot : snapshots_) {
+        data >> snapshot.uuid;
+        data >> snapshot.state;
+        data >> snapshot.parameters;
+
+        data >> snapshot.external_inputs;
+        data >> snapshot.external_outputs;
+        data >> snapshot.external_events;
+        data >> snapshot.external_slots;
+
+        data >> snapshot.internal_inputs;
+        data >> snapshot.internal_outputs;
+        data >> snapshot.internal_events;
+        data >> snapshot.internal_slots;
+    }
+}
+
+const std::vector<NodeSnapshot>& RequestNodeSnapshots::SnapshotResponse::getSnapshots() const
+{
+    return snapshots_;
+}
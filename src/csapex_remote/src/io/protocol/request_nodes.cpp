@@ -22,7 +22,7 @@ RequestNodes::NodeRequest::NodeRequest() : RequestImplementation(0)
 {
 }
 
-RequestNodes::NodeRequest::NodeRequest(uint8_t request_id) : RequestImplementation(request_id)
+RequestNodes::NodeRequest::NodeRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -47,10 +47,10 @@ void RequestNodes::NodeRequest::deserialize(const SerializationBuffer& data, con
 /// RESPONSE
 ///
 
-RequestNodes::NodeResponse::NodeResponse(const std::map<std::string, std::vector<NodeConstructorPtr>>& tag_map, uint8_t request_id) : ResponseImplementation(request_id), tag_map_(tag_map)
+RequestNodes::NodeResponse::NodeResponse(const std::map<std::string, std::vector<NodeConstructorPtr>>& tag_map, uint32_t request_id) : ResponseImplementation(request_id), tag_map_(tag_map)
 {
 }
-RequestNodes::NodeResponse::NodeResponse(uint8_t request_id) : ResponseImplementation(request_id)
+RequestNodes::NodeResponse::NodeResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
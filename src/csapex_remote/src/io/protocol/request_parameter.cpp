@@ -22,7 +22,7 @@ RequestParameter::ParameterRequest::ParameterRequest(const AUUID& id) : RequestI
 {
 }
 
-RequestParameter::ParameterRequest::ParameterRequest(uint8_t request_id) : RequestImplementation(request_id)
+RequestParameter::ParameterRequest::ParameterRequest(uint32_t request_id) : RequestImplementation(request_id)
 {
 }
 
@@ -57,11 +57,11 @@ void RequestParameter::ParameterRequest::deserialize(const SerializationBuffer&
 /// RESPONSE
 ///
 
-RequestParameter::ParameterResponse::ParameterResponse(const param::ParameterConstPtr& parameter, uint8_t request_id) : ResponseImplementation(request_id), param_(parameter)
+RequestParameter::ParameterResponse::ParameterResponse(const param::ParameterConstPtr& parameter, uint32_t request_id) : ResponseImplementation(request_id), param_(parameter)
 {
     apex_assert_hard(param_ != nullptr);
 }
-RequestParameter::ParameterResponse::ParameterResponse(uint8_t request_id) : ResponseImplementation(request_id)
+RequestParameter::ParameterResponse::ParameterResponse(uint32_t request_id) : ResponseImplementation(request_id)
 {
 }
 
@@ -0,0 +1,193 @@
+/// HEADER
+#include <csapex/io/raw_data_stream.h>
+
+/// PROJECT
+#include <csapex/io/raw_message.h>
+#include <csapex/io/session.h>
+#include <csapex/model/node_handle.h>
+#include <csapex/serialization/packet_serializer.h>
+
+/// SYSTEM
+#include <unordered_map>
+
+using namespace csapex;
+
+namespace
+{
+std::mutex registry_mutex;
+std::unordered_map<AUUID, std::shared_ptr<RawDataStream>, AUUID::Hasher> registry;
+
+std::mutex encoder_mutex;
+RawDataStream::PreviewEncoder preview_encoder;
+
+std::shared_ptr<const SerializationBuffer> serialize(const StreamableConstPtr& packet)
+{
+    std::shared_ptr<SerializationBuffer> buffer = std::make_shared<SerializationBuffer>(PacketSerializer::serializePacket(packet));
+    buffer->finalize();
+    return buffer;
+}
+}  // namespace
+
+RawDataStream::ClientOptions::ClientOptions() : max_frequency(0.0), preview(false)
+{
+}
+
+void RawDataStream::addClient(const NodeHandlePtr& node, const SessionPtr& session, const ClientOptions& options)
+{
+    std::unique_lock<std::mutex> lock(registry_mutex);
+    std::shared_ptr<RawDataStream>& stream = registry[node->getAUUID()];
+    if (!stream || stream->node_.lock() != node) {
+        // the node might have been replaced by a new one with the same id
+        stream.reset(new RawDataStream(node));
+
+        // messages can still be emitted while the stream is released, so the slot must not outlive it
+        std::weak_ptr<RawDataStream> weak_stream = stream;
+        stream->observe(node->raw_data_connection, [weak_stream](StreamableConstPtr data) {
+            if (std::shared_ptr<RawDataStream> stream = weak_stream.lock()) {
+                stream->publish(data);
+            }
+        });
+    }
+    stream->addClient(session, options);
+}
+
+void RawDataStream::removeClient(const NodeHandlePtr& node, Session* session)
+{
+    release(node->getAUUID(), session);
+}
+
+void RawDataStream::release(const AUUID& uuid, Session* session)
+{
+    std::unique_lock<std::mutex> lock(registry_mutex);
+    auto pos = registry.find(uuid);
+    if (pos != registry.end()) {
+        if (!pos->second->removeClient(session)) {
+            registry.erase(pos);
+        }
+    }
+}
+
+void RawDataStream::setPreviewEncoder(PreviewEncoder encoder)
+{
+    std::unique_lock<std::mutex> lock(encoder_mutex);
+    preview_encoder = encoder;
+}
+
+RawDataStream::RawDataStream(const NodeHandlePtr& node) : node_(node), uuid_(node->getAUUID()), stream_key_("raw:" + uuid_.getFullName())
+{
+}
+
+RawDataStream::~RawDataStream()
+{
+    stopObserving();
+}
+
+void RawDataStream::addClient(const SessionPtr& session, const ClientOptions& options)
+{
+    std::chrono::steady_clock::duration min_interval = std::chrono::steady_clock::duration::zero();
+    if (options.max_frequency > 0.0) {
+        min_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / options.max_frequency));
+    }
+
+    std::unique_lock<std::mutex> lock(clients_mutex_);
+    for (Client& client : clients_) {
+        if (client.key == session.get()) {
+            // the client only changes its options
+            client.min_interval = min_interval;
+            client.preview = options.preview;
+            return;
+        }
+    }
+
+    Client client;
+    client.key = session.get();
+    client.session = session;
+    client.min_interval = min_interval;
+    client.preview = options.preview;
+    // the stream might already be gone when the session stops, only the uuid is used
+    AUUID uuid = uuid_;
+    client.stopped = session->stopped.connect([uuid](Session* stopped_session) { release(uuid, stopped_session); });
+    clients_.push_back(std::move(client));
+}
+
+bool RawDataStream::removeClient(Session* session)
+{
+    std::unique_lock<std::mutex> lock(clients_mutex_);
+    for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+        if (it->key == session) {
+            clients_.erase(it);
+            break;
+        }
+    }
+    return !clients_.empty();
+}
+
+void RawDataStream::publish(const StreamableConstPtr& data)
+{
+    RawMessageConstPtr message = std::dynamic_pointer_cast<RawMessage const>(data);
+    if (!message) {
+        // only raw messages know which node they belong to
+        return;
+    }
+
+    std::vector<std::pair<SessionPtr, bool>> due;
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(clients_mutex_);
+        for (Client& client : clients_) {
+            if (now - client.last_sent < client.min_interval) {
+                continue;
+            }
+            if (SessionPtr session = client.session.lock()) {
+                client.last_sent = now;
+                due.emplace_back(session, client.preview);
+            }
+        }
+    }
+
+    if (due.empty()) {
+        // no client wants this message, don't serialize it at all
+        return;
+    }
+
+    std::shared_ptr<const SerializationBuffer> full;
+    std::shared_ptr<const SerializationBuffer> preview;
+    bool preview_encoded = false;
+
+    for (const auto& entry : due) {
+        const SessionPtr& session = entry.first;
+        bool wants_preview = entry.second;
+
+        if (wants_preview && !preview_encoded) {
+            preview_encoded = true;
+            PreviewEncoder encoder;
+            {
+                std::unique_lock<std::mutex> lock(encoder_mutex);
+                encoder = preview_encoder;
+            }
+            if (encoder) {
+                if (RawMessageConstPtr encoded = encoder(message)) {
+                    preview = serialize(encoded);
+                }
+            }
+        }
+
+        std::shared_ptr<const SerializationBuffer> serialized;
+        if (wants_preview && preview) {
+            serialized = preview;
+        } else {
+            // without an encoder, clients that asked for a preview get the full message
+            if (!full) {
+                full = serialize(message);
+            }
+            serialized = full;
+        }
+
+        try {
+            // a client that cannot keep up only receives the most recent frame, the node is never delayed
+            session->writeFrame(stream_key_, serialized);
+        } catch (const Session::NoConnectionException&) {
+            // the session is shutting down and will remove itself
+        }
+    }
+}
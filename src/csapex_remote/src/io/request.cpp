@@ -8,16 +8,16 @@ uint8_t Request::getPacketType() const
     return PACKET_TYPE_ID;
 }
 
-Request::Request(uint8_t id) : request_id_(id)
+Request::Request(uint32_t id) : request_id_(id)
 {
 }
 
-void Request::overwriteRequestID(uint8_t id) const
+void Request::overwriteRequestID(uint32_t id) const
 {
     request_id_ = id;
 }
 
-uint8_t Request::getRequestID() const
+uint32_t Request::getRequestID() const
 {
     return request_id_;
 }
@@ -8,11 +8,11 @@ uint8_t Response::getPacketType() const
     return PACKET_TYPE_ID;
 }
 
-Response::Response(uint8_t id) : request_id_(id)
+Response::Response(uint32_t id) : request_id_(id)
 {
 }
 
-uint8_t Response::getRequestID() const
+uint32_t Response::getRequestID() const
 {
     return request_id_;
 }
@@ -24,11 +24,53 @@
 using namespace csapex;
 using boost::asio::ip::tcp;
 
-Session::Session(Socket socket, const std::string& name) : socket_(new Socket(std::move(socket))), next_request_id_(1), running_(false), is_live_(false), was_live_(false), name_(name), is_valid_(true)
+namespace
+{
+const std::size_t DEFAULT_MAX_QUEUED_PACKETS = 1024;
+}  // namespace
+
+Session::Session(Socket socket, const std::string& name)
+  : socket_(new Socket(std::move(socket)))
+  , next_request_id_(1)
+  , max_queued_packets_(DEFAULT_MAX_QUEUED_PACKETS)
+  , write_in_flight_(false)
+  , packets_enqueued_(0)
+  , packets_dequeued_(0)
+  , max_queue_depth_(0)
+  , packets_sent_count_(0)
+  , packets_superseded_(0)
+  , packets_dropped_(0)
+  , bytes_sent_(0)
+  , bytes_per_second_(0.0)
+  , rate_window_start_(std::chrono::steady_clock::now())
+  , rate_window_bytes_(0)
+  , running_(false)
+  , is_live_(false)
+  , was_live_(false)
+  , name_(name)
+  , is_valid_(true)
 {
 }
 
-Session::Session(const std::string& name) : next_request_id_(1), running_(false), is_live_(false), was_live_(false), name_(name), is_valid_(true)
+Session::Session(const std::string& name)
+  : next_request_id_(1)
+  , max_queued_packets_(DEFAULT_MAX_QUEUED_PACKETS)
+  , write_in_flight_(false)
+  , packets_enqueued_(0)
+  , packets_dequeued_(0)
+  , max_queue_depth_(0)
+  , packets_sent_count_(0)
+  , packets_superseded_(0)
+  , packets_dropped_(0)
+  , bytes_sent_(0)
+  , bytes_per_second_(0.0)
+  , rate_window_start_(std::chrono::steady_clock::now())
+  , rate_window_bytes_(0)
+  , running_(false)
+  , is_live_(false)
+  , was_live_(false)
+  , name_(name)
+  , is_valid_(true)
 {
 }
 
@@ -81,10 +123,11 @@ void Session::start()
     }
     started(this);
 
+    // packets written right after starting are queued for the handler thread
+    is_live_ = true;
+    was_live_ = true;
     packet_handler_thread_ = std::thread([this]() {
         csapex::thread::set_name(name_.c_str());
-        is_live_ = true;
-        was_live_ = true;
 
         try {
             mainLoop();
@@ -106,20 +149,36 @@ void Session::mainLoop()
 {
     while (running_) {
         std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
-        while (running_ && (packets_received_.empty() && packets_to_send_.empty())) {
+        while (running_ && packets_received_.empty() && (packets_to_send_.empty() || write_in_flight_)) {
             packets_available_.wait_for(packet_lock, std::chrono::milliseconds(100));
         }
 
         // so as not to starve the clients, we limit the max amount of packets to send
         // before receiving other packets
         const int max_operations_per_iteration = 32;
-        for (int i = 0; i < max_operations_per_iteration && running_ && !packets_to_send_.empty(); ++i) {
-            StreamableConstPtr packet = packets_to_send_.front();
-            packets_to_send_.pop_front();
+        if (running_ && !packets_to_send_.empty() && !write_in_flight_) {
+            std::vector<OutgoingPacket> batch;
+            for (int i = 0; i < max_operations_per_iteration && !packets_to_send_.empty(); ++i) {
+                batch.push_back(std::move(packets_to_send_.front()));
+                dequeue();
+            }
+            // only one write is in flight, the next batch is taken when it has completed
+            write_in_flight_ = true;
             packet_lock.unlock();
 
-            SerializationBuffer buffer = PacketSerializer::serializePacket(packet);
-            write_packet(buffer);
+            // all packets of the batch are sent with a single gather-write
+            std::vector<std::shared_ptr<const SerializationBuffer>> buffers;
+            buffers.reserve(batch.size());
+            for (const OutgoingPacket& outgoing : batch) {
+                if (outgoing.serialized) {
+                    buffers.push_back(outgoing.serialized);
+                } else {
+                    std::shared_ptr<SerializationBuffer> buffer = std::make_shared<SerializationBuffer>(PacketSerializer::serializePacket(outgoing.packet));
+                    buffer->finalize();
+                    buffers.push_back(buffer);
+                }
+            }
+            write_async(buffers);
 
             packet_lock.lock();
         }
@@ -182,9 +241,9 @@ void Session::stop()
 
     std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
     for (auto pair : open_requests_) {
-        std::promise<ResponseConstPtr>* open_requests = pair.second;
-        open_requests->set_value(nullptr);
+        pair.second->set_value(nullptr);
     }
+    open_requests_.clear();
 
     running_lock.unlock();
 
@@ -203,37 +262,64 @@ void Session::stopForced()
     }
 }
 
+uint32_t Session::generateRequestID()
+{
+    // 0 is reserved for packets that do not belong to a request
+    uint32_t id = next_request_id_++;
+    while (id == 0) {
+        id = next_request_id_++;
+    }
+    return id;
+}
+
 ResponseConstPtr Session::sendRequest(RequestConstPtr request)
 {
     if (is_live_) {
-        request->overwriteRequestID(next_request_id_++);
+        std::future<ResponseConstPtr> future = sendRequestAsync(request);
 
-        std::promise<ResponseConstPtr> promise;
+        if (ResponseConstPtr response = future.get()) {
+            return response;
+        }
+        apex_fail(std::string("The request ") + std::to_string(request->getRequestID()) + " failed to produce a response");
 
-        {
-            std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
-            open_requests_[request->getRequestID()] = &promise;
+    } else {
+        if (was_live_) {
+            throw NoConnectionException();
         }
+    }
 
-        write(request);
+    return nullptr;
+}
 
-        std::future<ResponseConstPtr> future = promise.get_future();
+std::future<ResponseConstPtr> Session::sendRequestAsync(RequestConstPtr request)
+{
+    std::shared_ptr<std::promise<ResponseConstPtr>> promise = std::make_shared<std::promise<ResponseConstPtr>>();
+    std::future<ResponseConstPtr> future = promise->get_future();
 
-        future.wait();
+    if (is_live_) {
+        request->overwriteRequestID(generateRequestID());
 
-        if (ResponseConstPtr response = future.get()) {
-            apex_assert_hard(response);
-            return response;
+        {
+            std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
+            open_requests_[request->getRequestID()] = promise;
+        }
+
+        try {
+            write(request);
+        } catch (const NoConnectionException&) {
+            std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
+            open_requests_.erase(request->getRequestID());
+            throw;
         }
-        apex_fail(std::string("The request ") + std::to_string(request->getRequestID()) + " failed to produce a response");
 
     } else {
         if (was_live_) {
             throw NoConnectionException();
         }
+        promise->set_value(nullptr);
     }
 
-    return nullptr;
+    return future;
 }
 
 void Session::sendNote(io::NoteConstPtr note)
@@ -249,14 +335,18 @@ void Session::sendNote(io::NoteConstPtr note)
 void Session::write(const StreamableConstPtr& packet)
 {
     if (is_live_) {
+        OutgoingPacket outgoing{ packet, nullptr, std::string() };
+        WritePolicy policy = WritePolicy::RELIABLE;
+        if (io::NoteConstPtr note = std::dynamic_pointer_cast<io::Note const>(packet)) {
+            outgoing.key = note->getSupersedeKey();
+            policy = outgoing.key.empty() ? WritePolicy::DROPPABLE : WritePolicy::LATEST_STATE;
+        } else if (packet->getPacketType() == BroadcastMessage::PACKET_TYPE_ID) {
+            policy = WritePolicy::DROPPABLE;
+        }
+
         {
-            if (packet_handler_thread_.get_id() != std::this_thread::get_id()) {
-                std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
-                packets_to_send_.push_back(packet);
-            } else {
-                SerializationBuffer buffer = PacketSerializer::serializePacket(packet);
-                write_packet(buffer);
-            }
+            std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+            enqueue(std::move(outgoing), policy);
         }
 
         packets_available_.notify_all();
@@ -273,6 +363,97 @@ void Session::write(const std::string& message)
     write(std::make_shared<Feedback>(message));
 }
 
+void Session::write(const std::shared_ptr<const SerializationBuffer>& serialized)
+{
+    if (is_live_) {
+        {
+            std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+            enqueue(OutgoingPacket{ nullptr, serialized, std::string() }, WritePolicy::RELIABLE);
+        }
+
+        packets_available_.notify_all();
+
+    } else {
+        if (was_live_) {
+            throw NoConnectionException();
+        }
+    }
+}
+
+void Session::writeFrame(const std::string& stream, const std::shared_ptr<const SerializationBuffer>& serialized)
+{
+    if (is_live_) {
+        {
+            std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+            enqueue(OutgoingPacket{ nullptr, serialized, stream }, WritePolicy::DROPPABLE);
+        }
+
+        packets_available_.notify_all();
+
+    } else {
+        if (was_live_) {
+            throw NoConnectionException();
+        }
+    }
+}
+
+void Session::enqueue(OutgoingPacket&& outgoing, WritePolicy policy)
+{
+    if (!outgoing.key.empty()) {
+        auto pos = queued_keys_.find(outgoing.key);
+        if (pos != queued_keys_.end()) {
+            // the newer packet takes the place of the obsolete one
+            packets_to_send_[pos->second - packets_dequeued_] = std::move(outgoing);
+            ++packets_superseded_;
+            return;
+        }
+    }
+
+    if (policy == WritePolicy::DROPPABLE && packets_to_send_.size() >= max_queued_packets_) {
+        ++packets_dropped_;
+        return;
+    }
+
+    if (!outgoing.key.empty()) {
+        queued_keys_[outgoing.key] = packets_enqueued_;
+    }
+    packets_to_send_.push_back(std::move(outgoing));
+    ++packets_enqueued_;
+    max_queue_depth_ = std::max(max_queue_depth_, packets_to_send_.size());
+}
+
+void Session::dequeue()
+{
+    const std::string& key = packets_to_send_.front().key;
+    if (!key.empty()) {
+        queued_keys_.erase(key);
+    }
+    packets_to_send_.pop_front();
+    ++packets_dequeued_;
+}
+
+void Session::setMaxQueuedPackets(std::size_t max)
+{
+    std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+    max_queued_packets_ = max;
+}
+
+Session::WriteStatistics Session::getWriteStatistics() const
+{
+    WriteStatistics statistics;
+    {
+        std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+        statistics.queue_depth = packets_to_send_.size();
+        statistics.max_queue_depth = max_queue_depth_;
+    }
+    statistics.packets_sent = packets_sent_count_;
+    statistics.packets_superseded = packets_superseded_;
+    statistics.packets_dropped = packets_dropped_;
+    statistics.bytes_sent = bytes_sent_;
+    statistics.bytes_per_second = bytes_per_second_;
+    return statistics;
+}
+
 void Session::read_async()
 {
     {
@@ -318,8 +499,7 @@ void Session::read_async()
                                     std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
                                     auto it = open_requests_.find(feedback->getRequestID());
                                     if (it != open_requests_.end()) {
-                                        std::promise<ResponseConstPtr>* promise = it->second;
-                                        promise->set_value(feedback);
+                                        it->second->set_value(feedback);
                                         open_requests_.erase(it);
 
                                     } else {
@@ -333,9 +513,7 @@ void Session::read_async()
                                 std::unique_lock<std::recursive_mutex> lock(open_requests_mutex_);
                                 auto it = open_requests_.find(response->getRequestID());
                                 if (it != open_requests_.end()) {
-                                    std::promise<ResponseConstPtr>* promise = it->second;
-                                    apex_assert_hard(response);
-                                    promise->set_value(response);
+                                    it->second->set_value(response);
                                     open_requests_.erase(it);
 
                                 } else {
@@ -364,27 +542,58 @@ void Session::read_async()
         });
 }
 
-void Session::write_packet(SerializationBuffer& buffer)
+void Session::write_async(const std::vector<std::shared_ptr<const SerializationBuffer>>& buffers)
 {
-    try {
-        buffer.finalize();
+    std::vector<boost::asio::const_buffer> gather;
+    gather.reserve(buffers.size());
+    std::size_t bytes = 0;
+    for (const std::shared_ptr<const SerializationBuffer>& buffer : buffers) {
+        gather.push_back(boost::asio::buffer(*buffer, buffer->size()));
+        bytes += buffer->size();
+    }
 
-        apex_assert_hard(socket_->is_open());
-        // std::cerr << (long) this << " is sending:\n" << buffer.toString() << std::endl;
+    // the buffers are kept alive by the handler until the write has completed
+    SessionWeakPtr self = shared_from_this();
+    boost::asio::async_write(*socket_, gather, [this, self, buffers, bytes](boost::system::error_code ec, std::size_t written_bytes) {
+        SessionPtr session = self.lock();
+        if (!session) {
+            return;
+        }
 
-        std::size_t written_bytes = boost::asio::write(*socket_, boost::asio::buffer(buffer, buffer.size()));
+        if (ec) {
+            if (ec != boost::asio::error::operation_aborted) {
+                std::cerr << "the session cannot write: " << ec.message() << std::endl;
+                if (running_) {
+                    stop();
+                }
+            }
+            return;
+        }
 
-        apex_assert_eq_hard(buffer.size(), written_bytes);
+        apex_assert_eq_hard(bytes, written_bytes);
+        writeCompleted(buffers.size(), bytes);
+    });
+}
 
-        // std::cerr << (long) this << " has sent " << written_bytes << " bytes" << std::endl;
+void Session::writeCompleted(std::size_t packets, std::size_t bytes)
+{
+    packets_sent_count_ += packets;
+    bytes_sent_ += bytes;
+
+    rate_window_bytes_ += bytes;
+    auto now = std::chrono::steady_clock::now();
+    auto window = std::chrono::duration_cast<std::chrono::duration<double>>(now - rate_window_start_);
+    if (window.count() >= 1.0) {
+        bytes_per_second_ = rate_window_bytes_ / window.count();
+        rate_window_bytes_ = 0;
+        rate_window_start_ = now;
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "the session has thrown an exception: " << e.what() << std::endl;
-        stopForced();
-    } catch (...) {
-        std::cerr << "the session has crashed with an unknown cause." << std::endl;
-        stopForced();
+    {
+        std::unique_lock<std::recursive_mutex> packet_lock(packets_mutex_);
+        write_in_flight_ = false;
     }
+    packets_available_.notify_all();
 }
 
 void Session::handleFeedback(const ResponseConstPtr& res)
@@ -12,6 +12,7 @@
 #include <csapex/model/node_facade_impl.h>
 #include <csapex/io/protcol/graph_notes.h>
 #include <csapex/io/protcol/graph_requests.h>
+#include <csapex/io/protcol/request_node_snapshots.h>
 #include <csapex/io/session.h>
 #include <csapex/io/channel.h>
 #include <csapex/utility/slim_signal_invoker.hpp>
@@ -87,9 +88,11 @@ GraphProxy::~GraphProxy()
 
 void GraphProxy::reload()
 {
-    auto nodes = graph_channel_->request<std::vector<UUID>, GraphRequests>(GraphRequests::GraphRequestType::GetAllNodes);
-    for (const UUID& id : nodes) {
-        vertexAdded(id);
+    // all nodes are fetched in one round-trip instead of several requests per node
+    auto snapshots = graph_channel_->getSession().sendRequest<RequestNodeSnapshots>(graph_channel_->getName());
+    apex_assert_hard(snapshots);
+    for (const NodeSnapshot& snapshot : snapshots->getSnapshots()) {
+        vertexAdded(snapshot.uuid, &snapshot);
     }
     auto connections = graph_channel_->request<std::vector<ConnectionDescription>, GraphRequests>(GraphRequests::GraphRequestType::GetAllConnections);
     for (const ConnectionDescription& ci : connections) {
@@ -97,10 +100,10 @@ void GraphProxy::reload()
     }
 }
 
-void GraphProxy::vertexAdded(const UUID& id)
+void GraphProxy::vertexAdded(const UUID& id, const NodeSnapshot* snapshot)
 {
     AUUID auuid(makeUUID_forced(shared_from_this(), id.getFullName()).getAbsoluteUUID());
-    std::shared_ptr<NodeFacadeProxy> remote_node_facade = std::make_shared<NodeFacadeProxy>(graph_channel_->getSession().shared_from_this(), auuid);
+    std::shared_ptr<NodeFacadeProxy> remote_node_facade = std::make_shared<NodeFacadeProxy>(graph_channel_->getSession().shared_from_this(), auuid, snapshot);
 
     graph::VertexPtr remote_vertex = std::make_shared<graph::Vertex>(remote_node_facade);
     remote_vertices_.push_back(remote_vertex);
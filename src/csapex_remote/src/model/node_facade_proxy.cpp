@@ -8,6 +8,7 @@
 #include <csapex/io/protcol/node_notes.h>
 #include <csapex/io/protcol/node_requests.h>
 #include <csapex/io/protcol/parameter_changed.h>
+#include <csapex/io/protcol/request_node_snapshots.h>
 #include <csapex/io/protcol/request_parameter.h>
 #include <csapex/io/raw_message.h>
 #include <csapex/io/session.h>
@@ -23,7 +24,7 @@
 
 using namespace csapex;
 
-NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
+NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid, const NodeSnapshot* snapshot)
   : Proxy(session)
   , uuid_(uuid)
   ,
@@ -42,12 +43,18 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
    **/
 
   guard_(-1)
+  , raw_data_max_frequency_(0.0)
+  , raw_data_preview_(false)
 {
     node_channel_ = session->openChannel(uuid.getAbsoluteUUID());
 
     profiler_proxy_ = std::make_shared<ProfilerProxy>(node_channel_);
 
-    state_proxy_ = node_channel_->request<NodeStatePtr, NodeRequests>(NodeRequests::NodeRequestType::GetNodeState);
+    if (snapshot) {
+        state_proxy_ = snapshot->state;
+    } else {
+        state_proxy_ = node_channel_->request<NodeStatePtr, NodeRequests>(NodeRequests::NodeRequestType::GetNodeState);
+    }
 
     observe(node_channel_->note_received, [this](const io::NoteConstPtr& note) {
         if (const std::shared_ptr<NodeNote const>& cn = std::dynamic_pointer_cast<NodeNote const>(note)) {
@@ -162,12 +169,27 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
         }
     });
 
-    auto params = node_channel_->request<std::vector<param::ParameterPtr>, NodeRequests>(NodeRequests::NodeRequestType::GetParameters);
+    std::vector<param::ParameterPtr> params = snapshot ? snapshot->parameters : node_channel_->request<std::vector<param::ParameterPtr>, NodeRequests>(NodeRequests::NodeRequestType::GetParameters);
     for (param::ParameterPtr& p : params) {
         createParameterProxy(p);
         parameter_added(p);
     }
 
+    if (snapshot) {
+        // fill the caches, so that the connectors are known without a request
+        value_getExternalInputs_ = snapshot->external_inputs;
+        value_getExternalOutputs_ = snapshot->external_outputs;
+        value_getExternalEvents_ = snapshot->external_events;
+        value_getExternalSlots_ = snapshot->external_slots;
+        value_getInternalInputs_ = snapshot->internal_inputs;
+        value_getInternalOutputs_ = snapshot->internal_outputs;
+        value_getInternalEvents_ = snapshot->internal_events;
+        value_getInternalSlots_ = snapshot->internal_slots;
+
+        has_getExternalInputs_ = has_getExternalOutputs_ = has_getExternalEvents_ = has_getExternalSlots_ = true;
+        has_getInternalInputs_ = has_getInternalOutputs_ = has_getInternalEvents_ = has_getInternalSlots_ = true;
+    }
+
     for (const ConnectorDescription& c : getExternalConnectors()) {
         createConnectorProxy(c);
     }
@@ -175,7 +197,7 @@ NodeFacadeProxy::NodeFacadeProxy(const SessionPtr& session, AUUID uuid)
         createConnectorProxy(c);
     }
 
-    observe(raw_data_connection.first_connected, [this]() { node_channel_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::AddClient); });
+    observe(raw_data_connection.first_connected, [this]() { requestRawData(); });
 
     observe(raw_data_connection.last_disconnected, [this]() { node_channel_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::RemoveClient); });
 
@@ -300,6 +322,22 @@ param::ParameterPtr NodeFacadeProxy::getParameter(const std::string& name) const
     return parameter_cache_.at(name);
 }
 
+void NodeFacadeProxy::setRawDataOptions(double max_frequency, bool preview)
+{
+    raw_data_max_frequency_ = max_frequency;
+    raw_data_preview_ = preview;
+
+    if (raw_data_connection.isConnected()) {
+        // the server updates the options of an existing client
+        requestRawData();
+    }
+}
+
+void NodeFacadeProxy::requestRawData()
+{
+    node_channel_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::AddClient, raw_data_max_frequency_.load(), raw_data_preview_.load());
+}
+
 void NodeFacadeProxy::setProfiling(bool profiling)
 {
     node_channel_->sendRequest<NodeRequests>(NodeRequests::NodeRequestType::SetProfiling, profiling);
@@ -378,3 +416,34 @@ void NodeFacadeProxy::createParameterProxy(param::ParameterPtr proxy) const
 /**
  * end: generate getters
  **/
+
+/**
+ * begin: generate asynchronous getters
+ **/
+#define HANDLE_ACCESSOR(_enum, type, function)                                                                                                                                                         \
+    std::future<type> NodeFacadeProxy::function##Async() const                                                                                                                                         \
+    {                                                                                                                                                                                                  \
+        return requestAsync<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                    \
+    }
+#define HANDLE_STATIC_ACCESSOR(_enum, type, function)                                                                                                                                                  \
+    std::future<type> NodeFacadeProxy::function##Async() const                                                                                                                                         \
+    {                                                                                                                                                                                                  \
+        if (has_##function##_) {                                                                                                                                                                       \
+            return makeReadyFuture(cache_##function##_);                                                                                                                                               \
+        }                                                                                                                                                                                              \
+        return requestAsync<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                    \
+    }
+#define HANDLE_DYNAMIC_ACCESSOR(_enum, signal, type, function)                                                                                                                                         \
+    std::future<type> NodeFacadeProxy::function##Async() const                                                                                                                                         \
+    {                                                                                                                                                                                                  \
+        if (has_##function##_) {                                                                                                                                                                       \
+            return makeReadyFuture(value_##function##_);                                                                                                                                               \
+        }                                                                                                                                                                                              \
+        return requestAsync<type, NodeRequests>(NodeRequests::NodeRequestType::_enum, getUUID().getAbsoluteUUID());                                                                                    \
+    }
+#define HANDLE_SIGNAL(_enum, signal)
+
+#include <csapex/model/node_facade_proxy_accessors.hpp>
+/**
+ * end: generate asynchronous getters
+ **/
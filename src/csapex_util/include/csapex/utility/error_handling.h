@@ -18,6 +18,7 @@ namespace error_handling
 CSAPEX_UTILS_EXPORT void init();
 
 CSAPEX_UTILS_EXPORT void siginthandler(int);
+CSAPEX_UTILS_EXPORT void sighuphandler(int);
 CSAPEX_UTILS_EXPORT void sigtraphandler(int);
 #if WIN32
 CSAPEX_UTILS_EXPORT LONG WINAPI sigsegvhandler(EXCEPTION_POINTERS* ExceptionInfo);
@@ -33,6 +34,13 @@ inline slim_signal::Signal<void()>& stop_request()
     return s;
 }
 
+/// emitted on SIGHUP, to apply the changes of the configuration file without restarting
+inline slim_signal::Signal<void()>& reload_request()
+{
+    static slim_signal::Signal<void()> s;
+    return s;
+}
+
 }  // namespace error_handling
 }  // namespace csapex
 
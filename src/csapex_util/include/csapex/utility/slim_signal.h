@@ -13,6 +13,7 @@
 #include <mutex>
 #include <type_traits>
 #include <atomic>
+#include <memory>
 
 namespace csapex
 {
@@ -117,6 +118,11 @@ public:
 
 /**
  * @brief The Signal template is the class implementing a signal for a specific function type
+ *
+ * The connected slots are copied on write: every modification publishes a new immutable snapshot
+ * of the slot lists. Emitting only pins the current snapshot, so it takes no lock and does not allocate.
+ * Replaced snapshots are freed once no emission is running anymore.
+ * Slots that are connected or disconnected during an emission take effect with the next emission.
  */
 template <typename Signature>
 class Signal : public SignalBase
@@ -190,7 +196,11 @@ private:
     void removeDelegate(int id);
     void removeFunction(int id);
 
-    void applyModifications();
+    /// publishes a snapshot of the current slots, must be called with mutex_ held
+    void publish();
+    /// frees the replaced snapshots if no emission can still use them, must be called with mutex_ held
+    void freeRetiredSlots();
+    void finishEmission();
 
 private:
     Connection::Deleter makeFunctionDeleter(Signal<Signature>* parent, int id);
@@ -198,23 +208,26 @@ private:
     Connection::Deleter makeSignalDeleter(Signal<Signature>* parent, Signal<Signature>* sig);
 
 private:
-    mutable std::recursive_mutex execution_mutex_;
+    struct Slots
+    {
+        std::vector<Signal<Signature>*> children;
+        std::vector<delegate::Delegate<Signature>> delegates;
+        std::vector<std::function<Signature>> functions;
+    };
 
-    std::atomic<bool> dirty_;
+    // slots_ points to current_, emissions read it without the lock
+    std::atomic<const Slots*> slots_;
+    std::unique_ptr<const Slots> current_;
+    std::vector<std::unique_ptr<const Slots>> retired_;
+    std::atomic<int> emissions_;
 
     int next_del_id_ = 0;
     std::map<int, delegate::Delegate<Signature>> delegates_;
-    std::map<int, delegate::Delegate<Signature>> delegates_to_add_;
-    std::vector<int> delegates_to_remove_;
 
     int next_fn_id_ = 0;
     std::map<int, std::function<Signature>> functions_;
-    std::map<int, std::function<Signature>> functions_to_add_;
-    std::vector<int> functions_to_remove_;
 
     std::vector<Signal<Signature>*> children_;
-    std::vector<Signal<Signature>*> children_to_add_;
-    std::vector<Signal<Signature>*> children_to_remove_;
 
     std::vector<Signal<Signature>*> parents_;
 };
@@ -15,7 +15,7 @@ namespace csapex
 namespace slim_signal
 {
 template <typename Signature>
-Signal<Signature>::Signal() : dirty_(false)
+Signal<Signature>::Signal() : slots_(nullptr), emissions_(0)
 {
     children_.reserve(4);
 }
@@ -34,47 +34,34 @@ Connection Signal<Signature>::connect(const delegate::Delegate<Signature>& deleg
 {
     apex_assert_hard(guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    int id;
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_del_id_++;
+        id = next_del_id_++;
         delegates_.emplace(id, delegate);
-        execution_mutex_.unlock();
-
-        onConnect();
+        publish();
+    }
 
-        return Connection(this, makeDelegateDeleter(this, id));
+    onConnect();
 
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_del_id_++;
-        delegates_to_add_.emplace(id, delegate);
-        dirty_ = true;
-
-        return Connection(this, makeDelegateDeleter(this, id));
-    }
+    return Connection(this, makeDelegateDeleter(this, id));
 }
 template <typename Signature>
 Connection Signal<Signature>::connect(delegate::Delegate<Signature>&& delegate)
 {
     apex_assert_hard(guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    int id;
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_del_id_++;
+        id = next_del_id_++;
         delegates_.emplace(id, std::move(delegate));
-        execution_mutex_.unlock();
-
-        onConnect();
+        publish();
+    }
 
-        return Connection(this, makeDelegateDeleter(this, id));
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_del_id_++;
-        delegates_to_add_.emplace(id, std::move(delegate));
-        dirty_ = true;
+    onConnect();
 
-        return Connection(this, makeDelegateDeleter(this, id));
-    }
+    return Connection(this, makeDelegateDeleter(this, id));
 }
 
 template <typename Signature>
@@ -82,23 +69,17 @@ Connection Signal<Signature>::connect(const std::function<Signature>& fn)
 {
     apex_assert_hard(guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    int id;
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_fn_id_++;
+        id = next_fn_id_++;
         functions_.emplace(id, fn);
-        execution_mutex_.unlock();
-
-        onConnect();
+        publish();
+    }
 
-        return Connection(this, makeFunctionDeleter(this, id));
+    onConnect();
 
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        int id = next_fn_id_++;
-        functions_to_add_.emplace(id, fn);
-        dirty_ = true;
-        return Connection(this, makeFunctionDeleter(this, id));
-    }
+    return Connection(this, makeFunctionDeleter(this, id));
 }
 
 template <typename Signature>
@@ -115,16 +96,17 @@ Connection Signal<Signature>::connect(Signal<Signature>& signal)
 template <typename Signature>
 bool Signal<Signature>::isConnected() const
 {
-    if (SignalBase::isConnected()) {
+    if (slots_.load(std::memory_order_acquire)) {
         return true;
     }
 
-    return countAllConnections() > 0;
+    return SignalBase::isConnected();
 }
 
 template <typename Signature>
 int Signal<Signature>::countAllConnections() const
 {
+    std::unique_lock<std::recursive_mutex> lock(mutex_);
     return functions_.size() + delegates_.size() + children_.size();
 }
 
@@ -155,18 +137,13 @@ void Signal<Signature>::removeDelegate(int id)
 {
     apex_assert_hard(guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
         delegates_.erase(id);
-        execution_mutex_.unlock();
-
-        onDisconnect();
-
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        delegates_to_remove_.push_back(id);
-        dirty_ = true;
+        publish();
     }
+
+    onDisconnect();
 }
 
 template <typename Signature>
@@ -174,18 +151,13 @@ void Signal<Signature>::removeFunction(int id)
 {
     apex_assert_hard(guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
         functions_.erase(id);
-        execution_mutex_.unlock();
-
-        onDisconnect();
-
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        functions_to_remove_.push_back(id);
-        dirty_ = true;
+        publish();
     }
+
+    onDisconnect();
 }
 
 template <typename Signature>
@@ -206,26 +178,15 @@ void Signal<Signature>::clear()
         removeParent(parents_.front());
     }
 
-    if (execution_mutex_.try_lock()) {
-        while (!children_to_remove_.empty()) {
-            removeChild(children_to_remove_.front());
-        }
-        while (!children_.empty()) {
-            removeChild(children_.front());
-        }
-        execution_mutex_.unlock();
-
-    } else {
-        children_to_remove_.clear();
-        children_.clear();
+    while (!children_.empty()) {
+        removeChild(children_.front());
     }
 
     onDisconnect();
 
     functions_.clear();
-    functions_to_remove_.clear();
 
-    dirty_ = false;
+    publish();
 }
 
 template <typename Signature>
@@ -234,19 +195,14 @@ void Signal<Signature>::addChild(Signal* child)
     apex_assert_hard(guard_ == -1);
     apex_assert_hard(child->guard_ == -1);
 
-    if (execution_mutex_.try_lock()) {
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
         children_.push_back(child);
         child->parents_.push_back(this);
-        execution_mutex_.unlock();
-
-        onConnect();
-
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        children_to_add_.push_back(child);
-        dirty_ = true;
+        publish();
     }
+
+    onConnect();
 }
 template <typename Signature>
 void Signal<Signature>::removeChild(Signal<Signature>* child)
@@ -254,7 +210,7 @@ void Signal<Signature>::removeChild(Signal<Signature>* child)
     apex_assert_hard(guard_ == -1);
     apex_assert_hard(child != nullptr);
 
-    if (execution_mutex_.try_lock()) {
+    {
         std::unique_lock<std::recursive_mutex> lock(mutex_);
         for (auto it = children_.begin(); it != children_.end();) {
             Signal<Signature>* child_it = *it;
@@ -276,15 +232,58 @@ void Signal<Signature>::removeChild(Signal<Signature>* child)
                 ++it;
             }
         }
+        publish();
+    }
+
+    onDisconnect();
+}
+
+template <typename Signature>
+void Signal<Signature>::publish()
+{
+    std::unique_ptr<Slots> slots;
+    if (!children_.empty() || !delegates_.empty() || !functions_.empty()) {
+        slots.reset(new Slots);
+        slots->children = children_;
+        slots->delegates.reserve(delegates_.size());
+        for (const auto& entry : delegates_) {
+            slots->delegates.push_back(entry.second);
+        }
+        slots->functions.reserve(functions_.size());
+        for (const auto& entry : functions_) {
+            slots->functions.push_back(entry.second);
+        }
+    }
 
-        execution_mutex_.unlock();
+    slots_.store(slots.get(), std::memory_order_seq_cst);
 
-        onDisconnect();
+    // a running emission might still use the previous snapshot
+    if (current_) {
+        retired_.push_back(std::move(current_));
+    }
+    current_ = std::move(slots);
 
-    } else {
-        std::unique_lock<std::recursive_mutex> lock(mutex_);
-        children_to_remove_.push_back(child);
-        dirty_ = true;
+    freeRetiredSlots();
+}
+
+template <typename Signature>
+void Signal<Signature>::freeRetiredSlots()
+{
+    // an emission that starts from now on only sees the current snapshot
+    if (!retired_.empty() && emissions_.load(std::memory_order_seq_cst) == 0) {
+        retired_.clear();
+    }
+}
+
+template <typename Signature>
+void Signal<Signature>::finishEmission()
+{
+    if (emissions_.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+        // the last emission cleans up, unless the slots are being modified right now
+        std::unique_lock<std::recursive_mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            freeRetiredSlots();
+        }
     }
 }
 
@@ -292,13 +291,28 @@ template <typename Signature>
 template <typename... Args>
 Signal<Signature>& Signal<Signature>::operator()(Args&&... args)
 {
-    std::lock(execution_mutex_, mutex_);
+    if (!slots_.load(std::memory_order_acquire)) {
+        return *this;
+    }
 
-    std::unique_lock<std::recursive_mutex> exec_lock(execution_mutex_, std::adopt_lock);
+    // the snapshot stays alive until the emission is done, even if slots are disconnected meanwhile
+    struct EmissionGuard
+    {
+        Signal<Signature>* signal;
+        ~EmissionGuard()
+        {
+            signal->finishEmission();
+        }
+    };
+    emissions_.fetch_add(1, std::memory_order_seq_cst);
+    EmissionGuard guard{ this };
 
-    std::unique_lock<std::recursive_mutex> data_lock(mutex_, std::adopt_lock);
+    const Slots* slots = slots_.load(std::memory_order_seq_cst);
+    if (!slots) {
+        return *this;
+    }
 
-    for (auto& s : children_) {
+    for (Signal<Signature>* s : slots->children) {
         try {
             (*s)(std::forward<Args>(args)...);
         } catch (const std::exception& e) {
@@ -311,9 +325,9 @@ Signal<Signature>& Signal<Signature>::operator()(Args&&... args)
             throw;
         }
     }
-    for (auto& callback : delegates_) {
+    for (const auto& callback : slots->delegates) {
         try {
-            callback.second(std::forward<Args>(args)...);
+            callback(std::forward<Args>(args)...);
         } catch (const std::exception& e) {
             printf("signal processing delegate has thrown an error: %s\n", e.what());
         } catch (const csapex::Failure& e) {
@@ -324,9 +338,9 @@ Signal<Signature>& Signal<Signature>::operator()(Args&&... args)
             throw;
         }
     }
-    for (auto& fn : functions_) {
+    for (const auto& fn : slots->functions) {
         try {
-            fn.second(std::forward<Args>(args)...);
+            fn(std::forward<Args>(args)...);
         } catch (const std::exception& e) {
             printf("signal processing function has thrown an error: %s\n", e.what());
         } catch (const csapex::Failure& e) {
@@ -338,101 +352,9 @@ Signal<Signature>& Signal<Signature>::operator()(Args&&... args)
         }
     }
 
-    data_lock.unlock();
-
-    applyModifications();
-
     return *this;
 }
 
-template <typename Signature>
-void Signal<Signature>::applyModifications()
-{
-    if (!dirty_) {
-        return;
-    }
-
-    std::unique_lock<std::recursive_mutex> lock(mutex_);
-
-    // SIGNALS
-    if (!children_to_add_.empty()) {
-        for (auto& s : children_to_add_) {
-            children_.push_back(s);
-            s->parents_.push_back(this);
-
-            lock.unlock();
-            onConnect();
-            lock.lock();
-        }
-        children_to_add_.clear();
-    }
-
-    if (!children_to_remove_.empty()) {
-        for (auto& child : children_to_remove_) {
-            for (auto it = children_.begin(); it != children_.end();) {
-                if (*it == child) {
-                    it = children_.erase(it);
-
-                    lock.unlock();
-                    onDisconnect();
-                    lock.lock();
-                } else {
-                    ++it;
-                }
-            }
-        }
-        children_to_remove_.clear();
-    }
-
-    // FUNCTIONS
-    if (!functions_to_add_.empty()) {
-        for (auto& s : functions_to_add_) {
-            functions_[s.first] = std::move(s.second);
-
-            lock.unlock();
-            onConnect();
-            lock.lock();
-        }
-        functions_to_add_.clear();
-    }
-
-    if (!functions_to_remove_.empty()) {
-        for (int id : functions_to_remove_) {
-            functions_.erase(id);
-
-            lock.unlock();
-            onDisconnect();
-            lock.lock();
-        }
-        functions_to_remove_.clear();
-    }
-
-    // DELEGATES
-    if (!delegates_to_add_.empty()) {
-        for (auto& s : delegates_to_add_) {
-            delegates_.emplace(s);
-
-            lock.unlock();
-            onConnect();
-            lock.lock();
-        }
-        delegates_to_add_.clear();
-    }
-
-    if (!delegates_to_remove_.empty()) {
-        for (int id : delegates_to_remove_) {
-            delegates_.erase(id);
-
-            lock.unlock();
-            onDisconnect();
-            lock.lock();
-        }
-        delegates_to_remove_.clear();
-    }
-
-    dirty_ = false;
-}
-
 /**
  * @brief Helper class
  */
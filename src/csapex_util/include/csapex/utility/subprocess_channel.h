@@ -4,6 +4,9 @@
 /// SYSTEM
 #include <mutex>
 #include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
 #include <boost/interprocess/interprocess_fwd.hpp>
 
 /// FORWARD DECLARATIONS
@@ -76,17 +79,43 @@ public:
     ~SubprocessChannel();
 
     Message read();
+    /**
+     * @brief write passes a message to the other process.
+     *        Payloads that were allocated with allocatePayload are handed over without copying,
+     *        the channel owns them afterwards and they must not be deallocated anymore.
+     */
     void write(const Message& message);
     bool hasMessage() const;
 
+    /**
+     * @brief allocatePayload reserves memory in the channel, so that a payload can be written in place
+     */
+    uint8_t* allocatePayload(std::size_t length);
+    void deallocatePayload(uint8_t* data);
+
     void shutdown();
 
 private:
     void allocate();
 
+    void createDataSegment(std::size_t size);
+    void openDataSegment(uint64_t id);
+    void releaseRetiredSegments();
+    std::string getDataSegmentName(uint64_t id) const;
+
 private:
     std::shared_ptr<boost::interprocess::managed_shared_memory> shm_segment;
 
+    // payloads are allocated in a data segment, a larger one replaces it once a payload does not fit anymore
+    std::shared_ptr<boost::interprocess::managed_shared_memory> data_segment_;
+    uint64_t data_segment_id_;
+    std::size_t data_segment_size_;
+    std::vector<std::pair<uint64_t, std::shared_ptr<boost::interprocess::managed_shared_memory>>> retired_segments_;
+
+    // the data segment that the last message was read from
+    std::shared_ptr<boost::interprocess::managed_shared_memory> read_segment_;
+    uint64_t read_segment_id_;
+
     mutable std::recursive_mutex channel_mutex_;
 
     std::string name_space_;
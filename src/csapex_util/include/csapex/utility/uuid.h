@@ -5,6 +5,7 @@
 #include <csapex_util_export.h>
 
 /// SYSTEM
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -24,6 +25,10 @@ class AUUID;
  *  - ID[0]    - the unique id of this instance
  *  - ID[1]    - the unique id of the parent id
  *  - ...
+ *
+ * The identifiers are interned in a global symbol table, a UUID only stores their symbols.
+ * This makes copying, comparing and hashing independent of the length of the names.
+ * A symbol is freed together with the last UUID using it.
  */
 class CSAPEX_UTILS_EXPORT UUID
 {
@@ -53,9 +58,11 @@ public:
 public:
     UUID();
     UUID(const UUID& other);
+    UUID(UUID&& other) noexcept;
     virtual ~UUID();
 
     UUID& operator=(const UUID& other);
+    UUID& operator=(UUID&& other) noexcept;
 
     void free();
 
@@ -92,14 +99,28 @@ public:
     bool hasParent() const;
     std::shared_ptr<UUIDProvider> getParent() const;
 
+    /// the number of symbols that are used by at least one UUID
+    static std::size_t countSymbols();
+
+protected:
+    typedef uint32_t Symbol;
+
+    void removeId();
+    void appendParent(const UUID& parent);
+
 private:
+    static Symbol intern(const std::string& name);
+    static void retain(const std::vector<Symbol>& symbols);
+    static void release(const std::vector<Symbol>& symbols);
+    static const std::string& getSymbolName(Symbol symbol);
+
     explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation);
-    explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<std::string>& representation);
+    explicit UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<Symbol>& representation);
     explicit UUID(std::weak_ptr<UUIDProvider> parent, const UUID& representation);
 
 protected:
     std::weak_ptr<UUIDProvider> parent_;
-    std::vector<std::string> representation_;
+    std::vector<Symbol> representation_;
 };
 
 /**
@@ -61,7 +61,7 @@ protected:
     AUUID auuid_;
 
     std::recursive_mutex hash_mutex_;
-    std::map<std::string, int> hash_;
+    std::unordered_map<UUID, int, UUID::Hasher> hash_;
 
     std::map<std::string, int> uuids_;
     std::unordered_map<UUID, std::map<std::string, int>, UUID::Hasher> sub_uuids_;
@@ -39,6 +39,8 @@ void csapex::error_handling::init()
 #ifdef WIN32
     SetUnhandledExceptionFilter(csapex::error_handling::sigsegvhandler);
 #else
+    signal(SIGHUP, csapex::error_handling::sighuphandler);
+
     struct sigaction sigact;
     memset(&sigact, '\0', sizeof(sigact));
 
@@ -78,6 +80,10 @@ void csapex::error_handling::siginthandler(int)
 {
     stop();
 }
+void csapex::error_handling::sighuphandler(int)
+{
+    reload_request()();
+}
 void csapex::error_handling::sigtraphandler(int)
 {
     std::cout << "SIGTRAP signal handled and ignored." << std::endl;
@@ -18,6 +18,9 @@ namespace detail
 {
 Subprocess* g_sp_instance = nullptr;
 
+// the initial size of the data channels, larger messages make a channel switch to a larger segment
+const int32_t DATA_CHANNEL_SIZE = 1024 * 1024;
+
 void sp_signal_handler(int signal)
 {
     if (g_sp_instance) {
@@ -28,8 +31,8 @@ void sp_signal_handler(int signal)
 }  // namespace detail
 
 Subprocess::Subprocess(const std::string& name_space)
-  : in(name_space + "_in", false, 65536)
-  , out(name_space + "_out", false, 65536)
+  : in(name_space + "_in", false, detail::DATA_CHANNEL_SIZE)
+  , out(name_space + "_out", false, detail::DATA_CHANNEL_SIZE)
   , ctrl_in(name_space + "_ctrl", true, 1024)
   , ctrl_out(name_space + "_ctrl", true, 1024)
   , pid_(-1)
@@ -6,9 +6,13 @@
 
 /// SYSTEM
 #include <iostream>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/statvfs.h>
 #include <boost/optional.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
-#include <boost/interprocess/containers/string.hpp>
 #include <boost/interprocess/sync/interprocess_mutex.hpp>
 #include <boost/interprocess/sync/interprocess_condition.hpp>
 
@@ -19,11 +23,6 @@ namespace csapex
 {
 namespace impl
 {
-template <typename T>
-using ShmAllocator = boost::interprocess::allocator<T, boost::interprocess::managed_shared_memory::segment_manager>;
-
-using shared_buffer = typename boost::interprocess::basic_string<uint8_t, std::char_traits<uint8_t>, ShmAllocator<uint8_t>>;
-
 struct ShmBlock
 {
     boost::interprocess::interprocess_mutex m;
@@ -32,6 +31,12 @@ struct ShmBlock
 
     SubprocessChannel::MessageType message_type = SubprocessChannel::MessageType::NONE;
 
+    // the payload is an anonymous allocation in a data segment, passed by segment id and handle
+    uint64_t data_segment = 0;
+    boost::interprocess::managed_shared_memory::handle_t data_handle = 0;
+    std::size_t data_length = 0;
+    bool has_data = false;
+
     bool is_full = false;
     bool active = true;
 };
@@ -40,6 +45,22 @@ struct ShmBlock
 
 }  // namespace csapex
 
+namespace
+{
+// the control segment only holds the ShmBlock
+const std::size_t CONTROL_SEGMENT_SIZE = 4096;
+// the minimal size of a data segment, the rest of it is available for payloads
+const std::size_t SEGMENT_OVERHEAD = 4096;
+
+uint64_t makeSegmentId()
+{
+    // unique across both processes, the child inherits the counter
+    static std::atomic<uint32_t> next(0);
+    return (static_cast<uint64_t>(getpid()) << 32) | ++next;
+}
+
+}  // namespace
+
 // Message
 
 SubprocessChannel::Message::Message(const SubprocessChannel::MessageType type, const std::string& str) : type(type), data(reinterpret_cast<const uint8_t*>(str.c_str())), length(str.size())
@@ -74,7 +95,10 @@ SubprocessChannel::Message::~Message()
     if (parent) {
         scoped_lock<interprocess_mutex> lock(parent->shm_block_->m);
 
-        parent->shm_segment->destroy<impl::shared_buffer>("data");
+        if (parent->shm_block_->has_data) {
+            parent->read_segment_->deallocate(parent->read_segment_->get_address_from_handle(parent->shm_block_->data_handle));
+            parent->shm_block_->has_data = false;
+        }
         parent->shm_block_->is_full = false;
         parent->is_locked_ = false;
         parent->shm_block_->message_read.notify_all();
@@ -83,13 +107,10 @@ SubprocessChannel::Message::~Message()
 
 std::string SubprocessChannel::Message::toString() const
 {
-    std::stringstream ss;
-    const uint8_t* ptr = data;
-    for (std::size_t i = 0; i < length; ++i, ++ptr) {
-        ss << *ptr;
+    if (!data) {
+        return std::string();
     }
-
-    return ss.str();
+    return std::string(reinterpret_cast<const char*>(data), length);
 }
 
 SubprocessChannel::Message::Message(SubprocessChannel* parent) : parent(parent)
@@ -99,13 +120,27 @@ SubprocessChannel::Message::Message(SubprocessChannel* parent) : parent(parent)
 // SubprocesChannel
 
 SubprocessChannel::SubprocessChannel(const std::string& name_space, bool is_control_channel, int32_t size)
-  : name_space_(std::to_string(getpid()) + "_" + name_space), size_(size), is_control_channel_(is_control_channel), is_locked_(false), is_shutdown_(false)
+  : data_segment_id_(0)
+  , data_segment_size_(0)
+  , read_segment_id_(0)
+  , name_space_(std::to_string(getpid()) + "_" + name_space)
+  , size_(size)
+  , is_control_channel_(is_control_channel)
+  , is_locked_(false)
+  , is_shutdown_(false)
 {
     allocate();
 }
 
 SubprocessChannel::~SubprocessChannel()
 {
+    // the reader unlinks a data segment as soon as it has mapped it, this only removes the ones that were never read
+    shared_memory_object::remove(getDataSegmentName(shm_block_->data_segment).c_str());
+    shared_memory_object::remove(getDataSegmentName(data_segment_id_).c_str());
+    for (const auto& retired : retired_segments_) {
+        shared_memory_object::remove(getDataSegmentName(retired.first).c_str());
+    }
+
     shared_memory_object::remove(name_space_.c_str());
 }
 
@@ -113,17 +148,105 @@ void SubprocessChannel::allocate()
 {
     try {
         //        std::cout << "try to create shared memory object " << getUUID() << std::endl;
-        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), size_));
+        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), CONTROL_SEGMENT_SIZE));
 
     } catch (const boost::interprocess::interprocess_exception& e) {
         //        std::cout << "could not create shared memory object: " << e.what() << std::endl;
         //        std::cout << "removing shared memory object " << getUUID() << std::endl;
         shared_memory_object::remove(name_space_.c_str());
-        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), size_));
+        shm_segment.reset(new managed_shared_memory(create_only, name_space_.c_str(), CONTROL_SEGMENT_SIZE));
     }
 
     // Create a managed shared memory segment
     shm_block_ = shm_segment->construct<impl::ShmBlock>("shm")();
+
+    // the first data segment is inherited by the child, so small messages never have to create a segment
+    createDataSegment(std::max<std::size_t>(size_ > 0 ? size_ : 0, SEGMENT_OVERHEAD * 2));
+    read_segment_ = data_segment_;
+    read_segment_id_ = data_segment_id_;
+}
+
+std::string SubprocessChannel::getDataSegmentName(uint64_t id) const
+{
+    return name_space_ + "_data_" + std::to_string(id);
+}
+
+void SubprocessChannel::createDataSegment(std::size_t size)
+{
+    // pages of a segment are only backed when they are touched, running out of tmpfs then raises SIGBUS
+    struct statvfs fs;
+    if (statvfs("/dev/shm", &fs) == 0 && static_cast<uint64_t>(fs.f_bavail) * fs.f_frsize < size) {
+        throw std::runtime_error(std::string("subprocess channel ") + name_space_ + " needs " + std::to_string(size) + " bytes of shared memory, but only " +
+                                 std::to_string(static_cast<uint64_t>(fs.f_bavail) * fs.f_frsize) + " bytes are available");
+    }
+
+    uint64_t id = makeSegmentId();
+    std::string name = getDataSegmentName(id);
+    shared_memory_object::remove(name.c_str());
+    data_segment_ = std::make_shared<managed_shared_memory>(create_only, name.c_str(), size);
+    data_segment_id_ = id;
+    data_segment_size_ = size;
+}
+
+void SubprocessChannel::openDataSegment(uint64_t id)
+{
+    std::string name = getDataSegmentName(id);
+    read_segment_ = std::make_shared<managed_shared_memory>(open_only, name.c_str());
+    read_segment_id_ = id;
+
+    // only the reader opens a segment by name, the writer keeps its own mapping
+    shared_memory_object::remove(name.c_str());
+}
+
+void SubprocessChannel::releaseRetiredSegments()
+{
+    // a replaced segment is unmapped once the reader has released all of its payloads
+    retired_segments_.erase(std::remove_if(retired_segments_.begin(), retired_segments_.end(),
+                                           [this](const std::pair<uint64_t, std::shared_ptr<managed_shared_memory>>& retired) {
+                                               if (!retired.second->all_memory_deallocated()) {
+                                                   return false;
+                                               }
+                                               shared_memory_object::remove(getDataSegmentName(retired.first).c_str());
+                                               return true;
+                                           }),
+                            retired_segments_.end());
+}
+
+uint8_t* SubprocessChannel::allocatePayload(std::size_t length)
+{
+    std::unique_lock<std::recursive_mutex> channel_lock(channel_mutex_);
+
+    releaseRetiredSegments();
+
+    void* payload = data_segment_->allocate(length, std::nothrow);
+    if (!payload) {
+        // a mapped segment cannot be resized, so a larger one takes over for all new payloads
+        retired_segments_.emplace_back(data_segment_id_, data_segment_);
+        createDataSegment(std::max(2 * data_segment_size_, length + length / 4 + SEGMENT_OVERHEAD));
+
+        payload = data_segment_->allocate(length, std::nothrow);
+        if (!payload) {
+            throw std::runtime_error(std::string("subprocess channel ") + name_space_ + " cannot hold a message of " + std::to_string(length) + " bytes");
+        }
+    }
+    return static_cast<uint8_t*>(payload);
+}
+
+void SubprocessChannel::deallocatePayload(uint8_t* data)
+{
+    std::unique_lock<std::recursive_mutex> channel_lock(channel_mutex_);
+
+    if (data_segment_->belongs_to_segment(data)) {
+        data_segment_->deallocate(data);
+        return;
+    }
+    for (const auto& retired : retired_segments_) {
+        if (retired.second->belongs_to_segment(data)) {
+            retired.second->deallocate(data);
+            return;
+        }
+    }
+    throw std::logic_error(std::string("subprocess channel ") + name_space_ + " does not own the payload");
 }
 
 bool SubprocessChannel::hasMessage() const
@@ -167,15 +290,17 @@ SubprocessChannel::Message SubprocessChannel::read()
         }
     }
 
-    std::pair<impl::shared_buffer*, managed_shared_memory::size_type> input = shm_segment->find<impl::shared_buffer>("data");
-
     Message result(this);
     is_locked_ = true;
 
-    if (input.first) {
-        result.type = shm_block_->message_type;
-        result.data = input.first->c_str();
-        result.length = input.first->size();
+    result.type = shm_block_->message_type;
+    if (shm_block_->has_data) {
+        if (shm_block_->data_segment != read_segment_id_) {
+            openDataSegment(shm_block_->data_segment);
+        }
+        // the payload is read in place, it stays valid until the message is released
+        result.data = static_cast<const uint8_t*>(read_segment_->get_address_from_handle(shm_block_->data_handle));
+        result.length = shm_block_->data_length;
     }
 
     return result;
@@ -185,25 +310,52 @@ void SubprocessChannel::write(const Message& message)
 {
     std::unique_lock<std::recursive_mutex> channel_lock(channel_mutex_);
 
-    const impl::ShmAllocator<int> alloc_inst(shm_segment->get_segment_manager());
+    uint8_t* payload = nullptr;
+    if (message.length > 0) {
+        uint8_t* data = const_cast<uint8_t*>(message.data);
+        if (data_segment_->belongs_to_segment(data)) {
+            // written in place
+            payload = data;
+
+        } else {
+            // the reader only follows the current segment, so payloads of a replaced one are moved as well
+            payload = allocatePayload(message.length);
+            std::memcpy(payload, message.data, message.length);
+
+            for (const auto& retired : retired_segments_) {
+                if (retired.second->belongs_to_segment(data)) {
+                    retired.second->deallocate(data);
+                    break;
+                }
+            }
+        }
+    }
 
     scoped_lock<interprocess_mutex> lock(shm_block_->m);
 
-    if (is_shutdown_) {
-        return;
-    }
-
-    while (shm_block_->is_full) {
+    while (shm_block_->is_full && !is_shutdown_) {
         shm_block_->message_read.wait(lock);
+    }
 
-        if (is_shutdown_) {
-            return;
+    if (is_shutdown_) {
+        if (payload) {
+            data_segment_->deallocate(payload);
         }
+        return;
     }
 
     apex_assert_hard(!is_locked_);
 
-    shm_segment->construct<impl::shared_buffer>("data")(message.data, message.length, alloc_inst);
+    if (payload) {
+        shm_block_->data_segment = data_segment_id_;
+        shm_block_->data_handle = data_segment_->get_handle_from_address(payload);
+        shm_block_->data_length = message.length;
+        shm_block_->has_data = true;
+
+    } else {
+        shm_block_->data_length = 0;
+        shm_block_->has_data = false;
+    }
 
     shm_block_->message_type = message.type;
     shm_block_->is_full = true;
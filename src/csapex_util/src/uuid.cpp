@@ -12,9 +12,133 @@
 #include <ostream>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 using namespace csapex;
 
+namespace
+{
+/**
+ * @brief The SymbolTable class maps the names of UUID segments to symbols.
+ *
+ * The names are stored in chunks that are never moved or freed, so resolving a symbol does not need the lock.
+ * Symbols are reference counted by the UUIDs using them, unused symbols are recycled.
+ */
+class SymbolTable
+{
+    static constexpr std::size_t CHUNK_BITS = 10;
+    static constexpr std::size_t CHUNK_SIZE = 1 << CHUNK_BITS;
+    static constexpr std::size_t MAX_CHUNKS = 1 << 12;
+
+    struct Entry
+    {
+        std::string name;
+        std::atomic<uint32_t> references;
+    };
+
+public:
+    static SymbolTable& instance()
+    {
+        // never destroyed, static UUIDs may still be used during static destruction
+        static SymbolTable* table = new SymbolTable;
+        return *table;
+    }
+
+    SymbolTable() : size_(0)
+    {
+        for (std::atomic<Entry*>& chunk : chunks_) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /// the returned symbol is already referenced once
+    uint32_t intern(const std::string& name)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto pos = symbols_.find(name);
+        if (pos != symbols_.end()) {
+            retain(pos->second);
+            return pos->second;
+        }
+
+        uint32_t symbol;
+        if (!free_.empty()) {
+            symbol = free_.back();
+            free_.pop_back();
+
+        } else {
+            symbol = size_++;
+            std::size_t chunk = symbol >> CHUNK_BITS;
+            if ((symbol & (CHUNK_SIZE - 1)) == 0) {
+                apex_assert_hard(chunk < MAX_CHUNKS);
+                chunks_[chunk].store(new Entry[CHUNK_SIZE](), std::memory_order_release);
+            }
+        }
+
+        Entry& e = entry(symbol);
+        e.name = name;
+        e.references.store(1, std::memory_order_relaxed);
+        symbols_.emplace(name, symbol);
+        return symbol;
+    }
+
+    void retain(uint32_t symbol)
+    {
+        entry(symbol).references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release(uint32_t symbol)
+    {
+        Entry& e = entry(symbol);
+        if (e.references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        // the name might have been interned again, or another release has already recycled the symbol
+        if (e.references.load(std::memory_order_relaxed) != 0) {
+            return;
+        }
+        auto pos = symbols_.find(e.name);
+        if (pos == symbols_.end() || pos->second != symbol) {
+            return;
+        }
+        symbols_.erase(pos);
+        std::string().swap(e.name);
+        free_.push_back(symbol);
+    }
+
+    const std::string& getName(uint32_t symbol) const
+    {
+        return entry(symbol).name;
+    }
+
+    std::size_t count() const
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return symbols_.size();
+    }
+
+private:
+    Entry& entry(uint32_t symbol) const
+    {
+        Entry* chunk = chunks_[symbol >> CHUNK_BITS].load(std::memory_order_acquire);
+        apex_assert_hard(chunk);
+        return chunk[symbol & (CHUNK_SIZE - 1)];
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, uint32_t> symbols_;
+    std::vector<uint32_t> free_;
+    uint32_t size_;
+
+    std::atomic<Entry*> chunks_[MAX_CHUNKS];
+};
+}  // namespace
+
 const std::string UUID::namespace_separator = ":|:";
 UUID UUID::NONE;
 AUUID AUUID::NONE;
@@ -24,6 +148,37 @@ std::size_t UUID::Hasher::operator()(const UUID& k) const
     return k.hash();
 }
 
+UUID::Symbol UUID::intern(const std::string& name)
+{
+    return SymbolTable::instance().intern(name);
+}
+
+void UUID::retain(const std::vector<Symbol>& symbols)
+{
+    SymbolTable& table = SymbolTable::instance();
+    for (Symbol symbol : symbols) {
+        table.retain(symbol);
+    }
+}
+
+void UUID::release(const std::vector<Symbol>& symbols)
+{
+    SymbolTable& table = SymbolTable::instance();
+    for (Symbol symbol : symbols) {
+        table.release(symbol);
+    }
+}
+
+const std::string& UUID::getSymbolName(Symbol symbol)
+{
+    return SymbolTable::instance().getName(symbol);
+}
+
+std::size_t UUID::countSymbols()
+{
+    return SymbolTable::instance().count();
+}
+
 bool UUID::empty() const
 {
     return representation_.empty();
@@ -39,13 +194,13 @@ bool UUID::global() const
         return false;
     }
 
-    return representation_.back().at(0) == ':';
+    return getSymbolName(representation_.back()).at(0) == ':';
 }
 
 std::string UUID::globalName() const
 {
     apex_assert_hard(global());
-    return representation_.back().substr(1);
+    return getSymbolName(representation_.back()).substr(1);
 }
 
 std::string UUID::stripNamespace(const std::string& name)
@@ -60,26 +215,44 @@ UUID::UUID()
 
 UUID::UUID(const UUID& other) : parent_(other.parent_), representation_(other.representation_)
 {
+    retain(representation_);
+}
+
+UUID::UUID(UUID&& other) noexcept : parent_(std::move(other.parent_)), representation_(std::move(other.representation_))
+{
+    other.representation_.clear();
 }
 
 UUID::~UUID()
 {
+    release(representation_);
 }
 
 UUID& UUID::operator=(const UUID& other)
 {
+    retain(other.representation_);
+    release(representation_);
+
     parent_ = other.parent_;
     representation_ = other.representation_;
     return *this;
 }
 
+UUID& UUID::operator=(UUID&& other) noexcept
+{
+    parent_ = std::move(other.parent_);
+    representation_.swap(other.representation_);
+    return *this;
+}
+
 UUID::UUID(std::weak_ptr<UUIDProvider> parent, const UUID& copy) : UUID(parent, copy.representation_)
 {
 }
 
-UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<std::string>& representation) : parent_(parent), representation_(representation)
+UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::vector<Symbol>& representation) : parent_(parent), representation_(representation)
 {
-    apex_assert_hard(representation_.empty() || representation_.back() != "~");
+    retain(representation_);
+    apex_assert_hard(representation_.empty() || getSymbolName(representation_.back()) != "~");
 }
 
 UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation) : parent_(parent)
@@ -115,7 +288,7 @@ UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation
         std::string sub_id = representation.substr(begin, end - begin);
 
         if (sub_id != "~") {
-            representation_.push_back(sub_id);
+            representation_.push_back(intern(sub_id));
         }
         end = pos;
 
@@ -123,7 +296,7 @@ UUID::UUID(std::weak_ptr<UUIDProvider> parent, const std::string& representation
             return;
         }
     }
-    apex_assert_hard(representation_.empty() || representation_.back() != "~");
+    apex_assert_hard(representation_.empty() || getSymbolName(representation_.back()) != "~");
 }
 
 void UUID::free()
@@ -135,7 +308,15 @@ void UUID::free()
 
 bool UUID::operator<(const UUID& other) const
 {
-    return representation_ < other.representation_;
+    // ordered by the names, so that sorted containers do not depend on the interning order
+    auto ita = representation_.begin();
+    auto itb = other.representation_.begin();
+    for (; ita != representation_.end() && itb != other.representation_.end(); ++ita, ++itb) {
+        if (*ita != *itb) {
+            return getSymbolName(*ita) < getSymbolName(*itb);
+        }
+    }
+    return ita == representation_.end() && itb != other.representation_.end();
 }
 
 std::string UUID::getFullName() const
@@ -144,28 +325,23 @@ std::string UUID::getFullName() const
         return "~";
     }
 
-    std::stringstream ss;
     auto it = representation_.rbegin();
-    ss << *it;
+    std::string name = getSymbolName(*it);
     for (++it; it != representation_.rend(); ++it) {
-        ss << namespace_separator;
-        ss << *it;
+        name += namespace_separator;
+        name += getSymbolName(*it);
     }
-    return ss.str();
+    return name;
 }
 
 std::size_t UUID::hash() const
 {
-    if (empty()) {
-        return 0;
-    } else {
-        return boost::hash<std::string>()(representation_.front());
-    }
+    return boost::hash_range(representation_.begin(), representation_.end());
 }
 
 std::string UUID::getShortName() const
 {
-    return stripNamespace(representation_.front());
+    return stripNamespace(getSymbolName(representation_.front()));
 }
 
 bool UUID::composite() const
@@ -175,8 +351,8 @@ bool UUID::composite() const
 
 bool UUID::contains(const std::string& sub) const
 {
-    for (const std::string& s : representation_) {
-        if (s == sub) {
+    for (Symbol symbol : representation_) {
+        if (getSymbolName(symbol) == sub) {
             return true;
         }
     }
@@ -186,11 +362,23 @@ bool UUID::contains(const std::string& sub) const
 UUID UUID::parentUUID() const
 {
     UUID parent = *this;
+    parent.removeId();
+
+    return parent;
+}
+
+void UUID::removeId()
+{
     if (!representation_.empty()) {
-        parent.representation_.erase(parent.representation_.begin());
+        SymbolTable::instance().release(representation_.front());
+        representation_.erase(representation_.begin());
     }
+}
 
-    return parent;
+void UUID::appendParent(const UUID& parent)
+{
+    retain(parent.representation_);
+    representation_.insert(representation_.end(), parent.representation_.begin(), parent.representation_.end());
 }
 
 UUID UUID::nestedUUID() const
@@ -200,9 +388,9 @@ UUID UUID::nestedUUID() const
 UUID UUID::rootUUID() const
 {
     if (auto parent = parent_.lock()) {
-        return UUID(parent, representation_.back());
+        return UUID(parent, std::vector<Symbol>(1, representation_.back()));
     } else {
-        return UUID(std::weak_ptr<UUIDProvider>(), representation_.back());
+        return UUID(std::weak_ptr<UUIDProvider>(), std::vector<Symbol>(1, representation_.back()));
     }
 }
 
@@ -211,11 +399,11 @@ UUID UUID::reshape(std::size_t _depth) const
     if (_depth > depth()) {
         throw std::invalid_argument("cannot reshape UUID to a larger size");
     }
-    return UUID(parent_, std::vector<std::string>(representation_.begin(), representation_.begin() + static_cast<long>(_depth)));
+    return UUID(parent_, std::vector<Symbol>(representation_.begin(), representation_.begin() + static_cast<long>(_depth)));
 }
 UUID UUID::reshapeSoft(std::size_t max_depth) const
 {
-    return UUID(parent_, std::vector<std::string>(representation_.begin(), representation_.begin() + static_cast<long>(std::min(depth(), max_depth))));
+    return UUID(parent_, std::vector<Symbol>(representation_.begin(), representation_.begin() + static_cast<long>(std::min(depth(), max_depth))));
 }
 
 UUID UUID::makeRelativeTo(const UUID& prefix) const
@@ -227,7 +415,7 @@ UUID UUID::makeRelativeTo(const UUID& prefix) const
         ++this_it;
     }
 
-    auto reversed = std::vector<std::string>(this_it, representation_.rend());
+    auto reversed = std::vector<Symbol>(this_it, representation_.rend());
     std::reverse(reversed.begin(), reversed.end());
     return UUID(parent_, reversed);
 }
@@ -240,13 +428,13 @@ UUID UUID::id() const
 std::string UUID::type() const
 {
     apex_assert_hard(!representation_.empty());
-    std::string t = representation_.front();
+    const std::string& t = getSymbolName(representation_.front());
     return t.substr(0, t.find("_"));
 }
 std::string UUID::name() const
 {
     apex_assert_hard(!representation_.empty());
-    std::string t = representation_.front();
+    const std::string& t = getSymbolName(representation_.front());
     return t.substr(t.find("_") + 1);
 }
 
@@ -255,9 +443,7 @@ AUUID UUID::getAbsoluteUUID() const
     if (auto parent = parent_.lock()) {
         UUID parent_uuid = parent->getAbsoluteUUID();
         UUID uuid = *this;
-        for (const std::string& part : parent_uuid.representation_) {
-            uuid.representation_.push_back(part);
-        }
+        uuid.appendParent(parent_uuid);
         return AUUID(uuid);
     } else {
         return AUUID(*this);
@@ -286,17 +472,7 @@ bool operator==(const UUID& uuid_, const std::string& str)
 }
 bool operator==(const UUID& a, const UUID& b)
 {
-    if (a.representation_.size() != b.representation_.size()) {
-        return false;
-    }
-
-    for (auto ita = a.representation_.begin(), itb = b.representation_.begin(); ita != a.representation_.end(); ++ita, ++itb) {
-        if (*ita != *itb) {
-            return false;
-        }
-    }
-
-    return true;
+    return a.representation_ == b.representation_;
 }
 
 bool operator!=(const UUID& a, const UUID& b)
@@ -332,9 +508,7 @@ std::size_t AUUID::Hasher::operator()(const AUUID& k) const
 AUUID AUUID::parentAUUID() const
 {
     AUUID parent = *this;
-    if (!representation_.empty()) {
-        parent.representation_.erase(parent.representation_.begin());
-    }
+    parent.removeId();
 
     return parent;
 }
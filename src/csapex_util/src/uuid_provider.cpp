@@ -39,12 +39,11 @@ UUID UUIDProvider::makeUUID(const std::string& name)
     std::unique_lock<std::recursive_mutex> lock(hash_mutex_);
 
     // ensure uniqueness
-    std::string rep = name;
-    if (hash_.find(rep) != hash_.end()) {
+    UUID r(shared_from_this(), name);
+    if (hash_.find(r) != hash_.end()) {
         throw std::runtime_error("the UUID " + name + " is already taken");
     }
 
-    UUID r(shared_from_this(), rep);
     registerUUID(r);
     return r;
 }
@@ -53,12 +52,12 @@ void UUIDProvider::registerUUID(const UUID& id)
 {
     std::unique_lock<std::recursive_mutex> lock(hash_mutex_);
     apex_assert_hard(!id.representation_.empty());
-    hash_[id.getFullName()]++;
+    hash_[id]++;
 }
 
 bool UUIDProvider::exists(const UUID& uuid)
 {
-    return hash_.find(uuid.getFullName()) != hash_.end();
+    return hash_.find(uuid) != hash_.end();
 }
 
 UUID UUIDProvider::generateUUID(const std::string& prefix)
@@ -80,9 +79,7 @@ UUID UUIDProvider::generateUUID(const std::string& prefix)
 UUID UUIDProvider::makeDerivedUUID(const UUID& parent, const UUID& child)
 {
     UUID result = child;
-    for (const std::string& level : parent.representation_) {
-        result.representation_.push_back(level);
-    }
+    result.appendParent(parent);
     registerUUID(result);
     return result;
 }
@@ -90,9 +87,7 @@ UUID UUIDProvider::makeDerivedUUID(const UUID& parent, const UUID& child)
 UUID UUIDProvider::makeDerivedUUID_forced(const UUID& parent, const UUID& child)
 {
     UUID result = child;
-    for (const std::string& level : parent.representation_) {
-        result.representation_.push_back(level);
-    }
+    result.appendParent(parent);
     return result;
 }
 
@@ -127,7 +122,7 @@ void UUIDProvider::free(const UUID& uuid)
     std::unique_lock<std::recursive_mutex> lock(hash_mutex_);
 
     apex_assert_hard(!uuid.representation_.empty());
-    std::map<std::string, int>::iterator it = hash_.find(uuid.getFullName());
+    auto it = hash_.find(uuid);
     if (it != hash_.end()) {
         hash_.erase(it);
     }
@@ -4,6 +4,8 @@
 #include <csapex/utility/delegate_bind.h>
 #include <boost/signals2.hpp>
 #include <type_traits>
+#include <chrono>
+#include <iostream>
 
 namespace csapex
 {
@@ -702,4 +704,61 @@ TEST_F(SlimSignalsTest, ScopedConnectionDeletedAfterSignals)
     }
 }
 
+TEST_F(SlimSignalsTest, ModificationsDuringEmissionApplyToTheNextEmission)
+{
+    slim_signal::Signal<void(int)> sig;
+
+    int late_calls = 0;
+    bool late_connected = false;
+    int calls = 0;
+    sig.connect([&](int) {
+        ++calls;
+        if (!late_connected) {
+            late_connected = true;
+            sig.connect([&](int) { ++late_calls; });
+        }
+    });
+
+    sig(0);
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(0, late_calls);
+
+    sig(1);
+    EXPECT_EQ(2, calls);
+    EXPECT_EQ(1, late_calls);
+
+    slim_signal::Connection self;
+    self = sig.connect([&](int) { self.disconnect(); });
+    EXPECT_EQ(3, sig.countAllConnections());
+
+    sig(2);
+    EXPECT_EQ(2, sig.countAllConnections());
+    EXPECT_EQ(3, calls);
+}
+
+TEST_F(SlimSignalsTest, EmissionBenchmark)
+{
+    const int emissions = 1000000;
+
+    for (int slots : { 0, 1, 8 }) {
+        slim_signal::Signal<void(int)> sig;
+        std::vector<slim_signal::ScopedConnection> connections;
+        connections.reserve(slots);
+        long sum = 0;
+        for (int i = 0; i < slots; ++i) {
+            connections.emplace_back(sig.connect([&sum](int value) { sum += value; }));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < emissions; ++i) {
+            sig(1);
+        }
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        EXPECT_EQ(long(slots) * emissions, sum);
+
+        std::cout << "[ BENCHMARK ] " << emissions << " emissions to " << slots << " slots: " << duration.count() / 1000000 << "ms (" << duration.count() / double(emissions) << "ns per emission)"
+                  << std::endl;
+    }
+}
+
 }  // namespace csapex
@@ -2,6 +2,9 @@
 
 #include <csapex/utility/uuid_provider.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace csapex;
 
 class UUIDTest : public ::testing::Test
@@ -247,6 +250,85 @@ TEST_F(UUIDTest, UUIDsCanBeReshaped)
     ASSERT_THROW(baz.reshape(1000), std::invalid_argument);
 }
 
+TEST_F(UUIDTest, InternedUUIDsKeepTheirNames)
+{
+    UUID a = UUIDProvider::makeUUID_without_parent("graph_0:|:node_1:|:in_2");
+    UUID b = UUIDProvider::makeUUID_without_parent("graph_0:|:node_1:|:in_2");
+    UUID c = UUIDProvider::makeUUID_without_parent("graph_0:|:node_1:|:in_3");
+
+    ASSERT_EQ("graph_0:|:node_1:|:in_2", a.getFullName());
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(UUID::Hasher()(a), UUID::Hasher()(b));
+
+    ASSERT_TRUE(a.contains("node_1"));
+    ASSERT_FALSE(a.contains("node_never_interned"));
+
+    ASSERT_EQ("in", a.type());
+    ASSERT_EQ("2", a.name());
+    ASSERT_EQ("graph_0:|:node_1", a.parentUUID().getFullName());
+    ASSERT_EQ("graph_0", a.rootUUID().getFullName());
+}
+
+TEST_F(UUIDTest, UUIDsAreOrderedByName)
+{
+    // interned in reverse order, the ordering must still follow the names
+    UUID z = UUIDProvider::makeUUID_without_parent("order_z");
+    UUID a = UUIDProvider::makeUUID_without_parent("order_a");
+
+    ASSERT_TRUE(a < z);
+    ASSERT_FALSE(z < a);
+    ASSERT_FALSE(a < a);
+}
+
+TEST_F(UUIDTest, SymbolsAreFreedWithTheirLastUUID)
+{
+    std::size_t before = UUID::countSymbols();
+    {
+        UUID a = UUIDProvider::makeUUID_without_parent("freed_graph:|:freed_node");
+        ASSERT_EQ(before + 2, UUID::countSymbols());
+
+        UUID copy = a;
+        UUID parent = a.parentUUID();
+        UUID same = UUIDProvider::makeUUID_without_parent("freed_graph:|:freed_node");
+        ASSERT_EQ(before + 2, UUID::countSymbols());
+
+        a = UUID();
+        copy = same;
+        ASSERT_EQ("freed_graph", parent.getFullName());
+        ASSERT_EQ(before + 2, UUID::countSymbols());
+    }
+    ASSERT_EQ(before, UUID::countSymbols());
+    ASSERT_FALSE(UUIDProvider::makeUUID_without_parent("other").contains("freed_node"));
+}
+
+TEST_F(UUIDTest, SymbolsCanBeUsedConcurrently)
+{
+    std::size_t before = UUID::countSymbols();
+
+    std::vector<std::thread> threads;
+    std::atomic<int> errors(0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&errors, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                // the shared name is interned and freed by all threads at the same time
+                std::string name = "shared:|:own_" + std::to_string(t) + "_" + std::to_string(i % 10);
+                UUID uuid = UUIDProvider::makeUUID_without_parent(name);
+                UUID copy = uuid;
+                if (copy.getFullName() != name || uuid.parentUUID().getFullName() != "shared") {
+                    ++errors;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(0, errors);
+    ASSERT_EQ(before, UUID::countSymbols());
+}
+
 // test reshaping thoroughly
 // refactor other methods to use reshape
 // implement reshape more efficiently